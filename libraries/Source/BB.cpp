@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <fstream>
@@ -25,17 +26,22 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
-#include "TinyMove.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
@@ -0,0 +1,33 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_BCH
+#define Included_BCH
+
+#if (IsDevHost)
+
+// Bench class
+//
+// The BCH class runs a fixed benchmark: a built-in set of positions from all game phases
+// is searched to a fixed depth (or movepath enumerated to a fixed depth) with no opening
+// book and no time limit.  Every position starts from a fresh search state, so the node
+// total is a signature of the search and evaluation; it does not depend on the machine
+// or on the number of worker threads.  The frequency measures the machine.
+
+class BCH
+{
+  public:
+    void RunBench(const bool perft, const plyType limitply, const ui threadcount);
+
+    static ui GetPositionCount(void);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "ML.h"
+#include "Hash.h"
+#include "TBV.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "Pos.h"
+#include "BPL.h"
+#include "WPL.h"
+
+// Binary position file signature; the packed position records follow
+
+#define bplsigLen 8
+
+static const char bplsig[bplsigLen + 1] = "MyopicP1";
+
+// Loaded file data
+
+struct BPLData
+{
+  std::string text;          // Text file contents with each line end replaced by a NUL
+  std::vector<PPos> pposvec; // Packed positions
+  std::vector<ui32> restvec; // Text offset of the rest of each record (text files only)
+  ui32 badcount;             // Records rejected
+  ui threadcount;            // Parsing threads used
+  bool binary;               // Binary file flag
+};
+
+// Text parse work shared by the workers: the records located by line
+
+typedef struct
+{
+  const char *textptr;
+  const std::vector<ui32> *linevecptr;
+  std::vector<PPos> *pposvecptr;
+  std::vector<ui32> *restvecptr;
+  std::vector<ui8> *validvecptr;
+} BPLWork;
+
+// Text parse worker: each pool thread has its own position for the attack checks
+
+class BPLWorker
+{
+  public:
+    BPLWorker(const BPLWork& value): work(value) {posptr = new Pos;}
+    ~BPLWorker(void) {delete posptr;}
+
+    void Run(const ui32 index);
+
+  private:
+    const BPLWork& work;
+    Pos *posptr;
+};
+
+void BPLWorker::Run(const ui32 index)
+{
+  // Parse and validate one record; the position load does the attack checks
+
+  const char *lineptr = work.textptr + (*work.linevecptr)[index];
+  const char *restptr = lineptr;
+  PPos& ppos = (*work.pposvecptr)[index];
+
+  (*work.validvecptr)[index] = ppos.LoadFromStr(lineptr, &restptr) && posptr->LoadPosFromPPos(ppos);
+  (*work.restvecptr)[index] = (ui32) (restptr - work.textptr);
+}
+
+static bool IsPlausible(const PPos& ppos)
+{
+  // Check that a binary record can be used without harm: men, color, and squares in range
+
+  bool valid = IsColorNotNil(ppos.GetGood()) && (ppos.GetGood() < colorRLen);
+
+  for (sqrType sqr = 0; valid && (sqr < sqrLen); sqr++)
+    if (ppos.GetMan(sqr) > manVacant) valid = false;
+  if (valid && (ppos.GetEpsq() >= (sqrType) sqrLen)) valid = false;
+  return valid;
+}
+
+BPL::BPL(void)
+{
+  dataptr = new BPLData;
+  dataptr->badcount = 0; dataptr->threadcount = 0; dataptr->binary = false;
+}
+
+BPL::~BPL(void) {delete dataptr;}
+
+bool BPL::LoadFile(const char *fn)
+{
+  // Load a text or binary position file; return false only if the file can't be read
+
+  bool okay = true;
+  std::ifstream ifs(fn, std::ios::binary);
+  std::string& text = dataptr->text;
+
+  dataptr->pposvec.clear(); dataptr->restvec.clear();
+  dataptr->badcount = 0; dataptr->threadcount = 1;
+
+  // Read the entire file
+
+  if (ifs.fail()) {std::cerr << "Can't open position input file\n"; okay = false;}
+  else
+  {
+    ifs.seekg(0, std::ios::end);
+    text.resize((size_t) ifs.tellg());
+    ifs.seekg(0, std::ios::beg);
+    if (!text.empty()) ifs.read(&text[0], text.size());
+    if (ifs.fail()) {std::cerr << "Can't read position input file\n"; okay = false;};
+  };
+
+  // A binary file: copy the records, dropping any that are unusable
+
+  dataptr->binary =
+    okay && (text.size() >= bplsigLen) && (memcmp(text.data(), bplsig, bplsigLen) == 0);
+  if (okay && dataptr->binary)
+  {
+    const ui32 count = (ui32) ((text.size() - bplsigLen) / pposLen);
+    PPos ppos;
+
+    dataptr->pposvec.reserve(count);
+    for (ui32 index = 0; index < count; index++)
+    {
+      memcpy(&ppos, text.data() + bplsigLen + (index * pposLen), pposLen);
+      if (IsPlausible(ppos)) dataptr->pposvec.push_back(ppos); else dataptr->badcount++;
+    };
+    text.clear();
+  };
+
+  // A text file: locate the lines, then parse them using the worker pool
+
+  if (okay && !dataptr->binary)
+  {
+    std::vector<ui32> linevec;
+    std::vector<PPos> pposvec;
+    std::vector<ui32> restvec;
+    std::vector<ui8> validvec;
+    ui32 linestart = 0;
+
+    for (ui32 index = 0; index < text.size(); index++)
+    {
+      if ((text[index] == '\n') || (text[index] == '\r'))
+      {
+        text[index] = '\0';
+        if (index > linestart) linevec.push_back(linestart);
+        linestart = index + 1;
+      };
+    };
+    if (text.size() > linestart) linevec.push_back(linestart);
+
+    const ui32 linecount = (ui32) linevec.size();
+    BPLWork work;
+
+    work.textptr = text.c_str(); work.linevecptr = &linevec;
+    work.pposvecptr = &pposvec; work.restvecptr = &restvec; work.validvecptr = &validvec;
+    pposvec.resize(linecount); restvec.resize(linecount); validvec.resize(linecount);
+    dataptr->threadcount = WPL::RunPool<BPLWorker>(linecount, 0, work);
+
+    // Keep the valid records in their original order
+
+    dataptr->pposvec.reserve(linecount); dataptr->restvec.reserve(linecount);
+    for (ui32 index = 0; index < linecount; index++)
+    {
+      if (!validvec[index]) dataptr->badcount++;
+      else
+      {
+        dataptr->pposvec.push_back(pposvec[index]); dataptr->restvec.push_back(restvec[index]);
+      };
+    };
+  };
+
+  return okay;
+}
+
+bool BPL::SaveFile(const char *fn, const bool binary) const
+{
+  // Save the records as a binary file or as a text file (FEN plus any rest of each record)
+
+  bool okay = true;
+  std::ofstream ofs(fn, std::ios::binary);
+
+  if (ofs.fail()) {std::cerr << "Can't open position output file\n"; okay = false;}
+  else
+  {
+    if (binary)
+    {
+      ofs.write(bplsig, bplsigLen);
+      if (!dataptr->pposvec.empty())
+        ofs.write((const char *) &dataptr->pposvec[0], dataptr->pposvec.size() * pposLen);
+    }
+    else
+    {
+      char fen[fenLen + 1];
+
+      for (ui32 index = 0; index < GetCount(); index++)
+      {
+        const char *restptr = FetchRest(index);
+
+        FetchPPos(index).EncodeFEN(fen); ofs << fen;
+        if (*restptr) ofs << ' ' << restptr;
+        ofs << '\n';
+      };
+    };
+    if (ofs.fail()) {std::cerr << "Can't write position output file\n"; okay = false;};
+  };
+  return okay;
+}
+
+bool BPL::ConvertFile(const char *infn, const char *outfn)
+{
+  // Convert a text position file to binary or a binary position file to text
+
+  const msType startmsec = ElapsedMsec();
+  bool okay = LoadFile(infn) && SaveFile(outfn, !IsBinary());
+
+  if (okay)
+  {
+    std::cout << "Position file conversion summary\n";
+    std::cout << "  Input format: " << (IsBinary() ? "binary" : "text") << '\n';
+    std::cout << "  Records used: " << GetCount() << '\n';
+    std::cout << "  Records rejected: " << GetBadCount() << '\n';
+    std::cout << "  Threads: " << dataptr->threadcount << '\n';
+    std::cout << "  Seconds: " << ((ElapsedMsec() - startmsec) / 1000.0) << '\n';
+  };
+  return okay;
+}
+
+bool BPL::IsBinary(void) const {return dataptr->binary;}
+
+ui32 BPL::GetCount(void) const {return (ui32) dataptr->pposvec.size();}
+
+ui32 BPL::GetBadCount(void) const {return dataptr->badcount;}
+
+const PPos& BPL::FetchPPos(const ui32 index) const {return dataptr->pposvec[index];}
+
+const char *BPL::FetchRest(const ui32 index) const
+{
+  return dataptr->binary ? "" : (dataptr->text.c_str() + dataptr->restvec[index]);
+}
+
+#endif
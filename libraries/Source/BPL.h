@@ -0,0 +1,55 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_BPL
+#define Included_BPL
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class PPos;
+
+struct BPLData;
+
+// Bulk position loader class
+//
+// The BPL class loads a whole position file into memory as packed positions for the
+// offline tools.  A text file has one FEN or EPD record per line; any text following the
+// position fields (EPD operations, game results) is kept with each record.  A binary file
+// is a signature followed by packed position records.  Text records are parsed and
+// validated by the worker pool (one thread per processor); invalid records are counted and
+// dropped.
+
+class BPL
+{
+  public:
+    BPL(void);
+    ~BPL(void);
+
+    bool LoadFile(const char *fn);
+    bool SaveFile(const char *fn, const bool binary) const;
+
+    bool ConvertFile(const char *infn, const char *outfn);
+
+    bool IsBinary(void) const;
+
+    ui32 GetCount(void) const;
+    ui32 GetBadCount(void) const;
+
+    const PPos& FetchPPos(const ui32 index) const;
+    const char *FetchRest(const ui32 index) const;
+
+  private:
+    BPLData *dataptr;
+};
+
+#endif
+
+#endif
@@ -46,93 +46,6 @@ void Board::SetInitialArray(void)
   };
 }
 
-sqrType Board::CalcNextSquare(const sqrType frsqr, const dirType dir)
-{
-  // The next square along a direction is calculated (used if look-up table is absent)
-
-  const fileType tofile = MapSqrToFile(frsqr) + filedels[dir];
-  const rankType torank = MapSqrToRank(frsqr) + rankdels[dir];
-  sqrType tosqr;
-
-  // Nybble overflow/underflow detection
-
-  if ((tofile | torank) & 0x88) tosqr = sqrNil; else tosqr = frsqr + sqrdels[dir];
-  return tosqr;
-}
-
-dirType Board::CalcDirection(const sqrType frsqr, const sqrType tosqr)
-{
-  // The direction between two squares is calculated (used if look-up table is absent)
-
-  dirType dir;
-
-  if (frsqr == tosqr) dir = dirNil;
-  else
-  {
-    const si filedelta = CalcFileDelta(frsqr, tosqr);
-    const si rankdelta = CalcRankDelta(frsqr, tosqr);
-
-    // Orthogonals
-
-    if (rankdelta == 0) dir = (filedelta > 0) ? dirE : dirW;
-    else
-    {
-      if (filedelta == 0) dir = (rankdelta > 0) ? dirN : dirS;
-      else
-      {
-        // Diagonals
-
-        if (filedelta == rankdelta) dir = (filedelta > 0) ? dirNE : dirSW;
-        else
-        {
-          if (filedelta == -rankdelta) dir = (filedelta > 0) ? dirSE : dirNW;
-          else
-          {
-            // Crooks (knight directions)
-
-            if (filedelta == 2)
-            {
-              if (rankdelta == 1) dir = dirENE;
-              else
-                dir = (rankdelta == -1) ? dirESE : dirNil;
-            }
-            else
-            {
-              if (filedelta == 1)
-              {
-                if (rankdelta == 2) dir = dirNNE;
-                else
-                  dir = (rankdelta == -2) ? dirSSE : dirNil;
-              }
-              else
-              {
-                if (filedelta == -1)
-                {
-                  if (rankdelta == 2) dir = dirNNW;
-                  else
-                    dir = (rankdelta == -2) ? dirSSW : dirNil;
-                }
-                else
-                {
-                  if (filedelta == -2)
-                  {
-                    if (rankdelta == 1) dir = dirWNW;
-                    else
-                      dir = (rankdelta == -1) ? dirWSW : dirNil;
-                  }
-                  else
-                    dir = dirNil;
-                };
-              };
-            };
-          };
-        };
-      };
-    };
-  };
-  return dir;
-}
-
 bool Board::CalcAdjacent(sqrType frsqr, sqrType tosqr)
 {
   // The adjacency between two squares is calculated (used if look-up table is absent)
@@ -142,52 +55,6 @@ bool Board::CalcAdjacent(sqrType frsqr, sqrType tosqr)
     (frsqr != tosqr);
 }
 
-ddbType Board::CalcDDB(sqrType frsqr, sqrType tosqr)
-{
-  // The DD byte for two squares is calculated (used if look-up table is absent)
-
-  ddbType ddb = 0;
-  const dirType dir = CalcDirection(frsqr, tosqr);
-
-  if (IsDirNotNil(dir))
-  {
-    ddb |= dir;
-    if (IsDirCrook(dir)) ddb |= BX(6);
-    else
-    {
-      if (IsDirOrtho(dir)) ddb |= BX(4); else ddb |= BX(5);
-      if (CalcAdjacent(frsqr, tosqr)) ddb |= BX(7);
-    };
-  };
-  return ddb;
-}
-
-ui Board::CalcMinFRSeparation(const sqrType frsqr, const sqrType tosqr)
-{
-  // The min F/R sep between two squares is calculated (used if look-up table is absent)
-
-  const ui absfiledelta = CalcAbsFileDelta(frsqr, tosqr);
-  const ui absrankdelta = CalcAbsRankDelta(frsqr, tosqr);
-
-  return (absfiledelta < absrankdelta) ? absfiledelta : absrankdelta;
-}
-
-ui Board::CalcSumFRSeparation(const sqrType frsqr, const sqrType tosqr)
-{
-  // The sum f/R sep between two squares is calculated (used if look-up table is absent)
-
-  return CalcAbsFileDelta(frsqr, tosqr) + CalcAbsRankDelta(frsqr, tosqr);
-}
-
-sdbType Board::CalcSDB(const sqrType frsqr, const sqrType tosqr)
-{
-  // The SD byte for two squares is calculated (used if look-up table is absent)
-
-  return
-    (sdbType)
-      ((CalcSumFRSeparation(frsqr, tosqr) << 4) | CalcMinFRSeparation(frsqr, tosqr));
-}
-
 sqrType Board::LocateKing(const colorType color) const
 {
   // Find the square of the king for the given color
@@ -462,8 +329,6 @@ bool Board::IsValidDistribution(void) const
 {
   // Test for neither too few nor too many men of the various piece kinds
 
-  bool valid = true;
-  colorType color;
   ui mancount[manRLen];
 
   // Initialize the accumulator vector
@@ -475,6 +340,15 @@ bool Board::IsValidDistribution(void) const
 
     if (IsManNotVacant(man)) mancount[man]++;
   };
+  return IsValidManCounts(mancount);
+}
+
+bool Board::IsValidManCounts(const ui mancount[manRLen])
+{
+  // Test a man count vector for neither too few nor too many men of the various piece kinds
+
+  bool valid = true;
+  colorType color;
 
   // Loop through the colors
 
@@ -659,6 +533,7 @@ void Board::PrintGraphic(const bool normal) const
   PrintNL();
 }
 
+#if (IsTarget)
 // Map man/sweep to attack ability
 
 const ui8 Board::mansweepflag[mansweepflagLen] PROGMEM =
@@ -1347,3 +1222,5 @@ const sdbType Board::sqrsqrtosdb[sqrsqrLen] PROGMEM =
   0xa3, 0x93, 0x83, 0x73, 0x63, 0x52, 0x41, 0x30, 0x92, 0x82, 0x72, 0x62, 0x52, 0x42, 0x31, 0x20,
   0x81, 0x71, 0x61, 0x51, 0x41, 0x31, 0x21, 0x10, 0x70, 0x60, 0x50, 0x40, 0x30, 0x20, 0x10, 0x00
 };
+
+#endif
@@ -14,6 +14,252 @@
 
 #define mansweepflagLen (manRLen * dirSLen)
 
+#if (IsDevHost)
+
+// Board geometry tables class (host only)
+//
+// On the host, the BGT class holds all of the board geometry tables.  Its single instance
+// is filled in by the constexpr constructor at compile time, so the tables are correct by
+// construction and cost nothing at startup; the target keeps hand-typed flash tables.  The
+// between-square and line bit masks (one bit per square) are host only additions that the
+// byte sized tables can't express.
+
+class BGT
+{
+  public:
+    constexpr BGT(void):
+      mansweepflag(), centertropismdistance(), pawnattackcount(), knightattackcount(),
+      kingattackcount(), sqrdirtosqr(), sqrsqrtoddb(), sqrsqrtosdb(), kingrunsqr(),
+      knightrunsqr(), betweenmask(), linemask(), raymask(), knightmask(), kingmask(),
+      pawnattackmask()
+    {
+      // Man/sweep attack ability
+
+      for (ui man = 0; man < manRLen; man++)
+      {
+        const ui piece = man % pieceRLen;
+
+        for (ui dir = 0; dir < dirSLen; dir++)
+        {
+          const bool isortho = dir <= (ui) dirS;
+
+          mansweepflag[(man << 3) + dir] =
+            (piece == pieceQueen) ||
+            ((piece == pieceRook) && isortho) || ((piece == pieceBishop) && !isortho);
+        };
+      };
+
+      // Single square properties, next squares, and king/knight runs
+
+      for (ui sqr = 0; sqr < sqrLen; sqr++)
+      {
+        const ui file = sqr & 0x07, rank = sqr >> 3;
+        ui kingcount = 0, knightcount = 0;
+
+        centertropismdistance[sqr] = CalcCenterTropismDistance(file, rank);
+        pawnattackcount[sqr] =
+          ((rank == rank1) || (rank == rank8)) ? 0 : ((file > fileA) + (file < fileH));
+        for (ui dir = 0; dir < dirLen; dir++)
+        {
+          const sqrType tosqr = CalcNextSquare(sqr, dir);
+
+          sqrdirtosqr[(sqr << 4) + dir] = tosqr;
+          if (tosqr != sqrNil)
+          {
+            const ui64 tobit = ((ui64) 1) << tosqr;
+
+            if (dir < dirSLen)
+            {
+              kingrunsqr[(sqr * kingspanLen) + kingcount++] = tosqr; kingmask[sqr] |= tobit;
+              if ((dir == (ui) dirNE) || (dir == (ui) dirNW))
+                pawnattackmask[(colorWhite * sqrLen) + sqr] |= tobit;
+              if ((dir == (ui) dirSW) || (dir == (ui) dirSE))
+                pawnattackmask[(colorBlack * sqrLen) + sqr] |= tobit;
+            }
+            else
+            {
+              knightrunsqr[(sqr * knightspanLen) + knightcount++] = tosqr;
+              knightmask[sqr] |= tobit;
+            };
+          };
+        };
+
+        // Full rays for each sweep direction
+
+        for (ui dir = 0; dir < dirSLen; dir++)
+        {
+          si tosqr = CalcNextSquare(sqr, dir);
+
+          while (tosqr != sqrNil)
+          {
+            raymask[(sqr << 3) + dir] |= ((ui64) 1) << tosqr; tosqr = CalcNextSquare(tosqr, dir);
+          };
+        };
+        kingattackcount[sqr] = kingcount; knightattackcount[sqr] = knightcount;
+        while (kingcount < kingspanLen) kingrunsqr[(sqr * kingspanLen) + kingcount++] = sqrNil;
+        while (knightcount < knightspanLen)
+          knightrunsqr[(sqr * knightspanLen) + knightcount++] = sqrNil;
+      };
+
+      // Square pair properties
+
+      for (ui frsqr = 0; frsqr < sqrLen; frsqr++)
+        for (ui tosqr = 0; tosqr < sqrLen; tosqr++)
+        {
+          const ui index = (frsqr << 6) + tosqr;
+          const si dir = CalcDirection(frsqr, tosqr);
+
+          sqrsqrtoddb[index] = CalcDDB(frsqr, tosqr, dir);
+          sqrsqrtosdb[index] = CalcSDB(frsqr, tosqr);
+          if ((dir >= dirE) && (dir <= dirSE))
+          {
+            const si backdir = dir ^ 0x02; // The opposite sweep direction
+            si sqr = CalcNextSquare(frsqr, dir);
+
+            while (sqr != (si) tosqr)
+            {
+              betweenmask[index] |= ((ui64) 1) << sqr; sqr = CalcNextSquare(sqr, dir);
+            };
+            for (sqr = frsqr; sqr != sqrNil; sqr = CalcNextSquare(sqr, dir))
+              linemask[index] |= ((ui64) 1) << sqr;
+            for (sqr = frsqr; sqr != sqrNil; sqr = CalcNextSquare(sqr, backdir))
+              linemask[index] |= ((ui64) 1) << sqr;
+          };
+        };
+    }
+
+    ui8 mansweepflag[mansweepflagLen];    // Man/sweep to attack ability
+    ui8 centertropismdistance[sqrLen];    // Center tropism distance
+    ui8 pawnattackcount[sqrLen];          // Count of pawn attacks from a square
+    ui8 knightattackcount[sqrLen];        // Count of knight attacks from a square
+    ui8 kingattackcount[sqrLen];          // Count of king attacks from a square
+    sqrType sqrdirtosqr[sqrdirLen];       // Initial square and direction to next square
+    ddbType sqrsqrtoddb[sqrsqrLen];       // Square pair to direction descriptor byte
+    sdbType sqrsqrtosdb[sqrsqrLen];       // Square pair to separation descriptor byte
+    sqrType kingrunsqr[kingrunLen];       // King run squares indexed by initial square
+    sqrType knightrunsqr[knightrunLen];   // Knight run squares indexed by initial square
+    ui64 betweenmask[sqrsqrLen];          // Squares strictly between a square pair on a line
+    ui64 linemask[sqrsqrLen];             // Squares of the full line through a square pair
+    ui64 raymask[sqrLen * dirSLen];       // Squares along a sweep direction from a square
+    ui64 knightmask[sqrLen];              // Knight attack squares
+    ui64 kingmask[sqrLen];                // King attack squares
+    ui64 pawnattackmask[colorRLen * sqrLen]; // Pawn attack squares by color
+
+  private:
+    static constexpr si FileDelta(const ui dir)
+    {
+      const si delfs[dirLen] =
+      {
+        delfE,   delfN,   delfW,   delfS,   delfNE,  delfNW,  delfSW,  delfSE,
+        delfENE, delfNNE, delfNNW, delfWNW, delfWSW, delfSSW, delfSSE, delfESE
+      };
+
+      return delfs[dir];
+    }
+
+    static constexpr si RankDelta(const ui dir)
+    {
+      const si delrs[dirLen] =
+      {
+        delrE,   delrN,   delrW,   delrS,   delrNE,  delrNW,  delrSW,  delrSE,
+        delrENE, delrNNE, delrNNW, delrWNW, delrWSW, delrSSW, delrSSE, delrESE
+      };
+
+      return delrs[dir];
+    }
+
+    static constexpr sqrType CalcNextSquare(const ui sqr, const ui dir)
+    {
+      const si file = (si) (sqr & 0x07) + FileDelta(dir);
+      const si rank = (si) (sqr >> 3) + RankDelta(dir);
+
+      return
+        ((file < 0) || (file >= fileLen) || (rank < 0) || (rank >= rankLen)) ?
+          sqrNil : (sqrType) ((rank * fileLen) + file);
+    }
+
+    static constexpr si CalcDirection(const ui frsqr, const ui tosqr)
+    {
+      const si filedelta = (si) (tosqr & 0x07) - (si) (frsqr & 0x07);
+      const si rankdelta = (si) (tosqr >> 3) - (si) (frsqr >> 3);
+      si dir = dirNil;
+
+      if (frsqr != tosqr)
+      {
+        if (rankdelta == 0) dir = (filedelta > 0) ? dirE : dirW;
+        else
+        {
+          if (filedelta == 0) dir = (rankdelta > 0) ? dirN : dirS;
+          else
+          {
+            if (filedelta == rankdelta) dir = (filedelta > 0) ? dirNE : dirSW;
+            else
+            {
+              if (filedelta == -rankdelta) dir = (filedelta > 0) ? dirSE : dirNW;
+              else
+              {
+                for (ui crook = dirENE; crook <= (ui) dirESE; crook++)
+                  if ((FileDelta(crook) == filedelta) && (RankDelta(crook) == rankdelta))
+                    dir = crook;
+              };
+            };
+          };
+        };
+      };
+      return dir;
+    }
+
+    static constexpr ui CalcAbsDelta(const ui value0, const ui value1)
+    {
+      return (value0 > value1) ? (value0 - value1) : (value1 - value0);
+    }
+
+    static constexpr ddbType CalcDDB(const ui frsqr, const ui tosqr, const si dir)
+    {
+      ui ddb = 0;
+
+      if (dir != dirNil)
+      {
+        ddb |= dir;
+        if (dir >= dirENE) ddb |= BX(6);
+        else
+        {
+          ddb |= (dir <= dirS) ? BX(4) : BX(5);
+          if ((CalcAbsDelta(frsqr & 0x07, tosqr & 0x07) <= 1) &&
+            (CalcAbsDelta(frsqr >> 3, tosqr >> 3) <= 1))
+            ddb |= BX(7);
+        };
+      };
+      return (ddbType) ddb;
+    }
+
+    static constexpr sdbType CalcSDB(const ui frsqr, const ui tosqr)
+    {
+      const ui absfiledelta = CalcAbsDelta(frsqr & 0x07, tosqr & 0x07);
+      const ui absrankdelta = CalcAbsDelta(frsqr >> 3, tosqr >> 3);
+      const ui minfr = (absfiledelta < absrankdelta) ? absfiledelta : absrankdelta;
+
+      return (sdbType) (((absfiledelta + absrankdelta) << 4) | minfr);
+    }
+
+    static constexpr ui8 CalcCenterTropismDistance(const ui file, const ui rank)
+    {
+      // The rounded distance to the board center scaled so that a corner square is 255;
+      // doubled coordinates keep the arithmetic integral
+
+      const si df = (si) (file * 2) - 7, dr = (si) (rank * 2) - 7;
+      const ui64 target = ((ui64) 255 * 255 * 4) * (ui64) ((df * df) + (dr * dr));
+      ui64 root = 0;
+
+      // Find the least root with (2 * root + 1)^2 * 98 > target (i.e., the rounded root)
+
+      while (((((2 * root) + 1) * ((2 * root) + 1)) * 98) <= target) root++;
+      return (ui8) root;
+    }
+};
+
+#endif
+
 // Forward class declaration(s)
 
 class Hash;
@@ -43,6 +289,26 @@ class Board
     static ui8 FetchCenterTropismDistance(const sqrType frsqr);
     static sqrType FetchNextSquare(const sqrType frsqr, const dirType dir);
 
+#if (IsDevHost)
+    static const sqrType *FetchKingRun(const sqrType frsqr);
+    static const sqrType *FetchKnightRun(const sqrType frsqr);
+
+    static ui64 FetchBetweenMask(const sqrType frsqr, const sqrType tosqr);
+    static ui64 FetchLineMask(const sqrType frsqr, const sqrType tosqr);
+
+    static ui64 FetchKnightMask(const sqrType frsqr) {return bgt.knightmask[frsqr];}
+    static ui64 FetchKingMask(const sqrType frsqr) {return bgt.kingmask[frsqr];}
+
+    static ui64 FetchPawnAttackMask(const colorType color, const sqrType frsqr)
+    {
+      return bgt.pawnattackmask[(color * sqrLen) + frsqr];
+    }
+
+    static ui64 CalcSweepMask(const sqrType frsqr, const dirType dir, const ui64 occupied);
+#endif
+
+    static bool IsValidManCounts(const ui mancount[manRLen]);
+
   protected:
     void Reset(void);
 
@@ -117,25 +383,22 @@ class Board
     static bool IsRimRank(const rankType rank);
     static bool IsRimSqr(const sqrType sqr);
 
-    static sqrType CalcNextSquare(const sqrType frsqr, const dirType dir);
-
-    static dirType CalcDirection(const sqrType frsqr, const sqrType tosqr);
-
     static bool CalcAdjacent(sqrType frsqr, sqrType tosqr);
 
-    static ddbType CalcDDB(sqrType frsqr, sqrType tosqr);
     static ddbType FetchDDB(const sqrType frsqr, const sqrType tosqr);
     static dirType ExtractDirection(const sqrType frsqr, const sqrType tosqr);
 
-    static ui CalcMinFRSeparation(const sqrType frsqr, const sqrType tosqr);
-    static ui CalcSumFRSeparation(const sqrType frsqr, const sqrType tosqr);
-    static sdbType CalcSDB(const sqrType frsqr, const sqrType tosqr);
     static ddbType FetchSDB(const sqrType frsqr, const sqrType tosqr);
 
     static ui MapSdbToMinFR(const sdbType sdb) {return sdb & 0x0f;}
     static ui MapSdbToSumFR(const sdbType sdb) {return (sdb >> 4) & 0x0f;}
 
   private:
+#if (IsDevHost)
+    static constexpr BGT bgt{}; // Generated at compile time
+#endif
+
+#if (IsTarget)
     static const ui8 mansweepflag[mansweepflagLen] PROGMEM;
     static const ui8 centertropismdistance[sqrLen] PROGMEM;
     static const ui8 pawnattackcount[sqrLen] PROGMEM;
@@ -145,6 +408,7 @@ class Board
     static const sqrType sqrdirtosqr[sqrdirLen] PROGMEM;
     static const ddbType sqrsqrtoddb[sqrsqrLen] PROGMEM;
     static const sdbType sqrsqrtosdb[sqrsqrLen] PROGMEM;
+#endif
 
     bool IsValidDistribution(void) const;
     bool IsValidPawnLocation(void) const;
@@ -195,37 +459,79 @@ inline bool Board::IsRimSqr(const sqrType sqr)
 
 inline ui8 Board::FetchManSweepFlag(const manType man, const dirType dir)
 {
+#if (IsDevHost)
+  return bgt.mansweepflag[(man << 3) + dir];
+#endif
+
+#if (IsTarget)
   return ReadFlashUi8(mansweepflag + (man << 3) + dir);
+#endif
 }
 
 inline ui8 Board::FetchCenterTropismDistance(const sqrType frsqr)
 {
+#if (IsDevHost)
+  return bgt.centertropismdistance[frsqr];
+#endif
+
+#if (IsTarget)
   return ReadFlashUi8(centertropismdistance + frsqr);
+#endif
 }
 
 inline ui8 Board::FetchPawnAttackCount(const sqrType frsqr)
 {
+#if (IsDevHost)
+  return bgt.pawnattackcount[frsqr];
+#endif
+
+#if (IsTarget)
   return ReadFlashUi8(pawnattackcount + frsqr);
+#endif
 }
 
 inline ui8 Board::FetchKnightAttackCount(const sqrType frsqr)
 {
+#if (IsDevHost)
+  return bgt.knightattackcount[frsqr];
+#endif
+
+#if (IsTarget)
   return ReadFlashUi8(knightattackcount + frsqr);
+#endif
 }
 
 inline ui8 Board::FetchKingAttackCount(const sqrType frsqr)
 {
+#if (IsDevHost)
+  return bgt.kingattackcount[frsqr];
+#endif
+
+#if (IsTarget)
   return ReadFlashUi8(kingattackcount + frsqr);
+#endif
 }
 
 inline sqrType Board::FetchNextSquare(const sqrType frsqr, const dirType dir)
 {
+#if (IsDevHost)
+  return bgt.sqrdirtosqr[(frsqr << 4) + dir];
+#endif
+
+#if (IsTarget)
   return (sqrType) ReadFlashSi8(sqrdirtosqr + (frsqr << 4) + dir);
+#endif
 }
 
 inline ddbType Board::FetchDDB(const sqrType frsqr, const sqrType tosqr)
 {
+#if (IsDevHost)
+  return bgt.sqrsqrtoddb[(frsqr << 6) + tosqr];
+#endif
+
+#if (IsTarget)
   return (ddbType) ReadFlashUi8(sqrsqrtoddb + (frsqr << 6) + tosqr);
+#endif
 }
 
 inline dirType Board::ExtractDirection(const sqrType frsqr, const sqrType tosqr)
@@ -235,7 +541,54 @@ inline dirType Board::ExtractDirection(const sqrType frsqr, const sqrType tosqr)
 
 inline sdbType Board::FetchSDB(const sqrType frsqr, const sqrType tosqr)
 {
+#if (IsDevHost)
+  return bgt.sqrsqrtosdb[(frsqr << 6) + tosqr];
+#endif
+
+#if (IsTarget)
   return (sdbType) ReadFlashUi8(sqrsqrtosdb + (frsqr << 6) + tosqr);
+#endif
 }
 
+#if (IsDevHost)
+inline const sqrType *Board::FetchKingRun(const sqrType frsqr)
+{
+  return bgt.kingrunsqr + (frsqr * kingspanLen);
+}
+
+inline const sqrType *Board::FetchKnightRun(const sqrType frsqr)
+{
+  return bgt.knightrunsqr + (frsqr * knightspanLen);
+}
+
+inline ui64 Board::FetchBetweenMask(const sqrType frsqr, const sqrType tosqr)
+{
+  return bgt.betweenmask[(frsqr << 6) + tosqr];
+}
+
+inline ui64 Board::FetchLineMask(const sqrType frsqr, const sqrType tosqr)
+{
+  return bgt.linemask[(frsqr << 6) + tosqr];
+}
+
+inline ui64 Board::CalcSweepMask(const sqrType frsqr, const dirType dir, const ui64 occupied)
+{
+  // The squares attacked along a sweep direction; the ray is cut beyond the first blocker,
+  // which is the lowest set bit for the ascending directions and the highest otherwise
+
+  ui64 mask = bgt.raymask[(frsqr << 3) + dir];
+  const ui64 blockers = mask & occupied;
+
+  if (blockers)
+  {
+    const sqrType blocksqr =
+      (dir & 0x02) ?
+        (sqrType) (63 - __builtin_clzll(blockers)) : (sqrType) __builtin_ctzll(blockers);
+
+    mask ^= bgt.raymask[(blocksqr << 3) + dir];
+  };
+  return mask;
+}
+#endif
+
 #endif
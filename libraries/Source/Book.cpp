@@ -26,6 +26,7 @@
 #include "Book.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
 void Book::FetchBookMove(const biType index, BookMove& bookmove)
@@ -161,12 +162,11 @@ bool Book::BookMark(const ML& ml, const FPos& fpos)
         {
           // Skip the move if it has a certain score
 
-          if (ml.FetchMove(moveindex).IsNotCertain())
+          if (ml.IsNotCertain(moveindex))
           {
             // Mark the matching move in the move list and record its popularity
 
-            ml.RefMove(moveindex).SetFlagM(mfmBook);
-            ml.RefMove(moveindex).PutSv(bookmove.GetCodeByte(7));
+            ml.SetFlagM(moveindex, mfmBook); ml.PutSv(moveindex, bookmove.GetCodeByte(7));
           };
         };
 
@@ -189,7 +189,7 @@ ui Book::CalcPopularitySum(const ML& ml)
   ui sum = 0;
 
   for (miType index = 0; index < ml.GetCount(); index++)
-    if (ml.FetchMove(index).IsBook()) sum += ml.FetchMove(index).GetSv();
+    if (ml.IsBook(index)) sum += ml.GetSv(index);
   return sum;
 }
 
@@ -219,9 +219,9 @@ miType Book::PickBookMove(const ML& ml, const FPos& fpos)
 
       while ((moveindex < 0) && (sum <= picksum) && (index < ml.GetCount()))
       {
-        if (ml.FetchMove(index).IsBook())
+        if (ml.IsBook(index))
         {
-          const ui pop = ml.FetchMove(index).GetSv();
+          const ui pop = ml.GetSv(index);
 
           if (pop > 0) {sum += pop; if (sum > picksum) moveindex = index;};
         };
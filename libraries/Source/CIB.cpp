@@ -29,30 +29,45 @@ void CIB::ResetTokens(void)
 
 void CIB::Reset(void) {iseof = false; ResetBuffer(); ResetTokens();}
 
-void CIB::Load(void)
+void CIB::Tokenize(void)
 {
-  // Load the input buffer
+  // Assign token pointers and change intertoken whitespace to ASCII NULs
 
-  if (!iseof)
+  if (iseof) ResetBuffer();
+  else
   {
-    ResetBuffer(); ResetTokens(); ReadLine(cv, cibLen, iseof);
-    if (iseof) ResetBuffer();
-    else
-    {
-      // Assign token pointers and change intertoken whitespace to ASCII NULs
-
-      char *cptr = cv;
+    char *cptr = cv;
 
-      while (*cptr)
+    while (*cptr)
+    {
+      while (IsWS(*cptr)) *cptr++ = '\0';
+      if (*cptr)
       {
-        while (IsWS(*cptr)) *cptr++ = '\0';
-        if (*cptr)
-        {
-          if (tokencount < tokensLen) tokens[tokencount++] = cptr;
-          while (*cptr && !IsWS(*cptr)) cptr++;
-          if (IsWS(*cptr)) *cptr++ = '\0';
-        };
+        if (tokencount < tokensLen) tokens[tokencount++] = cptr;
+        while (*cptr && !IsWS(*cptr)) cptr++;
+        if (IsWS(*cptr)) *cptr++ = '\0';
       };
     };
   };
 }
+
+void CIB::Load(void)
+{
+  // Load the input buffer
+
+  if (!iseof) {ResetBuffer(); ResetTokens(); ReadLine(cv, cibLen, iseof); Tokenize();}
+}
+
+void CIB::LoadFromStr(const char *str, const bool eof)
+{
+  // Load the input buffer from a line already read; the line is truncated if too long
+
+  if (!iseof)
+  {
+    ui count = 0;
+
+    ResetBuffer(); ResetTokens(); iseof = eof;
+    while (str[count] && (count < (cibLen - 1))) {cv[count] = str[count]; count++;};
+    Tokenize();
+  };
+}
@@ -24,6 +24,7 @@ class CIB
     ~CIB(void) {}
 
     void Load(void);
+    void LoadFromStr(const char *str, const bool eof);
 
     bool IsEOF(void) const {return iseof;}
 
@@ -35,6 +36,8 @@ class CIB
     void ResetTokens(void);
     void Reset(void);
 
+    void Tokenize(void);
+
     bool iseof;
     ui8 tokencount;
     char cv[cibLen];
@@ -239,6 +239,26 @@ const svType cvmantosv[manLen] =
   svVacant, svExtra
 };
 
+// Converting chessman to color material signature digit step and digit limit
+
+const msigType cvmantomsigstep[manLen] =
+{
+  (msigKnightLen * msigBishopLen * msigRookLen * msigQueenLen),
+  (msigBishopLen * msigRookLen * msigQueenLen), (msigRookLen * msigQueenLen), msigQueenLen, 1, 0,
+  (msigKnightLen * msigBishopLen * msigRookLen * msigQueenLen),
+  (msigBishopLen * msigRookLen * msigQueenLen), (msigRookLen * msigQueenLen), msigQueenLen, 1, 0,
+  0, 0
+};
+
+const ui8 cvmantomsigcap[manLen] =
+{
+  (msigPawnLen - 1), (msigKnightLen - 1), (msigBishopLen - 1),
+  (msigRookLen - 1), (msigQueenLen - 1), 0,
+  (msigPawnLen - 1), (msigKnightLen - 1), (msigBishopLen - 1),
+  (msigRookLen - 1), (msigQueenLen - 1), 0,
+  0, 0
+};
+
 // Converting move special case to score value
 
 const svType cvmsctosv[mscLen] =
@@ -284,20 +304,23 @@ const char fsBanner3[]            PROGMEM = "See: http://creativecommons.org/lic
 
 // String flash storage: General options (must be pairwise ASCII ordered)
 
-const char fsOptnStrs[]           PROGMEM = "aacbctcvifipitnlnrpspvpzrbsrstts";
+const char fsOptnStrs[]           PROGMEM = "aacbctcvifipitnlnnnrpnpspvpzrbsrsssttbtsui";
 
 // String flash storage: ICP commands (must be pairwise ASCII ordered)
 
-const char fsIcpcStrs[]           PROGMEM = "atbbdbdfdhdldmdodsemfmfpgggpgshmidngptqprorpsdsfsosttb";
+const char fsIcpcStrs[]           PROGMEM = "atbbbncpdbdfdhdldmdodpdsdtemfmfpgggpgshmidlnngpmptqprorprssdsfsmsostsytbtetjto";
 
 // String flash storage: ICP user diagnostics
 
 const char fsUdBadMove[]          PROGMEM = "Bad move (try the 'dm' or 'hm' commands)\n";
 const char fsUdBadParmCount[]     PROGMEM = "Bad parameter count\n";
 const char fsUdBadParmValue[]     PROGMEM = "Bad parameter value\n";
+const char fsUdCantLoadNetwork[]  PROGMEM = "Can't load network file\n";
+const char fsUdCantLoadTables[]   PROGMEM = "Can't find tablebase files\n";
 const char fsUdDevHostOnly[]      PROGMEM = "Development host only\n";
 const char fsUdIgnoredParms[]     PROGMEM = "Parameters are ignored for this command.\n";
 const char fsUdNeedSingleUIParm[] PROGMEM = "Need single unsigned integer parameter\n";
+const char fsUdNoProfiler[]       PROGMEM = "Profiler not compiled (set UseProfiler)\n";
 const char fsUdNoTakeBackAvail[]  PROGMEM = "No take back available\n";
 
 // String flash storage: forced terminations
@@ -317,6 +340,8 @@ const char fsStForcedLose[]       PROGMEM = "Forced lose detected";
 const char fsStForcedMate[]       PROGMEM = "Forced mate detected";
 const char fsStInterrupt[]        PROGMEM = "User interrupt";
 const char fsStLimitDepth[]       PROGMEM = "Depth limit reached";
+const char fsStLimitMoves[]       PROGMEM = "Move stack limit reached";
+const char fsStLimitNodes[]       PROGMEM = "Node limit reached";
 const char fsStLimitTime[]        PROGMEM = "Time limit reached";
 const char fsStMateIn1[]          PROGMEM = "Mate in one move detected";
 const char fsStNoMoves[]          PROGMEM = "No moves at root";
@@ -337,20 +362,27 @@ const char fsScPosInf[]           PROGMEM = "PosInf";
 const char fsLbDepthLimit[]       PROGMEM = "Depth limit";
 const char fsLbDepth[]            PROGMEM = "Depth";
 const char fsLbDistance[]         PROGMEM = "Distance";
+const char fsLbExtensions[]       PROGMEM = "Extensions";
 const char fsLbFen[]              PROGMEM = "FEN";
 const char fsLbFrequency[]        PROGMEM = "Frequency";
 const char fsLbGameOver[]         PROGMEM = "Game over";
 const char fsLbHash[]             PROGMEM = "Hash";
 const char fsLbIteration[]        PROGMEM = "Iteration";
 const char fsLbMove[]             PROGMEM = "Move";
+const char fsLbMoveStackPeak[]    PROGMEM = "Move stack peak";
 const char fsLbMoves[]            PROGMEM = "Moves";
+const char fsLbMultiPV[]          PROGMEM = "Multi-PV";
 const char fsLbMyMove[]           PROGMEM = "My move";
 const char fsLbNodes[]            PROGMEM = "Nodes";
 const char fsLbOptions[]          PROGMEM = "Options";
+const char fsLbOverflows[]        PROGMEM = "Overflows";
 const char fsLbPV[]               PROGMEM = "PV";
 const char fsLbPlaying[]          PROGMEM = "Playing";
+const char fsLbPlyPeaks[]         PROGMEM = "Ply peaks";
 const char fsLbScore[]            PROGMEM = "Score";
 const char fsLbSeconds[]          PROGMEM = "Seconds";
+const char fsLbTBHits[]           PROGMEM = "TB hits";
+const char fsLbTBProbes[]         PROGMEM = "TB probes";
 const char fsLbTimeLimit[]        PROGMEM = "Time limit";
 const char fsLbUnplayedMove[]     PROGMEM = "Unplayed move";
 const char fsLbYourMove[]         PROGMEM = "Your move";
@@ -380,19 +412,50 @@ const char fsMsSfxHz[]            PROGMEM = " Hz";
 const char fsMsSqBlack[]          PROGMEM = "::";
 const char fsMsSqWhite[]          PROGMEM = "  ";
 
+// String flash storage: UCI protocol output
+
+const char fsUcId[]               PROGMEM =
+  "id name Myopic v2010.08.13\n"
+  "id author chessnotation@me.com\n";
+const char fsUcOptions[]          PROGMEM =
+  "option name OwnBook type check default true\n"
+  "option name Ponder type check default false\n"
+  "option name Move Overhead type spin default 50 min 0 max 5000\n"
+  "option name MultiPV type spin default 1 min 1 max 32\n"
+  "option name SyzygyPath type string default <empty>\n";
+const char fsUcBadPosition[]      PROGMEM = "info string Bad position or move\n";
+const char fsUcBestMove[]         PROGMEM = "bestmove ";
+const char fsUcInfoDepth[]        PROGMEM = "info depth ";
+const char fsUcInfoString[]       PROGMEM = "info string ";
+const char fsUcMultiPV[]          PROGMEM = " multipv ";
+const char fsUcNodes[]            PROGMEM = " nodes ";
+const char fsUcNps[]              PROGMEM = " nps ";
+const char fsUcNullMove[]         PROGMEM = "0000";
+const char fsUcPV[]               PROGMEM = " pv";
+const char fsUcPonder[]           PROGMEM = " ponder ";
+const char fsUcReadyOk[]          PROGMEM = "readyok\n";
+const char fsUcScoreCp[]          PROGMEM = " score cp ";
+const char fsUcScoreMate[]        PROGMEM = " score mate ";
+const char fsUcTime[]             PROGMEM = " time ";
+const char fsUcUciOk[]            PROGMEM = "uciok\n";
+
 // String flash storage: the ICP help string
 
 const char fsIcpHelp[]            PROGMEM =
   "Commands:\n"
   "  at  Activate common trace options\n"
   "  bb  Build book <input-game-file> <output-code-file>\n"
+  "  bn  Bench [p] [<depth> [<threads>]] (p: movepath enumeration; threads 0: all processors)\n"
+  "  cp  Convert positions <input-position-file> <output-position-file>\n"
   "  db  Display board\n"
   "  df  Display FEN\n"
   "  dh  Display position hash\n"
   "  dl  Display opening library moves\n"
   "  dm  Display moves\n"
   "  do  Display options\n"
+  "  dp  Display and reset profile (phase tick histograms)\n"
   "  ds  Display status\n"
+  "  dt  Display trace ring\n"
   "  em  Enumerate movepaths to depth <n> plies\n"
   "  fm  Fast enumerate movepaths to depth <n> plies\n"
   "  fp  Flip position\n"
@@ -401,16 +464,24 @@ const char fsIcpHelp[]            PROGMEM =
   "  gs  Go search\n"
   "  hm  Help me\n"
   "  id  Show program identification\n"
+  "  ln  Load network <input-network-file>\n"
   "  ng  New game\n"
+  "  pm  Play match <games> <config-a> <config-b> <output-pgn-file> [<node-limit> [<file>]]\n"
   "  pt  Program test\n"
   "  qp  Quit program\n"
   "  ro  Reset option(s) (limit 7)\n"
   "  rp  Reset program\n"
+  "  rs  Run test suite <input-position-file> [<node-limit>] (default: time limit)\n"
   "  sd  Set depth limit to <n> plies\n"
   "  sf  Set FEN\n"
+  "  sm  Set multi-PV count to <n> root moves\n"
   "  so  Set option(s) (limit 7)\n"
   "  st  Set time limit to <n> seconds\n"
+  "  sy  Set tablebase directory <directory> [<men-limit>]\n"
   "  tb  Take back move\n"
+  "  te  Tune evaluation <input-position-file> <output-code-file>\n"
+  "  tj  Trace JSON stream <[output-json-file]> (default: off)\n"
+  "  to  Trace output <[output-trace-file | *]> (default: console; *: memory ring)\n"
   "\n"
   "Options:\n"
   "  aa  Audible alert on move reply\n"
@@ -421,14 +492,19 @@ const char fsIcpHelp[]            PROGMEM =
   "  ip  Trace input parameters\n"
   "  it  Trace iteration announcements\n"
   "  nl  No opening library book\n"
+  "  nn  Neural network evaluation (after 'ln')\n"
   "  nr  No auto move reply\n"
+  "  pn  Ponder on the user's time\n"
   "  ps  Trace preliminary scoring\n"
   "  pv  Trace predicted variation updates\n"
   "  pz  Trace ply zero move activity\n"
   "  rb  Rotate board display (White at top)\n"
   "  sr  Trace search result\n"
+  "  ss  Trace search statistics (JSON)\n"
   "  st  Trace search termination\n"
+  "  tb  Tablebase probing (after 'sy')\n"
   "  ts  Trace timing statistics\n"
+  "  ui  UCI protocol search information\n"
   "\n"
   "Moves:\n"
   "  Enter one or move moves (limit 8); use 'dm' command for list.\n";
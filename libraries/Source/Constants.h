@@ -74,6 +74,8 @@ extern const tidType cvcolortokingtid[colorRLen];
 extern const tidType cvcolortotidlimit[colorRLen];
 
 extern const svType cvmantosv[manLen];
+extern const msigType cvmantomsigstep[manLen];
+extern const ui8 cvmantomsigcap[manLen];
 extern const svType cvmsctosv[mscLen];
 
 extern const char charofdigit[16]        PROGMEM;
@@ -100,9 +102,12 @@ extern const char fsIcpcStrs[]           PROGMEM;
 extern const char fsUdBadMove[]          PROGMEM;
 extern const char fsUdBadParmCount[]     PROGMEM;
 extern const char fsUdBadParmValue[]     PROGMEM;
+extern const char fsUdCantLoadNetwork[]  PROGMEM;
+extern const char fsUdCantLoadTables[]   PROGMEM;
 extern const char fsUdDevHostOnly[]      PROGMEM;
 extern const char fsUdIgnoredParms[]     PROGMEM;
 extern const char fsUdNeedSingleUIParm[] PROGMEM;
+extern const char fsUdNoProfiler[]       PROGMEM;
 extern const char fsUdNoTakeBackAvail[]  PROGMEM;
 
 extern const char fsFtCheckmate[]        PROGMEM;
@@ -118,6 +123,8 @@ extern const char fsStForcedLose[]       PROGMEM;
 extern const char fsStForcedMate[]       PROGMEM;
 extern const char fsStInterrupt[]        PROGMEM;
 extern const char fsStLimitDepth[]       PROGMEM;
+extern const char fsStLimitMoves[]       PROGMEM;
+extern const char fsStLimitNodes[]       PROGMEM;
 extern const char fsStLimitTime[]        PROGMEM;
 extern const char fsStMateIn1[]          PROGMEM;
 extern const char fsStNoMoves[]          PROGMEM;
@@ -134,20 +141,27 @@ extern const char fsScPosInf[]           PROGMEM;
 extern const char fsLbDepthLimit[]       PROGMEM;
 extern const char fsLbDepth[]            PROGMEM;
 extern const char fsLbDistance[]         PROGMEM;
+extern const char fsLbExtensions[]       PROGMEM;
 extern const char fsLbFen[]              PROGMEM;
 extern const char fsLbFrequency[]        PROGMEM;
 extern const char fsLbGameOver[]         PROGMEM;
 extern const char fsLbHash[]             PROGMEM;
 extern const char fsLbIteration[]        PROGMEM;
 extern const char fsLbMove[]             PROGMEM;
+extern const char fsLbMoveStackPeak[]    PROGMEM;
 extern const char fsLbMoves[]            PROGMEM;
+extern const char fsLbMultiPV[]          PROGMEM;
 extern const char fsLbMyMove[]           PROGMEM;
 extern const char fsLbNodes[]            PROGMEM;
 extern const char fsLbOptions[]          PROGMEM;
+extern const char fsLbOverflows[]        PROGMEM;
 extern const char fsLbPV[]               PROGMEM;
 extern const char fsLbPlaying[]          PROGMEM;
+extern const char fsLbPlyPeaks[]         PROGMEM;
 extern const char fsLbScore[]            PROGMEM;
 extern const char fsLbSeconds[]          PROGMEM;
+extern const char fsLbTBHits[]           PROGMEM;
+extern const char fsLbTBProbes[]         PROGMEM;
 extern const char fsLbTimeLimit[]        PROGMEM;
 extern const char fsLbUnplayedMove[]     PROGMEM;
 extern const char fsLbYourMove[]         PROGMEM;
@@ -173,6 +187,24 @@ extern const char fsMsSfxHz[]            PROGMEM;
 extern const char fsMsSqBlack[]          PROGMEM;
 extern const char fsMsSqWhite[]          PROGMEM;
 
+extern const char fsUcId[]               PROGMEM;
+extern const char fsUcOptions[]          PROGMEM;
+extern const char fsUcBadPosition[]      PROGMEM;
+extern const char fsUcBestMove[]         PROGMEM;
+extern const char fsUcInfoDepth[]        PROGMEM;
+extern const char fsUcInfoString[]       PROGMEM;
+extern const char fsUcMultiPV[]          PROGMEM;
+extern const char fsUcNodes[]            PROGMEM;
+extern const char fsUcNps[]              PROGMEM;
+extern const char fsUcNullMove[]         PROGMEM;
+extern const char fsUcPV[]               PROGMEM;
+extern const char fsUcPonder[]           PROGMEM;
+extern const char fsUcReadyOk[]          PROGMEM;
+extern const char fsUcScoreCp[]          PROGMEM;
+extern const char fsUcScoreMate[]        PROGMEM;
+extern const char fsUcTime[]             PROGMEM;
+extern const char fsUcUciOk[]            PROGMEM;
+
 extern const char fsIcpHelp[]            PROGMEM;
 
 #endif
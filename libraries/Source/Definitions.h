@@ -57,8 +57,10 @@ typedef unsigned int ui;
 #if (IsDevHost)
 typedef signed   short int si16;
 typedef signed         int si32;
+typedef signed   long long int si64;
 typedef unsigned short int ui16;
 typedef unsigned       int ui32;
+typedef unsigned long long int ui64;
 #endif
 
 #if (IsTarget)
@@ -105,6 +107,17 @@ inline si8 ReadFlashSi8(const si8 *ptr)
 #endif
 }
 
+inline si16 ReadFlashSi16(const si16 *ptr)
+{
+#if (IsDevHost)
+  return *ptr;
+#endif
+
+#if (IsTarget)
+  return (si16) pgm_read_word_near((ui16 *) ptr);
+#endif
+}
+
 // ******** All platform independent code follows
 
 // Useful mask
@@ -130,6 +143,29 @@ inline si8 ReadFlashSi8(const si8 *ptr)
 
 typedef ui32 msType; // Milliseconds
 
+#define msInfinite 0x7fffffffUL // Effectively unlimited time
+
+// Output buffer length (characters); the host also has a trace output memory ring
+
+#if (IsDevHost)
+#define OutBufLen    4096
+#define TraceRingLen BXL(16)
+#endif
+
+#if (IsTarget)
+#define OutBufLen 64
+#endif
+
+// Trace output destinations (routing is development host only)
+
+typedef enum
+{
+  tdNil = -1,
+  tdConsole, // With all other output
+  tdFile,    // File (a device file like /dev/fd/3 will do)
+  tdRing     // Memory ring
+} tdType;
+
 // ******** Chess related items used for storage requirement calculations
 
 // Maximum ply depth; higher numbers consume more storage
@@ -137,15 +173,77 @@ typedef ui32 msType; // Milliseconds
 #define MaxPlyLen   20
 #define MaxPlyLenP1 (MaxPlyLen + 1)
 
-// Move stack size (move sized units; a move uses eight bytes)
+// Move stack size (entry units; an entry is a packed move, a score, and a flag byte, for
+// five bytes); the host has room for a full holder list at every ply
+
+#if (IsDevHost)
+#define MoveStackLen (MaxPlyLen * 64)
+#endif
 
+#if (IsTarget)
 #define MoveStackLen (MaxPlyLen * 16)
+#endif
+
+// Search position update method: nonzero for copy-make (a position copy is kept for each
+// ply), zero for execute/retract with environment snapshots; may be set when compiling
+
+#ifndef UseCopyMake
+#define UseCopyMake 0
+#endif
+
+// Host cache line length (bytes)
+
+#define CacheLineLen 64
+
+// Copy-make position copies are cache line aligned on the host
+
+#if (IsDevHost && UseCopyMake)
+#define PosAlignment __attribute__ ((aligned (CacheLineLen)))
+#endif
+
+#if (!(IsDevHost && UseCopyMake))
+#define PosAlignment
+#endif
+
+// Bitboard move counting cross-check against full generation (host debugging only); may be
+// set when compiling
+
+#ifndef BBCrossCheck
+#define BBCrossCheck 0
+#endif
+
+// Profiler hooks: nonzero to gather per phase tick histograms for the 'dp' command, zero to
+// compile the instrumentation points out entirely; may be set when compiling
+
+#ifndef UseProfiler
+#define UseProfiler 0
+#endif
+
+// Search statistics phase times: nonzero to compile the instrumentation points in on the
+// host for the "ss" trace block even without the profiler (a profiler build times them for
+// the block anyway); may be set when compiling
+
+#ifndef UseSSBPhases
+#define UseSSBPhases 0
+#endif
+
+// Move list length sufficient for any position (the known maximum is 218 moves)
+
+#define PosMovesLen 256
 
 // Predicted variation maximum length; MaxPVLen <= MaxPlyLen
 
 #define MaxPVLen    7
 #define MaxPVLenP1 (MaxPVLen + 1)
 
+// Multiple predicted variation (analysis) maximum count
+
+#define MultiPVLen 32
+
+// Move picking: selection picks made before the rest of a move batch is sorted at once
+
+#define PickSelectLen 3
+
 // ******** Chess related items
 
 // For the fifty move rule
@@ -368,6 +466,13 @@ inline bool IsDirCrook(const dirType dir) {return (dir >= dirENE) && (dir <= dir
 
 #define sqrdirLen (sqrLen * dirLen)
 
+// Indexing of king/knight run square tables (each run is terminated by a nil square)
+
+#define kingspanLen   (dirSLen + 1)
+#define kingrunLen    (sqrLen * kingspanLen)
+#define knightspanLen (dirCLen + 1)
+#define knightrunLen  (sqrLen * knightspanLen)
+
 // Direction descriptor byte
 
 typedef ui8 ddbType;
@@ -727,6 +832,10 @@ typedef enum
 
 #define sanLen 8
 
+// UCI coordinate move notation maximum character length plus one
+
+#define ucimLen 6
+
 // Forsyth-Edwards Notation maximum character length construction
 
 #define fenBoardLen ((fileLen + 1) * rankLen) // 72
@@ -767,6 +876,8 @@ typedef enum
   stForcedMate,  // Forced mate detected
   stInterrupt,   // User interrupt
   stLimitDepth,  // Depth limit reached
+  stLimitMoves,  // Move stack limit reached
+  stLimitNodes,  // Node limit reached
   stLimitTime,   // Time limit reached
   stMateIn1,     // Mate in one move detected
   stNoMoves,     // No moves
@@ -800,6 +911,125 @@ typedef si16 svType;
 
 #define svInitial ((svPawn * 8) + (svKnight * 2) + (svBishop * 2) + (svRook * 2) + (svQueen * 1))
 
+// Evaluation parameter indices (scalar weights followed by square indexed tables)
+
+typedef si16 epType;
+
+#define makeep(ordinal) ((epType) (ordinal))
+
+#define epOnMove             makeep( 0) // On the move bonus
+#define epPawnMultiple       makeep( 1) // Pawn: multiple on file penalty
+#define epKnightRim          makeep( 2) // Knight: rim penalty
+#define epKnightKingTropism  makeep( 3) // Knight: other king separation (per unit)
+#define epKnightPinned       makeep( 4) // Knight: pinned penalty
+#define epKnightMobility     makeep( 5) // Knight: mobility (per attack)
+#define epBishopRim          makeep( 6) // Bishop: rim penalty
+#define epBishopPinned       makeep( 7) // Bishop: pinned penalty
+#define epBishopMobility     makeep( 8) // Bishop: mobility (per attack)
+#define epRookPinned         makeep( 9) // Rook: pinned penalty
+#define epRookMobility       makeep(10) // Rook: mobility (per attack)
+#define epRookOpenFile       makeep(11) // Rook: open file bonus
+#define epRookSemiOpenFile   makeep(12) // Rook: semi-open file bonus
+#define epQueenRim           makeep(13) // Queen: rim penalty
+#define epQueenPinned        makeep(14) // Queen: pinned penalty
+#define epQueenMobility      makeep(15) // Queen: mobility (per attack)
+#define epPawnPlacementBase  makeep(16) // Pawn: placement table (White's point of view)
+#define epKnightCenterBase   makeep(epPawnPlacementBase + sqrLen) // Knight: center tropism table
+
+#define epNil     makeep(-1)
+#define epScalLen epPawnPlacementBase
+#define epLen     (epKnightCenterBase + sqrLen)
+
+// Material signature type; the clamped man counts of one color as mixed radix digits (pawn
+// count most significant), or of both colors as a pair of color signatures (White first)
+
+typedef ui16 msigType;
+
+#define msigPawnLen   3 // Pawn count: 0, 1, or 2+
+#define msigKnightLen 3 // Knight count: 0, 1, or 2+
+#define msigBishopLen 3 // Bishop count: 0, 1, or 2+
+#define msigRookLen   3 // Rook count: 0, 1, or 2+
+#define msigQueenLen  2 // Queen count: 0 or 1+
+
+#define msigColorLen (msigPawnLen * msigKnightLen * msigBishopLen * msigRookLen * msigQueenLen)
+
+#define msigLen (msigColorLen * msigColorLen) // 26,244
+
+// Specialized endgame evaluator identifiers (selected by material signature)
+
+typedef enum
+{
+  egidNil = -1,
+  egidNone, // No specialized evaluator
+  egidKXK,  // Mating material versus a bare king
+  egidKBNK, // Bishop and knight versus a bare king
+  egidKPK   // Single pawn versus a bare king (development host only)
+} egidType;
+
+#define egidLen (egidKPK + 1)
+
+// Material table entry flags
+
+typedef enum
+{
+  mtefNil = -1,
+  mtefDraw,      // Insufficient material for either side to checkmate
+  mtefBishops    // Single bishops each, no other pieces (test for opposite colors)
+} mtefType;
+
+// Material table entry flag masks
+
+typedef ui8 mtefmType;
+
+#define mtefmDraw    ((mtefmType) BX(mtefDraw))
+#define mtefmBishops ((mtefmType) BX(mtefBishops))
+
+// Material table color entry flags; each describes the clamped man counts of one color
+
+typedef enum
+{
+  mtcfNil = -1,
+  mtcfPawns,       // At least one pawn
+  mtcfKnightsOnly, // No bishops, rooks, or queens
+  mtcfBishopPair,  // At least two bishops
+  mtcfSufficient,  // A pawn, rook, queen, or at least two minor pieces
+  mtcfLoneBishop,  // A single bishop and no knights, rooks, or queens
+  mtcfMating,      // A rook, queen, or at least two bishops
+  mtcfKBN,         // No pawns, a single knight, and a single bishop
+  mtcfKP           // A single pawn and no minor pieces
+} mtcfType;
+
+// Material table color entry flag masks
+
+typedef ui8 mtcfmType;
+
+#define mtcfmPawns       ((mtcfmType) BX(mtcfPawns))
+#define mtcfmKnightsOnly ((mtcfmType) BX(mtcfKnightsOnly))
+#define mtcfmBishopPair  ((mtcfmType) BX(mtcfBishopPair))
+#define mtcfmSufficient  ((mtcfmType) BX(mtcfSufficient))
+#define mtcfmLoneBishop  ((mtcfmType) BX(mtcfLoneBishop))
+#define mtcfmMating      ((mtcfmType) BX(mtcfMating))
+#define mtcfmKBN         ((mtcfmType) BX(mtcfKBN))
+#define mtcfmKP          ((mtcfmType) BX(mtcfKP))
+
+// Material table scale factors (applied to the score of the favored side)
+
+#define mtsFull    64 // No scaling
+#define mtsHard    16 // Hard to win
+#define mtsNone     0 // Can't win
+
+// Material table bishop pair bonus
+
+#define svBishopPair (30 * svCP)
+
+// Specialized endgame evaluation known win base score
+
+#define svKnownWin (svPawn * 50)
+
+// Tablebase win base score (less the distance in plies)
+
+#define svTBWin (svPawn * 100)
+
 // Move generation type (gaining moves and holding moves)
 
 typedef enum
@@ -844,17 +1074,22 @@ typedef enum
   optnIP, // Trace input parameters
   optnIT, // Trace iteration announcements
   optnNL, // No opening library book
+  optnNN, // Neural network evaluation (development host only)
   optnNR, // No auto move reply
+  optnPN, // Ponder on the user's time (development host only)
   optnPS, // Trace preliminary scoring
   optnPV, // Trace predicted variation updates
   optnPZ, // Trace ply zero move activity
   optnRB, // Rotate board display (White at top)
   optnSR, // Trace search result
+  optnSS, // Trace search statistics (development host only)
   optnST, // Trace search termination
-  optnTS  // Trace timing statistics
+  optnTB, // Tablebase probing (development host only)
+  optnTS, // Trace timing statistics
+  optnUI  // UCI protocol search information
 } optnType;
 
-#define optnLen (optnTS + 1)
+#define optnLen (optnUI + 1)
 
 inline bool IsOptnNil(const optnType optn)    {return optn <  0;}
 inline bool IsOptnNotNil(const optnType optn) {return optn >= 0;}
@@ -863,24 +1098,29 @@ inline bool IsOptnNotNil(const optnType optn) {return optn >= 0;}
 
 // Option masks
 
-typedef ui16 optnmType;
-
-#define optnmAA BX(optnAA)
-#define optnmCB BX(optnCB)
-#define optnmCT BX(optnCT)
-#define optnmCV BX(optnCV)
-#define optnmIF BX(optnIF)
-#define optnmIP BX(optnIP)
-#define optnmIT BX(optnIT)
-#define optnmNL BX(optnNL)
-#define optnmNR BX(optnNR)
-#define optnmPS BX(optnPS)
-#define optnmPV BX(optnPV)
-#define optnmPZ BX(optnPZ)
-#define optnmRB BX(optnRB)
-#define optnmSR BX(optnSR)
-#define optnmST BX(optnST)
-#define optnmTS BX(optnTS)
+typedef ui32 optnmType;
+
+#define optnmAA BXL(optnAA)
+#define optnmCB BXL(optnCB)
+#define optnmCT BXL(optnCT)
+#define optnmCV BXL(optnCV)
+#define optnmIF BXL(optnIF)
+#define optnmIP BXL(optnIP)
+#define optnmIT BXL(optnIT)
+#define optnmNL BXL(optnNL)
+#define optnmNN BXL(optnNN)
+#define optnmNR BXL(optnNR)
+#define optnmPN BXL(optnPN)
+#define optnmPS BXL(optnPS)
+#define optnmPV BXL(optnPV)
+#define optnmPZ BXL(optnPZ)
+#define optnmRB BXL(optnRB)
+#define optnmSR BXL(optnSR)
+#define optnmSS BXL(optnSS)
+#define optnmST BXL(optnST)
+#define optnmTB BXL(optnTB)
+#define optnmTS BXL(optnTS)
+#define optnmUI BXL(optnUI)
 
 // User commands (ICP interface)
 
@@ -889,13 +1129,17 @@ typedef enum
   icpcNil = -1,
   icpcAT, // Activate common trace options
   icpcBB, // Build book <input-game-file> <output-code-file>
+  icpcBN, // Bench [p] [<depth> [<threads>]]
+  icpcCP, // Convert positions <input-position-file> <output-position-file>
   icpcDB, // Display board
   icpcDF, // Display FEN
   icpcDH, // Display position hash
   icpcDL, // Display opening library moves
   icpcDM, // Display moves
   icpcDO, // Display options
+  icpcDP, // Display profile
   icpcDS, // Display status
+  icpcDT, // Display trace ring
   icpcEM, // Enumerate movepaths
   icpcFM, // Fast enumerate movepaths
   icpcFP, // Flip position
@@ -904,19 +1148,27 @@ typedef enum
   icpcGS, // Go search
   icpcHM, // Help me
   icpcID, // Show program identification
+  icpcLN, // Load network <input-network-file>
   icpcNG, // New game
+  icpcPM, // Play match
   icpcPT, // Program test
   icpcQP, // Quit program
   icpcRO, // Reset option(s)
   icpcRP, // Reset program
+  icpcRS, // Run test suite
   icpcSD, // Set depth limit
   icpcSF, // Set FEN
+  icpcSM, // Set multi-PV count
   icpcSO, // Set option(s)
   icpcST, // Set time limit
-  icpcTB  // Take back move
+  icpcSY, // Set tablebase directory <directory> [<men-limit>]
+  icpcTB, // Take back move
+  icpcTE, // Tune evaluation <input-position-file> <output-code-file>
+  icpcTJ, // Trace JSON stream <[output-json-file]>
+  icpcTO  // Trace output <[output-trace-file | *]>
 } icpcType;
 
-#define icpcLen (icpcTB + 1)
+#define icpcLen (icpcTO + 1)
 
 inline bool IsIcpcNil(const icpcType icpc)    {return icpc <  0;}
 inline bool IsIcpcNotNil(const icpcType icpc) {return icpc >= 0;}
@@ -0,0 +1,75 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_EEnv
+#define Included_EEnv
+
+// Forward class declaration(s)
+
+class EPV;
+
+// Evaluation Environment class
+//
+// The EEnv class holds the scratch state of a single static evaluation: the weights
+// in use, the color, square, and target ID being evaluated, and the per file pawn
+// counts.  An instance lives only for the duration of a call to Pos::Evaluate; this
+// keeps the evaluation const and the position free of data that is never preserved.
+
+class EEnv
+{
+  public:
+    EEnv(const EPV& epv)
+    {
+      epvptr = &epv;
+#if (IsDevHost)
+      coefptr = 0;
+#endif
+    }
+
+    const EPV& FetchEPV(void) const {return *epvptr;}
+
+#if (IsDevHost)
+    si32 *GetCoefPtr(void) const {return coefptr;}
+    void PutCoefPtr(si32 *ptr) {coefptr = ptr;}
+#endif
+
+    colorType GetThisColor(void) const {return thiscolor;}
+    colorType GetThatColor(void) const {return thatcolor;}
+    void PutThisColor(const colorType color) {thiscolor = color; thatcolor = OtherColor(color);}
+
+    sqrType GetThisSqr(void) const {return thissqr;}
+    void PutThisSqr(const sqrType sqr) {thissqr = sqr;}
+
+    tidType GetThisTid(void) const {return thistid;}
+    void PutThisTid(const tidType tid) {thistid = tid;}
+
+    ui8 GetFilePawns(const colorType color, const fileType file) const
+    {
+      return filepawns[color][file];
+    }
+
+    void ResetFilePawns(const colorType color)
+    {
+      for (ui fileindex = 0; fileindex < fileLen; fileindex++) filepawns[color][fileindex] = 0;
+    }
+
+    void IncFilePawns(const colorType color, const fileType file) {filepawns[color][file]++;}
+
+  private:
+    const EPV *epvptr;                 // Evaluation weights
+#if (IsDevHost)
+    si32 *coefptr;                     // Evaluation weight coefficients (tuning only)
+#endif
+    colorType thiscolor, thatcolor;    // Evaluation colors
+    sqrType thissqr;                   // Evaluation square
+    tidType thistid;                   // Evaluation target ID
+    ui8 filepawns[colorRLen][fileLen]; // Evaluation pawn counts per file/color
+};
+
+#endif
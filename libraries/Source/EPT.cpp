@@ -0,0 +1,562 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "UnDo.h"
+#include "UnDoStack.h"
+#include "ML.h"
+#include "MoveStack.h"
+#include "Hash.h"
+#include "BookMove.h"
+#include "Book.h"
+#include "History.h"
+#include "TBV.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
+#include "Pos.h"
+#include "PVTable.h"
+#include "PIR.h"
+#include "Search.h"
+#include "State.h"
+#include "BPL.h"
+#include "WPL.h"
+#include "EPT.h"
+
+#define epttknLen 32 // Position record token length limit
+
+#define EPTIterLimit 500 // Optimization iteration count
+#define EPTStepSize  1.0 // Optimization step size (centipawns)
+
+// Names of the scalar weights; used for code file comments
+
+static const char *epnames[epScalLen] =
+{
+  "OnMove",
+  "PawnMultiple",
+  "KnightRim",
+  "KnightKingTropism",
+  "KnightPinned",
+  "KnightMobility",
+  "BishopRim",
+  "BishopPinned",
+  "BishopMobility",
+  "RookPinned",
+  "RookMobility",
+  "RookOpenFile",
+  "RookSemiOpenFile",
+  "QueenRim",
+  "QueenPinned",
+  "QueenMobility"
+};
+
+// A tuning sample: one quiescent position reduced to a base score and its coefficients
+
+typedef struct
+{
+  double result;  // Game result from White's point of view (1, 1/2, or 0)
+  si32 basesv;    // Score portion not due to the weights (White's point of view)
+  ui32 coefbase;  // Index of the first nonzero coefficient
+  ui16 coefcount; // Count of nonzero coefficients
+} EPTSample;
+
+// A nonzero weight coefficient of a tuning sample
+
+typedef struct
+{
+  epType ep; // Weight index
+  si16 coef; // Coefficient (White's point of view)
+} EPTCoef;
+
+// Per shard work: the samples of a contiguous range of loaded position records
+
+typedef struct
+{
+  const BPL *bplptr;
+  const EPV *epvptr;
+  ui32 frindex, toindex;
+  ui32 badcount;
+  std::vector<EPTSample> samples;
+  std::vector<EPTCoef> coefs;
+  const double *parmsptr;
+  double k, loss;
+  double grad[epLen];
+} EPTShard;
+
+static bool MatchResult(const char *token, double& result)
+{
+  // Match a game result token; surrounding quotes, brackets, and semicolons are ignored
+
+  char str[sanLen];
+  ui length = 0;
+
+  while (*token && (length < (sanLen - 1)))
+  {
+    const char ch = *token++;
+
+    if ((ch != '"') && (ch != '[') && (ch != ']') && (ch != ';')) str[length++] = ch;
+  };
+  str[length] = '\0';
+
+  bool found = true;
+
+  if ((strcmp(str, "1-0") == 0) || (strcmp(str, "1.0") == 0)) result = 1.0;
+  else
+    if ((strcmp(str, "0-1") == 0) || (strcmp(str, "0.0") == 0)) result = 0.0;
+    else
+      if ((strcmp(str, "1/2-1/2") == 0) || (strcmp(str, "0.5") == 0)) result = 0.5;
+      else
+        found = false;
+  return found;
+}
+
+static bool FindResult(const char *rest, double& result)
+{
+  // Locate the game result; it is the first recognized result token of the record rest
+
+  bool found = false;
+
+  while (!found && *rest)
+  {
+    char token[epttknLen];
+    ui length = 0;
+
+    while ((*rest == ' ') || (*rest == '\t')) rest++;
+    while (*rest && (*rest != ' ') && (*rest != '\t'))
+    {
+      if (length < (epttknLen - 1)) token[length++] = *rest;
+      rest++;
+    };
+    token[length] = '\0';
+    if (length > 0) found = MatchResult(token, result);
+  };
+  return found;
+}
+
+// Scan work shared by the workers: the shards of the loaded position records
+
+typedef struct
+{
+  std::vector<EPTShard> *shardvecptr;
+  const EPV *epvptr;
+} EPTScanWork;
+
+// Scan worker: each pool thread resolves with its own search state
+
+class EPTScanner
+{
+  public:
+    EPTScanner(const EPTScanWork& value);
+    ~EPTScanner(void) {delete posptr; delete stateptr;}
+
+    void Run(const ui32 shardindex);
+
+  private:
+    const EPTScanWork& work;
+    State *stateptr;
+    Pos *posptr;
+};
+
+EPTScanner::EPTScanner(const EPTScanWork& value): work(value)
+{
+  stateptr = new State; posptr = new Pos;
+  stateptr->OneTimeSetup(); stateptr->RefEPV() = *work.epvptr;
+}
+
+void EPTScanner::Run(const ui32 shardindex)
+{
+  // Resolve and reduce the positions of one shard
+
+  EPTShard *shardptr = &(*work.shardvecptr)[shardindex];
+  FPos fpos, leaf;
+
+  shardptr->badcount = 0;
+
+  for (ui32 index = shardptr->frindex; index < shardptr->toindex; index++)
+  {
+    double result;
+
+    if (!FindResult(shardptr->bplptr->FetchRest(index), result)) shardptr->badcount++;
+    else
+    {
+      // Locate the quiescent leaf, skipping positions already at the end of the game
+
+      fpos.LoadFromPPos(shardptr->bplptr->FetchPPos(index));
+      stateptr->LoadStateFromFPos(fpos);
+      stateptr->ResolveQuiescence(leaf);
+      posptr->LoadPosFromFPos(leaf);
+      if (!posptr->NoMoves())
+      {
+        si32 coefs[epLen];
+
+        for (epType ep = 0; ep < epLen; ep++) coefs[ep] = 0;
+
+        // Evaluate with coefficient recording; convert to White's point of view
+
+        const si sign = leaf.IsWTM() ? 1 : -1;
+        si32 basesv = posptr->Evaluate(*shardptr->epvptr, coefs) * sign;
+        EPTSample sample;
+
+        sample.result = result;
+        sample.coefbase = (ui32) shardptr->coefs.size();
+        for (epType ep = 0; ep < epLen; ep++)
+        {
+          if (coefs[ep])
+          {
+            EPTCoef coef;
+
+            coef.ep = ep; coef.coef = (si16) (coefs[ep] * sign);
+            shardptr->coefs.push_back(coef);
+            basesv -= shardptr->epvptr->GetParm(ep) * coef.coef;
+          };
+        };
+        sample.basesv = basesv;
+        sample.coefcount = (ui16) (shardptr->coefs.size() - sample.coefbase);
+        shardptr->samples.push_back(sample);
+      };
+    };
+  };
+}
+
+static double Sigmoid(const double k, const double sv)
+{
+  // Map a score to a win probability
+
+  return 1.0 / (1.0 + pow(10.0, -k * sv / 400.0));
+}
+
+static void CalcShard(EPTShard *shardptr, const bool gradient)
+{
+  // Calculate the squared error sum, and optionally its gradient, for one shard
+
+  const double *parms = shardptr->parmsptr;
+  const double k = shardptr->k, dscale = k * log(10.0) / 400.0;
+
+  shardptr->loss = 0.0;
+  if (gradient) for (epType ep = 0; ep < epLen; ep++) shardptr->grad[ep] = 0.0;
+
+  for (ui32 index = 0; index < shardptr->samples.size(); index++)
+  {
+    const EPTSample& sample = shardptr->samples[index];
+    const EPTCoef *coefptr = shardptr->coefs.data() + sample.coefbase;
+    double sv = sample.basesv;
+
+    for (ui16 cindex = 0; cindex < sample.coefcount; cindex++)
+      sv += parms[coefptr[cindex].ep] * coefptr[cindex].coef;
+
+    const double prob = Sigmoid(k, sv), error = sample.result - prob;
+
+    shardptr->loss += error * error;
+    if (gradient)
+    {
+      const double dsv = -2.0 * error * prob * (1.0 - prob) * dscale;
+
+      for (ui16 cindex = 0; cindex < sample.coefcount; cindex++)
+        shardptr->grad[coefptr[cindex].ep] += dsv * coefptr[cindex].coef;
+    };
+  };
+}
+
+// Calculation worker pool: one thread per shard, started once and reused by every pass
+
+class EPTPool
+{
+  public:
+    EPTPool(std::vector<EPTShard>& shardvec): shards(shardvec)
+    {
+      generation = 0; pending = 0; gradient = false; stop = false;
+      for (ui index = 0; index < shards.size(); index++)
+        threads.push_back(std::thread(&EPTPool::Worker, this, index));
+    }
+
+    ~EPTPool(void)
+    {
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+
+        stop = true;
+      };
+      startcv.notify_all();
+      for (ui index = 0; index < threads.size(); index++) threads[index].join();
+    }
+
+    void RunPass(const bool grad)
+    {
+      // Release all of the workers for one pass and wait for them to finish
+
+      std::unique_lock<std::mutex> lock(mutex);
+
+      gradient = grad; pending = (ui) threads.size(); generation++;
+      startcv.notify_all();
+      while (pending > 0) donecv.wait(lock);
+    }
+
+    std::vector<EPTShard>& shards;
+
+  private:
+    void Worker(const ui index)
+    {
+      ui32 seen = 0;
+      std::unique_lock<std::mutex> lock(mutex);
+
+      while (!stop)
+      {
+        while (!stop && (generation == seen)) startcv.wait(lock);
+        if (!stop)
+        {
+          const bool grad = gradient;
+
+          seen = generation;
+          lock.unlock(); CalcShard(&shards[index], grad); lock.lock();
+          pending--;
+          if (pending == 0) donecv.notify_one();
+        };
+      };
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startcv, donecv;
+    ui32 generation;
+    ui pending;
+    bool gradient, stop;
+};
+
+static double CalcAll(EPTPool& pool, const double *parms, const double k, double *grad)
+{
+  // Calculate the mean squared error, and optionally its gradient, using all workers
+
+  std::vector<EPTShard>& shards = pool.shards;
+  ui32 samplecount = 0;
+  double loss = 0.0;
+
+  for (ui index = 0; index < shards.size(); index++)
+  {
+    shards[index].parmsptr = parms; shards[index].k = k;
+  };
+  pool.RunPass(grad != 0);
+
+  if (grad) for (epType ep = 0; ep < epLen; ep++) grad[ep] = 0.0;
+  for (ui index = 0; index < shards.size(); index++)
+  {
+    samplecount += (ui32) shards[index].samples.size(); loss += shards[index].loss;
+    if (grad) for (epType ep = 0; ep < epLen; ep++) grad[ep] += shards[index].grad[ep];
+  };
+
+  if (samplecount)
+  {
+    loss /= samplecount;
+    if (grad) for (epType ep = 0; ep < epLen; ep++) grad[ep] /= samplecount;
+  };
+  return loss;
+}
+
+static double FitK(EPTPool& pool, const double *parms)
+{
+  // Golden section search for the score scaling constant that best fits the results
+
+  const double ratio = (sqrt(5.0) - 1.0) / 2.0;
+  double lo = 0.1, hi = 4.0;
+  double k0 = hi - ratio * (hi - lo), k1 = lo + ratio * (hi - lo);
+  double loss0 = CalcAll(pool, parms, k0, 0), loss1 = CalcAll(pool, parms, k1, 0);
+
+  for (ui iter = 0; iter < 40; iter++)
+  {
+    if (loss0 < loss1)
+    {
+      hi = k1; k1 = k0; loss1 = loss0;
+      k0 = hi - ratio * (hi - lo); loss0 = CalcAll(pool, parms, k0, 0);
+    }
+    else
+    {
+      lo = k0; k0 = k1; loss0 = loss1;
+      k1 = lo + ratio * (hi - lo); loss1 = CalcAll(pool, parms, k1, 0);
+    };
+  };
+  return (lo + hi) / 2.0;
+}
+
+static void PrintCode(std::ostream *ofsptr, const EPV& epv)
+{
+  // Print the weights in the form used by the default weights code file
+
+  *ofsptr << "  // Scalar weights\n\n";
+  for (epType ep = 0; ep < epScalLen; ep++)
+    *ofsptr << "  " << std::setw(4) << epv.GetParm(ep) << ", // " << epnames[ep] << '\n';
+
+  *ofsptr << "\n  // Pawn placement (White's point of view, first rank first)\n\n";
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++)
+  {
+    if (MapSqrToFile(sqr) == fileA) *ofsptr << ' ';
+    *ofsptr << std::setw(4) << epv.GetParm(epPawnPlacementBase + sqr) << ',';
+    if (MapSqrToFile(sqr) == fileH) *ofsptr << '\n';
+  };
+
+  *ofsptr << "\n  // Knight center tropism\n\n";
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++)
+  {
+    if (MapSqrToFile(sqr) == fileA) *ofsptr << ' ';
+    *ofsptr << std::setw(4) << epv.GetParm(epKnightCenterBase + sqr);
+    if ((sqr + 1) < sqrLen) *ofsptr << ',';
+    if (MapSqrToFile(sqr) == fileH) *ofsptr << '\n';
+  };
+}
+
+bool EPT::TuneEval(State *stateptr, const char *posfn, const char *codefn)
+{
+  // Read a labeled position file to produce an evaluation weights code file
+
+  bool okay = true;
+  BPL bpl;
+  std::ofstream *ofsptr = 0;
+  std::vector<EPTShard> shards;
+  EPTPool *poolptr = 0;
+  ui32 samplecount = 0;
+  double parms[epLen], k = 1.0;
+
+  // Open the output code file
+
+  if (okay)
+  {
+    ofsptr = new std::ofstream(codefn);
+    if (ofsptr->fail()) {std::cerr << "Can't open code output file\n"; okay = false;};
+  };
+
+  // Pass one: Load, parse, and validate the position records
+
+  if (okay) okay = bpl.LoadFile(posfn);
+
+  // Pass two: Resolve and reduce the positions using one pool thread per shard
+
+  if (okay)
+  {
+    const ui32 count = bpl.GetCount();
+    const ui shardcount = WPL::CalcThreadCount(count, 0);
+    ui32 badcount = bpl.GetBadCount();
+    EPTScanWork work;
+
+    shards.resize(shardcount);
+    for (ui index = 0; index < shardcount; index++)
+    {
+      shards[index].bplptr = &bpl; shards[index].epvptr = &stateptr->RefEPV();
+      shards[index].frindex = (ui32) (((ui64) count * index) / shardcount);
+      shards[index].toindex = (ui32) (((ui64) count * (index + 1)) / shardcount);
+    };
+    work.shardvecptr = &shards; work.epvptr = &stateptr->RefEPV();
+    WPL::RunPool<EPTScanner>(shardcount, shardcount, work);
+
+    for (ui index = 0; index < shardcount; index++)
+    {
+      samplecount += (ui32) shards[index].samples.size(); badcount += shards[index].badcount;
+    };
+
+    // Print the summary for this pass
+
+    std::cout << "Position scan summary\n";
+    std::cout << "  Lines read: " << (count + bpl.GetBadCount()) << '\n';
+    std::cout << "  Lines rejected: " << badcount << '\n';
+    std::cout << "  Samples used: " << samplecount << '\n';
+    std::cout << "  Threads: " << shardcount << '\n';
+
+    if (samplecount == 0) {std::cerr << "No usable positions\n"; okay = false;};
+  };
+
+  // Pass three: Fit the score scaling constant with the current weights; the calculation
+  // workers are started here and kept until the end
+
+  if (okay)
+  {
+    poolptr = new EPTPool(shards);
+    for (epType ep = 0; ep < epLen; ep++) parms[ep] = stateptr->RefEPV().GetParm(ep);
+    k = FitK(*poolptr, parms);
+    std::cout << "Scaling constant: " << k << '\n';
+    std::cout << "  Initial error: " << CalcAll(*poolptr, parms, k, 0) << '\n';
+  };
+
+  // Pass four: Minimize the error with the Adam gradient method
+
+  if (okay)
+  {
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1.0e-8;
+    double grad[epLen], m[epLen], v[epLen];
+
+    for (epType ep = 0; ep < epLen; ep++) m[ep] = v[ep] = 0.0;
+
+    for (ui iter = 1; iter <= EPTIterLimit; iter++)
+    {
+      const double loss = CalcAll(*poolptr, parms, k, grad);
+      const double c1 = 1.0 - pow(beta1, iter), c2 = 1.0 - pow(beta2, iter);
+
+      for (epType ep = 0; ep < epLen; ep++)
+      {
+        m[ep] = (beta1 * m[ep]) + ((1.0 - beta1) * grad[ep]);
+        v[ep] = (beta2 * v[ep]) + ((1.0 - beta2) * grad[ep] * grad[ep]);
+        parms[ep] -= EPTStepSize * (m[ep] / c1) / (sqrt(v[ep] / c2) + epsilon);
+      };
+
+      if ((iter % 50) == 0) std::cout << "  Iteration " << iter << " error: " << loss << '\n';
+    };
+  };
+
+  // Pass five: Round the weights, install them, and print them to the code file
+
+  if (okay)
+  {
+    EPV& epv = stateptr->RefEPV();
+
+    for (epType ep = 0; ep < epLen; ep++)
+    {
+      double parm = floor(parms[ep] + 0.5);
+
+      if (parm > svPosInf) parm = svPosInf; else if (parm < svNegInf) parm = svNegInf;
+      epv.PutParm(ep, (si16) parm);
+      parms[ep] = epv.GetParm(ep);
+    };
+    std::cout << "  Final error: " << CalcAll(*poolptr, parms, k, 0) << '\n';
+
+    PrintCode(ofsptr, epv);
+    std::cout << "Code file output complete\n";
+  };
+
+  // Clean up and return
+
+  delete poolptr; delete ofsptr;
+  return okay;
+}
+
+#endif
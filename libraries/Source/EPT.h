@@ -0,0 +1,35 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_EPT
+#define Included_EPT
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class State;
+
+// Evaluation parameter tuner class
+//
+// The EPT class adjusts the evaluation weights to best predict the game results
+// of a collection of labeled positions.  Each position is first resolved to its
+// quiescent leaf and then reduced to a base score plus a set of weight coefficients;
+// this works because the evaluation is linear in its weights.  The weights are then
+// fit by minimizing the mean squared error of a logistic win probability.
+
+class EPT
+{
+  public:
+    bool TuneEval(State *stateptr, const char *posfn, const char *codefn);
+};
+
+#endif
+
+#endif
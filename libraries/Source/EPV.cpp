@@ -0,0 +1,86 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#endif
+
+#include "EPV.h"
+
+void EPV::LoadDefaults(void)
+{
+  // Load the default weights
+
+#if (IsDevHost)
+  for (epType ep = 0; ep < epLen; ep++) parms[ep] = ReadFlashSi16(defaultparms + ep);
+#endif
+}
+
+#if (IsDevHost)
+bool EPV::LoadFromFile(const char *fn)
+{
+  // Load the weights from a code file in the format written by the evaluation tuner: the
+  // values separated by commas, with comments running to the end of each line
+
+  std::ifstream ifs(fn);
+  std::string line, token;
+  si16 values[epLen];
+  ui count = 0;
+  bool okay = true;
+
+  if (ifs.fail()) {std::cerr << "Can't open evaluation weight file\n"; okay = false;}
+  else
+  {
+    while (okay && std::getline(ifs, line))
+    {
+      const std::string::size_type comment = line.find("//");
+      std::string::size_type start = 0, end;
+
+      if (comment != std::string::npos) line.erase(comment);
+      line += ',';
+      while (okay && ((end = line.find(',', start)) != std::string::npos))
+      {
+        token = line.substr(start, end - start); start = end + 1;
+        token.erase(0, token.find_first_not_of(" \t\r"));
+        token.erase(token.find_last_not_of(" \t\r") + 1);
+        if (!token.empty())
+        {
+          char *endptr;
+          const long value = strtol(token.c_str(), &endptr, 10);
+
+          if (*endptr || (value < -32768) || (value > 32767) || (count == epLen)) okay = false;
+          else
+            values[count++] = (si16) value;
+        };
+      };
+    };
+    if (!okay || (count != epLen)) {std::cerr << "Bad evaluation weight file\n"; okay = false;};
+  };
+
+  // Replace the weights only if the whole file is good
+
+  if (okay) for (epType ep = 0; ep < epLen; ep++) parms[ep] = values[ep];
+  return okay;
+}
+#endif
+
+// The evaluation weights from an external file, produced by the "te" (tune evaluation) command
+
+const si16 EPV::defaultparms[epLen] PROGMEM =
+{
+#include "EvalParmCodes"
+};
@@ -0,0 +1,47 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_EPV
+#define Included_EPV
+
+// Evaluation parameter vector class
+//
+// The EPV class holds the weights used by the positional evaluation.  The default
+// weights are kept in flash storage.  On the development host, each instance has a
+// modifiable copy of the weights so that they can be adjusted by the evaluation
+// tuner and so that different searches can use different weights.
+
+class EPV
+{
+  public:
+    EPV(void) {LoadDefaults();}
+    ~EPV(void) {}
+
+    void LoadDefaults(void);
+
+#if (IsDevHost)
+    si16 GetParm(const epType ep) const {return parms[ep];}
+    void PutParm(const epType ep, const si16 value) {parms[ep] = value;}
+
+    bool LoadFromFile(const char *fn);
+#endif
+
+#if (IsTarget)
+    si16 GetParm(const epType ep) const {return ReadFlashSi16(defaultparms + ep);}
+#endif
+
+  private:
+    static const si16 defaultparms[epLen] PROGMEM;
+
+#if (IsDevHost)
+    si16 parms[epLen];
+#endif
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Hash.h"
+#include "PPos.h"
 
 void FPos::Reset(void) {Board::Reset(); FEnv::Reset();}
 
@@ -232,6 +233,17 @@ bool FPos::LoadFromStr(const char *fen)
   return valid;
 }
 
+#if (IsDevHost)
+void FPos::LoadFromPPos(const PPos& ppos)
+{
+  // Load the FEN position from a packed position (already validated when packed)
+
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++) PutMan(sqr, ppos.GetMan(sqr));
+  SetGood(ppos.GetGood()); PutCsab(ppos.GetCsab()); PutEpsq(ppos.GetEpsq());
+  PutHmvc(ppos.GetHmvc()); PutFmvn(ppos.GetFmvn());
+}
+#endif
+
 void FPos::SetInitialArray(void)
 {
   // Set up the initial chess position
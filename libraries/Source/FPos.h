@@ -13,6 +13,7 @@
 // Forward class declaration(s)
 
 class Hash;
+class PPos;
 
 // FEN Position class
 //
@@ -27,6 +28,10 @@ class FPos: public Board, public FEnv
   public:
     bool LoadFromStr(const char *fen);
 
+#if (IsDevHost)
+    void LoadFromPPos(const PPos& ppos);
+#endif
+
     void SetInitialArray(void);
 
     void CalcPosHashWTM(Hash& hash) const;
@@ -16,6 +16,7 @@
 #endif
 
 #include "Hash.h"
+#include "PRF.h"
 #include "History.h"
 
 void History::Reset(void)
@@ -26,6 +27,8 @@ void History::Reset(void)
 
 bool History::ALOneRep(const Hash& hash, const miType backcount) const
 {
+  PRFHook(prfpRepetition);
+
   bool onerep = false;
   miType index = count, checked = 0;
 
@@ -39,6 +42,8 @@ bool History::ALOneRep(const Hash& hash, const miType backcount) const
 
 bool History::ALTwoRep(const Hash& hash, const miType backcount) const
 {
+  PRFHook(prfpRepetition);
+
   bool tworep = false;
   miType index = count, checked = 0, reps = 0;
 
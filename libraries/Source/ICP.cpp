@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -21,17 +22,22 @@
 #include "FPos.h"
 #include "Score.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
-#include "TinyMove.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
@@ -40,6 +46,8 @@
 #include "BB.h"
 #include "CIB.h"
 #include "ICP.h"
+#include "PND.h"
+#include "UCP.h"
 
 void ICP::RetrieveIcpcString(const icpcType icpc, char cv[])
 {
@@ -89,7 +97,7 @@ void ICP::Term(void) const
 {
   // A one time call to terminate the Interactive Command Processor
 
-  PrintFS(fsMsFinished);
+  PrintFS(fsMsFinished); FlushOutput();
 }
 
 void ICP::Loop(void)
@@ -112,9 +120,11 @@ void ICP::SingleCycle(void)
 
   stateptr->ResetInterrupt();
 
-  // Issue a prompt and then read a command line
+  // Issue a prompt and then read a command line; ponder meanwhile if requested
 
-  PrintFS(fsMsPrompt); cib.Load();
+  PrintFS(fsMsPrompt); ponderhit = false;
+  if (IsPonderable()) Ponder(); else cib.Load();
+  stateptr->ResetPonderMove();
 
   // Check for a re-seeding of the pseudorandom number generator
 
@@ -142,44 +152,60 @@ void ICP::SingleCycle(void)
       if (IsIcpcNotNil(icpc)) Dispatch(icpc);
       else
       {
-        // No command verb match; try to handle a user move sequence
+        // No command verb match; check for a switch to the UCI protocol
 
-        if (IsGameOver()) ReportGameOver();
+        if (IsUCIRequest()) RunUCP();
         else
         {
-          // The game is still in progress; loop through the user move strings
+          // Try to handle a user move sequence
 
-          bool valid = true;
-          ui index = 0;
-
-          while (valid && (index < cib.GetTokenCount()))
+          if (IsGameOver()) ReportGameOver();
+          else
           {
-            // Handle a single user move
+            // The game is still in progress; loop through the user move strings
+
+            bool valid = true;
+            ui index = 0;
 
-            Move move;
+            // A ponder hit: the predicted user move is already played and its reply searched
 
-            stateptr->MatchMove(cib.GetToken(index), move);
-            if (move.IsVoid())
+            if (ponderhit)
             {
-              // Couldn't find the move
+              PrintFSL(fsLbYourMove);
+              stateptr->FetchLastMove().Print(stateptr->FetchLastFEnv()); PrintNL();
+              CondShowBoard(); if (IsGameOver()) ReportGameOver();
+              index++;
+            };
 
-              PrintFS(fsUdBadMove); valid = false;
-            }
-            else
+            while (valid && (index < cib.GetTokenCount()))
             {
-              // Found the move; play it
+              // Handle a single user move
 
-              UserMove(move);
+              Move move;
 
-              // Next token
+              stateptr->MatchMove(cib.GetToken(index), move);
+              if (move.IsVoid())
+              {
+                // Couldn't find the move
 
-              index++;
+                PrintFS(fsUdBadMove); valid = false;
+              }
+              else
+              {
+                // Found the move; play it
+
+                UserMove(move);
+
+                // Next token
+
+                index++;
+              };
             };
-          };
 
-          // Optional program reply
+            // Optional program reply
 
-          if (valid && !stateptr->TestOption(optnNR) && !IsGameOver()) ProgMove();
+            if (valid && !stateptr->TestOption(optnNR) && !IsGameOver()) ProgMove();
+          };
         };
       };
 
@@ -217,7 +243,14 @@ void ICP::ShowLimits(void) const
   // Display the time and depth limits
 
   PrintFSL(fsLbTimeLimit); PrintMsecAsSeconds(stateptr->GetLimitMsec()); PrintISM();
-  PrintFSL(fsLbDepthLimit); PrintUi16(stateptr->GetLimitPly()); PrintNL();
+  PrintFSL(fsLbDepthLimit); PrintUi16(stateptr->GetLimitPly());
+#if (IsDevHost)
+  if (stateptr->GetMultiPVCount() > 1)
+  {
+    PrintISM(); PrintFSL(fsLbMultiPV); PrintUi16(stateptr->GetMultiPVCount());
+  };
+#endif
+  PrintNL();
 }
 
 void ICP::ShowMoves(void) const
@@ -231,6 +264,13 @@ void ICP::ShowMoves(void) const
   };
 }
 
+void ICP::ShowNodes(void) const
+{
+  // Display the node count of the last search or movepath enumeration
+
+  PrintFSL(fsLbNodes); stateptr->FetchNodeCounter().Print(); PrintNL();
+}
+
 void ICP::ShowOptions(void) const
 {
   // Display the list of active options
@@ -264,6 +304,55 @@ void ICP::NoParameters(void) const {if (cib.GetTokenCount() > 1) PrintFS(fsUdIgn
 
 bool ICP::IsGameOver(void) const {return stateptr->IsOver();}
 
+bool ICP::IsUCIRequest(void) const
+{
+  // A switch to the UCI protocol is requested by its "uci" command (host only)
+
+#if (IsDevHost)
+  return StrCmp(cib.GetToken(0), "uci") == 0;
+#endif
+
+#if (IsTarget)
+  return false;
+#endif
+}
+
+void ICP::RunUCP(void) const
+{
+  // Run the UCI command processor; the program is done when it returns
+
+#if (IsDevHost)
+  UCP ucp;
+
+  ucp.SetStatePtr(stateptr); ucp.Loop(); stateptr->SetDone();
+#endif
+}
+
+bool ICP::IsPonderable(void) const
+{
+  // Pondering needs the option, a predicted user move, and a game in progress (host only)
+
+#if (IsDevHost)
+  return
+    stateptr->TestOption(optnPN) && stateptr->FetchPonderMove().IsNotVoid() && !IsGameOver();
+#endif
+
+#if (IsTarget)
+  return false;
+#endif
+}
+
+void ICP::Ponder(void)
+{
+  // Ponder on the predicted user move while reading a command line
+
+#if (IsDevHost)
+  PND pnd;
+
+  pnd.SetStatePtr(stateptr); ponderhit = pnd.Run(stateptr->FetchPonderMove(), cib);
+#endif
+}
+
 void ICP::ReportGameOver(void) const {PrintGameOver(stateptr->CalcFT()); PrintNL();}
 
 void ICP::Play(const Move& move) const
@@ -281,11 +370,11 @@ void ICP::ProgMove(void) const
 {
   // Find and play a program move
 
-  Move move;
+  Move move, reply;
 
-  // Find the program move
+  // Find the program move and keep the predicted reply for pondering
 
-  FindMove(move);
+  FindMove(move); reply = stateptr->PVMove(1);
 
   // Conditionally issue audible alert
 
@@ -302,7 +391,7 @@ void ICP::ProgMove(void) const
   // Print and play the program move
 
   PrintFSL(fsLbMyMove); move.Print(stateptr->FetchSearchFEnv()); PrintNL();
-  Play(move);
+  Play(move); stateptr->PutPonderMove(reply);
 }
 
 void ICP::UserMove(const Move& move) const
@@ -320,7 +409,10 @@ void ICP::FindMove(Move& move) const
   if (IsGameOver()) move.MakeVoid();
   else
   {
-    stateptr->RunABSearch(); move = stateptr->PVMove(0);
+    // A ponder hit has already searched the position
+
+    if (!ponderhit || stateptr->PVMove(0).IsVoid()) stateptr->RunABSearch();
+    move = stateptr->PVMove(0);
   };
 }
 
@@ -41,6 +41,7 @@ class ICP
     void ShowFEN(void) const;
     void ShowLimits(void) const;
     void ShowMoves(void) const;
+    void ShowNodes(void) const;
     void ShowOptions(void) const;
     void ShowPosHash(void) const;
 
@@ -52,6 +53,12 @@ class ICP
 
     void ReportGameOver(void) const;
 
+    bool IsPonderable(void) const;
+    void Ponder(void);
+
+    bool IsUCIRequest(void) const;
+    void RunUCP(void) const;
+
     void Play(const Move& move) const;
 
     void ProgMove(void) const;
@@ -65,13 +72,17 @@ class ICP
 
     void DcAT(void) const; // Activate common trace options
     void DcBB(void) const; // Build book
+    void DcBN(void) const; // Bench
+    void DcCP(void) const; // Convert positions
     void DcDB(void) const; // Display board
     void DcDF(void) const; // Display FEN
     void DcDH(void) const; // Display position hash
     void DcDL(void) const; // Display opening library moves
     void DcDM(void) const; // Display moves
     void DcDO(void) const; // Display options
+    void DcDP(void) const; // Display profile
     void DcDS(void) const; // Display status
+    void DcDT(void) const; // Display trace ring
     void DcEM(void) const; // Enumerate movepaths
     void DcFM(void) const; // Fast enumerate movepaths
     void DcFP(void) const; // Flip position
@@ -80,21 +91,30 @@ class ICP
     void DcGS(void) const; // Go search
     void DcHM(void) const; // Help me
     void DcID(void) const; // Show program identification
+    void DcLN(void) const; // Load network
     void DcNG(void) const; // New game
+    void DcPM(void) const; // Play match
     void DcPT(void) const; // Program test
     void DcQP(void) const; // Quit program
     void DcRO(void) const; // Reset option(s)
     void DcRP(void) const; // Reset program
+    void DcRS(void) const; // Run test suite
     void DcSD(void) const; // Set depth limit
     void DcSF(void) const; // Set FEN
+    void DcSM(void) const; // Set multi-PV count
     void DcSO(void) const; // Set option(s)
     void DcST(void) const; // Set time limit
+    void DcSY(void) const; // Set tablebase directory
     void DcTB(void) const; // Take back move
+    void DcTE(void) const; // Tune evaluation
+    void DcTJ(void) const; // Trace JSON stream
+    void DcTO(void) const; // Trace output
 
     void Test(void) const;
 
     State *stateptr;
     CIB cib;
+    bool ponderhit;
 };
 
 #endif
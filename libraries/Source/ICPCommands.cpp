@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -21,23 +22,35 @@
 #include "FPos.h"
 #include "Score.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
-#include "TinyMove.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
+#include "PRF.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
 #include "Search.h"
 #include "State.h"
 #include "BB.h"
+#include "BPL.h"
+#include "EPT.h"
+#include "TBP.h"
+#include "TSR.h"
+#include "BCH.h"
+#include "SPM.h"
+#include "STS.h"
 #include "CIB.h"
 #include "ICP.h"
 
@@ -47,13 +60,17 @@ void ICP::Dispatch(const icpcType icpc) const
   {
     case icpcAT: DcAT(); break; // Activate common trace options
     case icpcBB: DcBB(); break; // Build book
+    case icpcBN: DcBN(); break; // Bench
+    case icpcCP: DcCP(); break; // Convert positions
     case icpcDB: DcDB(); break; // Display board
     case icpcDF: DcDF(); break; // Display FEN
     case icpcDH: DcDH(); break; // Display position hash
     case icpcDL: DcDL(); break; // Display opening library moves
     case icpcDM: DcDM(); break; // Display moves
     case icpcDO: DcDO(); break; // Display options
+    case icpcDP: DcDP(); break; // Display profile
     case icpcDS: DcDS(); break; // Display status
+    case icpcDT: DcDT(); break; // Display trace ring
     case icpcEM: DcEM(); break; // Enumerate movepaths
     case icpcFM: DcFM(); break; // Fast enumerate movepaths
     case icpcFP: DcFP(); break; // Flip position
@@ -62,16 +79,24 @@ void ICP::Dispatch(const icpcType icpc) const
     case icpcGS: DcGS(); break; // Go search
     case icpcHM: DcHM(); break; // Help me
     case icpcID: DcID(); break; // Show program identification
+    case icpcLN: DcLN(); break; // Load network
     case icpcNG: DcNG(); break; // New game
+    case icpcPM: DcPM(); break; // Play match
     case icpcPT: DcPT(); break; // Program test
     case icpcQP: DcQP(); break; // Quit program
     case icpcRO: DcRO(); break; // Reset option(s)
     case icpcRP: DcRP(); break; // Reset program
+    case icpcRS: DcRS(); break; // Run test suite
     case icpcSD: DcSD(); break; // Set depth limit
     case icpcSF: DcSF(); break; // Set FEN
+    case icpcSM: DcSM(); break; // Set multi-PV count
     case icpcSO: DcSO(); break; // Set option(s)
     case icpcST: DcST(); break; // Set time limit
+    case icpcSY: DcSY(); break; // Set tablebase directory
     case icpcTB: DcTB(); break; // Take back move
+    case icpcTE: DcTE(); break; // Tune evaluation
+    case icpcTJ: DcTJ(); break; // Trace JSON stream
+    case icpcTO: DcTO(); break; // Trace output
     default: SwitchFault(); break;
   };
 }
@@ -108,6 +133,67 @@ void ICP::DcBB(void) const
 #endif
 }
 
+void ICP::DcBN(void) const
+{
+  // Bench [p] [<depth> [<threads>]]
+
+#if (IsDevHost)
+  const ui tokencount = cib.GetTokenCount();
+  const bool perft = (tokencount > 1) && (StrCmp(cib.GetToken(1), "p") == 0);
+  const ui firstindex = perft ? 2 : 1;
+
+  if (tokencount > (firstindex + 2)) PrintFS(fsUdBadParmCount);
+  else
+  {
+    bool valid = true;
+
+    for (ui index = firstindex; valid && (index < tokencount); index++)
+      if (!IsStrUnsignedInt(cib.GetToken(index))) valid = false;
+    if (valid && (tokencount > firstindex) &&
+      (MapStrToUi32(cib.GetToken(firstindex)) > MaxPlyLen)) valid = false;
+
+    // No more threads than bench positions; any more would have nothing to run
+
+    if (valid && (tokencount > (firstindex + 1)) &&
+      (MapStrToUi32(cib.GetToken(firstindex + 1)) > BCH::GetPositionCount())) valid = false;
+    if (!valid) PrintFS(fsUdBadParmValue);
+    else
+    {
+      const plyType limitply =
+        (tokencount > firstindex) ? (plyType) MapStrToUi32(cib.GetToken(firstindex)) : 0;
+      const ui threadcount =
+        (tokencount > (firstindex + 1)) ? (ui) MapStrToUi32(cib.GetToken(firstindex + 1)) : 1;
+      BCH bch;
+
+      FlushOutput(); bch.RunBench(perft, limitply, threadcount);
+    };
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
+void ICP::DcCP(void) const
+{
+  // Convert positions <input-position-file> <output-position-file>
+
+#if (IsDevHost)
+  if (cib.GetTokenCount() != 3) PrintFS(fsUdBadParmCount);
+  else
+  {
+    BPL bpl;
+
+    bpl.ConvertFile(cib.GetToken(1), cib.GetToken(2));
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcDB(void) const
 {
   // Display board
@@ -150,6 +236,21 @@ void ICP::DcDO(void) const
   NoParameters(); ShowOptions();
 }
 
+void ICP::DcDP(void) const
+{
+  // Display and reset profile
+
+  NoParameters();
+
+#if (UseProfiler)
+  PRF::Print(); PRF::Reset();
+#endif
+
+#if (!UseProfiler)
+  PrintFS(fsUdNoProfiler);
+#endif
+}
+
 void ICP::DcDS(void) const
 {
   // Display status
@@ -158,6 +259,21 @@ void ICP::DcDS(void) const
   ShowBoard(); ShowMoves(); ShowLimits(); ShowOptions(); ShowFEN(); ShowPosHash();
 }
 
+void ICP::DcDT(void) const
+{
+  // Display trace ring
+
+  NoParameters();
+
+#if (IsDevHost)
+  PrintTraceRing();
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcEM(void) const
 {
   // Enumerate movepaths
@@ -173,7 +289,7 @@ void ICP::DcEM(void) const
       plyType plies = MapStrToUi32(cptr);
 
       if (plies > MaxPlyLen) plies = MaxPlyLen;
-      stateptr->RunMP(plies, false);
+      stateptr->RunMP(plies, false); ShowNodes();
     };
   };
 }
@@ -193,7 +309,7 @@ void ICP::DcFM(void) const
       plyType plies = MapStrToUi32(cptr);
 
       if (plies > MaxPlyLen) plies = MaxPlyLen;
-      stateptr->RunMP(plies, true);
+      stateptr->RunMP(plies, true); ShowNodes();
     };
   };
 }
@@ -257,6 +373,23 @@ void ICP::DcID(void) const
   NoParameters(); PrintProgID();
 }
 
+void ICP::DcLN(void) const
+{
+  // Load network <input-network-file>
+
+#if (IsDevHost)
+  if (cib.GetTokenCount() != 2) PrintFS(fsUdBadParmCount);
+  else
+  {
+    if (!stateptr->LoadNetwork(cib.GetToken(1))) PrintFS(fsUdCantLoadNetwork);
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcNG(void) const
 {
   // New game
@@ -264,6 +397,40 @@ void ICP::DcNG(void) const
   NoParameters(); stateptr->NewGame(); CondShowBoard();
 }
 
+void ICP::DcPM(void) const
+{
+  // Play match <games> <config-a> <config-b> <output-pgn-file> [<node-limit> [<file>]]
+  //
+  // A configuration is "-" or a list of e=<eval-weight-file>, n=<network-file>, and
+  // t=<tablebase-directory> items separated by commas; the optional file has the openings
+
+#if (IsDevHost)
+  const ui tokencount = cib.GetTokenCount();
+
+  if ((tokencount < 5) || (tokencount > 7)) PrintFS(fsUdBadParmCount);
+  else
+  {
+    if (!IsStrUnsignedInt(cib.GetToken(1)) || (MapStrToUi32(cib.GetToken(1)) == 0) ||
+      ((tokencount > 5) && !IsStrUnsignedInt(cib.GetToken(5))))
+      PrintFS(fsUdBadParmValue);
+    else
+    {
+      const ui32 limitnodes = (tokencount > 5) ? MapStrToUi32(cib.GetToken(5)) : 0;
+      SPM spm;
+
+      FlushOutput();
+      spm.RunMatch(
+        stateptr, MapStrToUi32(cib.GetToken(1)), cib.GetToken(2), cib.GetToken(3),
+        cib.GetToken(4), limitnodes, (tokencount > 6) ? cib.GetToken(6) : 0);
+    };
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcPT(void) const
 {
   // Program test
@@ -307,6 +474,32 @@ void ICP::DcRP(void) const
   stateptr->ResetOptions(); stateptr->SetDefaultLimits(); stateptr->NewGame();
 }
 
+void ICP::DcRS(void) const
+{
+  // Run test suite <input-position-file> [<node-limit>]
+
+#if (IsDevHost)
+  const ui tokencount = cib.GetTokenCount();
+
+  if ((tokencount < 2) || (tokencount > 3)) PrintFS(fsUdBadParmCount);
+  else
+  {
+    if ((tokencount == 3) && !IsStrUnsignedInt(cib.GetToken(2))) PrintFS(fsUdBadParmValue);
+    else
+    {
+      const ui32 limitnodes = (tokencount == 3) ? MapStrToUi32(cib.GetToken(2)) : 0;
+      TSR tsr;
+
+      FlushOutput(); tsr.RunSuite(stateptr, cib.GetToken(1), limitnodes);
+    };
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcSD(void) const
 {
   // Set depth limit
@@ -361,6 +554,33 @@ void ICP::DcSF(void) const
   };
 }
 
+void ICP::DcSM(void) const
+{
+  // Set multi-PV count; the UCI protocol search information option shows the ranks
+
+#if (IsDevHost)
+  if (cib.GetTokenCount() != (1 + 1)) PrintFS(fsUdNeedSingleUIParm);
+  else
+  {
+    const char *cptr = cib.GetToken(1);
+
+    if (!IsStrUnsignedInt(cptr)) PrintFS(fsUdBadParmValue);
+    else
+    {
+      ui count = MapStrToUi32(cptr);
+
+      if (count < 1) count = 1;
+      if (count > MultiPVLen) count = MultiPVLen;
+      stateptr->PutMultiPVCount(count); ShowLimits();
+    };
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcSO(void) const
 {
   // Set option(s)
@@ -403,6 +623,31 @@ void ICP::DcST(void) const
   };
 }
 
+void ICP::DcSY(void) const
+{
+  // Set tablebase directory <directory> [<men-limit>]
+
+#if (IsDevHost)
+  const ui tokencount = cib.GetTokenCount();
+
+  if ((tokencount < 2) || (tokencount > 3)) PrintFS(fsUdBadParmCount);
+  else
+  {
+    if ((tokencount == 3) && !IsStrUnsignedInt(cib.GetToken(2))) PrintFS(fsUdBadParmValue);
+    else
+    {
+      const ui limit = (tokencount == 3) ? (ui) MapStrToUi32(cib.GetToken(2)) : tbpMenLen;
+
+      if (!stateptr->LoadTablebases(cib.GetToken(1), limit)) PrintFS(fsUdCantLoadTables);
+    };
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
 void ICP::DcTB(void) const
 {
   // Take back move
@@ -418,3 +663,62 @@ void ICP::DcTB(void) const
     CondShowBoard();
   };
 }
+
+void ICP::DcTE(void) const
+{
+  // Tune evaluation <input-position-file> <output-code-file>
+
+#if (IsDevHost)
+  if (cib.GetTokenCount() != 3) PrintFS(fsUdBadParmCount);
+  else
+  {
+    EPT ept;
+
+    ept.TuneEval(stateptr, cib.GetToken(1), cib.GetToken(2));
+  };
+#endif
+
+#if (IsTarget)
+  PrintFS(fsUdDevHostOnly);
+#endif
+}
+
+void ICP::DcTJ(void) const
+{
+  // Trace JSON stream <[output-json-file]>
+
+  if (cib.GetTokenCount() > 2) PrintFS(fsUdBadParmCount);
+  else
+  {
+#if (IsDevHost)
+    if (cib.GetTokenCount() == 1) STS::Close(); else STS::Open(cib.GetToken(1));
+#endif
+
+#if (IsTarget)
+    if (cib.GetTokenCount() == 2) PrintFS(fsUdDevHostOnly);
+#endif
+  };
+}
+
+void ICP::DcTO(void) const
+{
+  // Trace output <[output-trace-file | *]>
+
+  if (cib.GetTokenCount() > 2) PrintFS(fsUdBadParmCount);
+  else
+  {
+#if (IsDevHost)
+    if (cib.GetTokenCount() == 1) RouteTraceOutput(tdConsole, 0);
+    else
+    {
+      if (StrCmp(cib.GetToken(1), "*") == 0) RouteTraceOutput(tdRing, 0);
+      else
+        RouteTraceOutput(tdFile, cib.GetToken(1));
+    };
+#endif
+
+#if (IsTarget)
+    if (cib.GetTokenCount() == 2) PrintFS(fsUdDevHostOnly);
+#endif
+  };
+}
@@ -0,0 +1,187 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <mutex>
+#endif
+
+#if (IsDevHost)
+
+#include "KPK.h"
+
+ui8 KPK::winbits[kpkByteLen];
+
+// The bitbase is built once, by whichever thread first probes it
+
+static std::once_flag kpkbuildflag;
+
+static bool IsAdjacent(const sqrType sqr0, const sqrType sqr1)
+{
+  // Are two distinct squares a king step apart?
+
+  const si filedelta = MapSqrToFile(sqr0) - MapSqrToFile(sqr1);
+  const si rankdelta = MapSqrToRank(sqr0) - MapSqrToRank(sqr1);
+
+  return
+    (sqr0 != sqr1) && (filedelta >= -1) && (filedelta <= 1) &&
+    (rankdelta >= -1) && (rankdelta <= 1);
+}
+
+static bool IsPawnAttack(const sqrType psqr, const sqrType sqr)
+{
+  // Does a White pawn attack a square?
+
+  const si filedelta = MapSqrToFile(sqr) - MapSqrToFile(psqr);
+
+  return
+    (MapSqrToRank(sqr) == (MapSqrToRank(psqr) + 1)) && ((filedelta == -1) || (filedelta == 1));
+}
+
+static ui CalcKingSteps(const sqrType sqr, sqrType stepsqrs[])
+{
+  // Collect the on board squares a king step away from a square; return the count
+
+  const si file = MapSqrToFile(sqr), rank = MapSqrToRank(sqr);
+  ui count = 0;
+
+  for (si rankdelta = -1; rankdelta <= 1; rankdelta++)
+    for (si filedelta = -1; filedelta <= 1; filedelta++)
+    {
+      const si tofile = file + filedelta, torank = rank + rankdelta;
+
+      if (
+          (filedelta || rankdelta) &&
+          (tofile >= fileA) && (tofile <= fileH) && (torank >= rank1) && (torank <= rank8))
+        stepsqrs[count++] = MapFileRankToSqr((fileType) tofile, (rankType) torank);
+    };
+  return count;
+}
+
+ui32 KPK::CalcIndex(const bool wtm, const sqrType wksqr, const sqrType bksqr, const sqrType psqr)
+{
+  // Calculate the bitbase index; the pawn is mirrored onto files a-d as needed
+
+  const ui mirror = (MapSqrToFile(psqr) > fileD) ? 0x07 : 0x00;
+  const ui pawnsqr = psqr ^ mirror;
+  const ui pawnindex = ((MapSqrToRank(pawnsqr) - rank2) * 4) + MapSqrToFile(pawnsqr);
+
+  return
+    (((((ui32) pawnindex * sqrLen) + (wksqr ^ mirror)) * sqrLen) + (bksqr ^ mirror)) *
+      colorRLen + (wtm ? 0 : 1);
+}
+
+bool KPK::IsWin(const bool wtm, const sqrType wksqr, const sqrType bksqr, const sqrType psqr)
+{
+  // Probe the bitbase, building it first if needed; White is the pawn side
+
+  std::call_once(kpkbuildflag, Build);
+
+  return TestIndex(CalcIndex(wtm, wksqr, bksqr, psqr));
+}
+
+void KPK::Build(void)
+{
+  // Build the bitbase by retrograde analysis; the win bits are the only analysis state
+
+  for (ui index = 0; index < kpkByteLen; index++) winbits[index] = 0;
+
+  // Mark wins found with the current win bits until a pass finds no more
+
+  bool changed = true;
+
+  while (changed)
+  {
+    changed = false;
+    for (ui32 index = 0; index < kpkLen; index++)
+    {
+      const bool wtm = (index % colorRLen) == 0;
+      const sqrType bksqr = (sqrType) ((index / colorRLen) % sqrLen);
+      const sqrType wksqr = (sqrType) ((index / (colorRLen * sqrLen)) % sqrLen);
+      const ui pawnindex = index / (colorRLen * sqrLen * sqrLen);
+      const rankType prank = (rankType) (rank2 + (pawnindex / 4));
+      const sqrType psqr = MapFileRankToSqr((fileType) (pawnindex % 4), prank);
+
+      // Skip known wins and invalid positions: overlaps, touching kings, Black king in
+      // check with White to move
+
+      if (
+          !TestIndex(index) &&
+          (wksqr != bksqr) && (wksqr != psqr) && (bksqr != psqr) &&
+          !IsAdjacent(wksqr, bksqr) && !(wtm && IsPawnAttack(psqr, bksqr)))
+      {
+        sqrType stepsqrs[8];
+        bool iswin;
+
+        if (wtm)
+        {
+          // White needs one winning move; only a queen promotion not lost at once counts
+
+          const sqrType onesqr = MapFileRankToSqr(MapSqrToFile(psqr), (rankType) (prank + 1));
+
+          iswin = false;
+          if ((onesqr != wksqr) && (onesqr != bksqr))
+          {
+            if (prank == rank7) iswin = !IsAdjacent(bksqr, onesqr) || IsAdjacent(wksqr, onesqr);
+            else
+            {
+              iswin = TestIndex(CalcIndex(false, wksqr, bksqr, onesqr));
+              if (!iswin && (prank == rank2))
+              {
+                const sqrType twosqr =
+                  MapFileRankToSqr(MapSqrToFile(psqr), (rankType) (prank + 2));
+
+                if ((twosqr != wksqr) && (twosqr != bksqr))
+                  iswin = TestIndex(CalcIndex(false, wksqr, bksqr, twosqr));
+              };
+            };
+          };
+
+          const ui count = CalcKingSteps(wksqr, stepsqrs);
+
+          for (ui stepindex = 0; !iswin && (stepindex < count); stepindex++)
+          {
+            const sqrType tosqr = stepsqrs[stepindex];
+
+            if ((tosqr != psqr) && !IsAdjacent(tosqr, bksqr))
+              iswin = TestIndex(CalcIndex(false, tosqr, bksqr, psqr));
+          };
+        }
+        else
+        {
+          // Black needs one drawing move; capturing the pawn draws, and having no moves is
+          // either a checkmate or a stalemate
+
+          const ui count = CalcKingSteps(bksqr, stepsqrs);
+          ui movecount = 0;
+
+          iswin = true;
+          for (ui stepindex = 0; iswin && (stepindex < count); stepindex++)
+          {
+            const sqrType tosqr = stepsqrs[stepindex];
+
+            if (!IsAdjacent(tosqr, wksqr) && !IsPawnAttack(psqr, tosqr))
+            {
+              movecount++;
+              iswin = (tosqr != psqr) && TestIndex(CalcIndex(true, wksqr, tosqr, psqr));
+            };
+          };
+          if (!movecount) iswin = IsPawnAttack(psqr, bksqr);
+        };
+
+        if (iswin) {winbits[index / bytebitLen] |= BX(index % bytebitLen); changed = true;};
+      };
+    };
+  };
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_KPK
+#define Included_KPK
+
+#if (IsDevHost)
+
+// KPK bitbase index count: side to move, pawn square (files a-d, ranks 2-7), king squares
+
+#define kpkPawnSqrLen 24
+#define kpkLen        (colorRLen * kpkPawnSqrLen * sqrLen * sqrLen) // 196,608
+#define kpkByteLen    (kpkLen / bytebitLen)
+
+// King and pawn versus king bitbase class; only statics, no instances
+//
+// The bitbase records which king and pawn versus king positions are won for the pawn
+// side.  It is built on the first probe by retrograde analysis working directly on the
+// square indices, so programs that never reach such an endgame never pay for it.  White
+// is the pawn side; the caller flips the squares for Black.
+
+class KPK
+{
+  public:
+    static bool IsWin(
+      const bool wtm, const sqrType wksqr, const sqrType bksqr, const sqrType psqr);
+
+  private:
+    static void Build(void);
+
+    static ui32 CalcIndex(
+      const bool wtm, const sqrType wksqr, const sqrType bksqr, const sqrType psqr);
+
+    static bool TestIndex(const ui32 index)
+    {
+      return winbits[index / bytebitLen] & BX(index % bytebitLen);
+    }
+
+    static ui8 winbits[kpkByteLen];
+};
+
+#endif
+
+#endif
@@ -27,9 +27,7 @@ typedef enum
   psFullKiller,
   psFullKillerPM2,
   psFullHoldSeqInit,
-  psFullHoldSeqPieceTBV,
-  psFullHoldSeqPieceTid,
-  psFullHoldSeqPieceMove,
+  psFullHoldSeqMove,
   psGainInit,
   psGainPV,
   psGainNext,
@@ -71,6 +69,14 @@ class MGS
     ui8 GetUsedCount(void) const {return usedcount;}
     ui8 NextBaseMoveIndex(void) {return usedcount++;}
 
+    void ResetPicker(void) {pickindex = 0; picksorted = false;}
+
+    ui8 GetPickIndex(void) const {return pickindex;}
+    void PutPickIndex(const ui8 value) {pickindex = value;}
+
+    bool IsPickSorted(void) const {return picksorted;}
+    void SetPickSorted(void) {picksorted = true;}
+
     void ResetAvoidPV(void) {mgafm &= ~mgafmPV;}
     void SetAvoidPV(void) {mgafm |= mgafmPV;}
     bool AvoidPV(void) const {return mgafm & mgafmPV;}
@@ -83,23 +89,19 @@ class MGS
     void SetAvoidKillerPM2(void) {mgafm |= mgafmKillerPM2;}
     bool AvoidKillerPM2(void) const {return mgafm & mgafmKillerPM2;}
 
-    pieceType GetPiece(void) const {return piece;}
-    void PutPiece(const pieceType value) {piece = value;}
-    void IncPiece(void) {piece++;}
-
-    TBV& RefGoodTBV(void) {return goodtbv;}
+    bool AvoidAny(void) const {return mgafm != 0;}
 
   private:
     psType ps;
     ui8 usedcount;
-    pieceType piece;
+    ui8 pickindex;
+    bool picksorted;
     mgafmType mgafm;
-    TBV goodtbv;
 };
 
 inline void MGS::Reset(void)
 {
-  ps = psNil; usedcount = 0; mgafm = 0; piece = piecePawn; goodtbv.Reset();
+  ps = psNil; usedcount = 0; ResetPicker(); mgafm = 0;
 }
 
 inline void MGS::InitTrack(const abnType abn)
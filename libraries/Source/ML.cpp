@@ -19,31 +19,78 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "SAN.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
-void ML::MarkChecksAndCheckmates(Pos &pos) const
+void ML::Relocate(TinyMove tinymoves[], svType svs[], mfmType mfms[], const miType length)
 {
-  // Add move flags for checks and checkmates as appropriate
+  // Move the list to new storage; the current entries are copied
 
   for (miType index = 0; index < count; index++)
   {
-    FEnv fenv;
-    tidType capttid;
-    PEnv penv;
+    tinymoves[index] = tmptr[index]; svs[index] = svptr[index]; mfms[index] = mfmptr[index];
+  };
+  tmptr = tinymoves; svptr = svs; mfmptr = mfms; limit = length;
+}
 
-    pos.Execute(FetchMove(index), fenv, capttid, penv);
-    if (pos.InCheck())
-    {
-      RefMove(index).SetFlagM(mfmChck);
-      if (pos.NoMoves()) RefMove(index).SetFlagM(mfmMate);
-    };
-    pos.Retract(FetchMove(index), fenv, capttid, penv);
+void ML::Rotate(const miType first, const miType last) const
+{
+  // Move the entry at the last index to the first index; the entries between move up one
+
+  const TinyMove tinymove = tmptr[last];
+  const svType sv = svptr[last];
+  const mfmType mfm = mfmptr[last];
+
+  for (miType index = last; index > first; index--)
+  {
+    tmptr[index] = tmptr[index - 1]; svptr[index] = svptr[index - 1];
+    mfmptr[index] = mfmptr[index - 1];
   };
+  tmptr[first] = tinymove; svptr[first] = sv; mfmptr[first] = mfm;
+}
+
+void ML::PushFull(const Move& move)
+{
+  // Push onto a full list: a move stack list is extended if possible, else the move is
+  // dropped; a standalone list is fatal
+
+  if (!msptr) DieFS(fsFeOverflowMS);
+  else
+  {
+    if (msptr->Extend(*this)) StoreMove(count++, move);
+  };
+}
+
+void ML::MarkCheckAndCheckmate(Pos &pos, const miType index) const
+{
+  // Add move flags for check and checkmate as appropriate to a single move
+
+  const Move move = FetchMove(index);
+  FEnv fenv;
+  tidType capttid;
+  PEnv penv;
+
+  pos.Execute(move, fenv, capttid, penv);
+  if (pos.InCheck())
+  {
+    SetFlagM(index, mfmChck);
+    if (pos.NoMoves()) SetFlagM(index, mfmMate);
+  };
+  pos.Retract(move, fenv, capttid, penv);
+}
+
+void ML::MarkChecksAndCheckmates(Pos &pos) const
+{
+  // Add move flags for checks and checkmates as appropriate
+
+  for (miType index = 0; index < count; index++) MarkCheckAndCheckmate(pos, index);
 }
 
 void ML::MarkDisambiguation(const Pos& pos) const
@@ -55,13 +102,13 @@ void ML::MarkDisambiguation(const Pos& pos) const
   // Initialize the destination square census vector
 
   for (sqrType sqr = 0; sqr < sqrLen; sqr++) tosqrcount[sqr] = 0;
-  for (miType index = 0; index < count; index++) tosqrcount[FetchMove(index).GetToSqr()]++;
+  for (miType index = 0; index < count; index++) tosqrcount[tmptr[index].GetToSqr()]++;
 
   // Run the outer move loop
 
   for (miType index0 = 0; index0 < count; index0++)
   {
-    const manType frman = FetchMove(index0).GetFrMan();
+    const manType frman = GetFrMan(index0);
 
     // Only certain piece kinds may need disambiguation
 
@@ -80,7 +127,7 @@ void ML::MarkDisambiguation(const Pos& pos) const
 
         if (pos.GetManCountByMan(frman) > 1)
         {
-          const sqrType tosqr = FetchMove(index0).GetToSqr();
+          const sqrType tosqr = tmptr[index0].GetToSqr();
 
           // Is there more than one piece moving to the destination square?
 
@@ -88,7 +135,7 @@ void ML::MarkDisambiguation(const Pos& pos) const
           {
             // Prepare to run the inner move loop to find possible tosqr/frman matches
 
-            const sqrType frsqr = FetchMove(index0).GetFrSqr();
+            const sqrType frsqr = tmptr[index0].GetFrSqr();
             const fileType frfile = MapSqrToFile(frsqr);
             const rankType frrank = MapSqrToRank(frsqr);
             ui frmantosqrmc = 0, frfilemc = 0, frrankmc = 0;
@@ -99,12 +146,11 @@ void ML::MarkDisambiguation(const Pos& pos) const
             {
               // Check for a tosqr/frman match
 
-              if ((FetchMove(index1).GetToSqr() == tosqr) &&
-                (FetchMove(index1).GetFrMan() == frman))
+              if ((tmptr[index1].GetToSqr() == tosqr) && (GetFrMan(index1) == frman))
               {
                 // Count from-file/from-rank matches
 
-                const sqrType auxfrsqr = FetchMove(index1).GetFrSqr();
+                const sqrType auxfrsqr = tmptr[index1].GetFrSqr();
 
                 frmantosqrmc++;
                 if (MapSqrToFile(auxfrsqr) == frfile) frfilemc++;
@@ -119,8 +165,8 @@ void ML::MarkDisambiguation(const Pos& pos) const
               // File disambiguation has priority, but may need rank or both file and rank
 
               if ((frrankmc > 1) || ((frrankmc == 1) && (frfilemc == 1)))
-                RefMove(index0).SetFlagM(mfmAdaf);
-              if (frfilemc > 1) RefMove(index0).SetFlagM(mfmAdar);
+                SetFlagM(index0, mfmAdaf);
+              if (frfilemc > 1) SetFlagM(index0, mfmAdar);
             };
           };
         };
@@ -158,12 +204,7 @@ void ML::SortBySAN(void) const
         const miType index1 = index0 + 1;
         const SAN m0san(FetchMove(index0)), m1san(FetchMove(index1));
 
-        if (StrCmp(m0san.FetchStr(), m1san.FetchStr()) > 0)
-        {
-          const Move tmpmove = FetchMove(index0);
-
-          RefMove(index0) = FetchMove(index1); RefMove(index1) = tmpmove; swap = true;
-        };
+        if (StrCmp(m0san.FetchStr(), m1san.FetchStr()) > 0) {Rotate(index0, index1); swap = true;};
       };
       pass++;
     };
@@ -172,37 +213,51 @@ void ML::SortBySAN(void) const
 
 void ML::SortBySv(void) const
 {
-  // Order moves by descending score value; a simple bubble sort works well here
+  // Order moves by descending score value (ties by moving man); a stable insertion sort
 
-  if (count > 1)
+  for (miType index = 1; index < count; index++)
   {
-    const miType passlimit = count - 1;
-    miType pass = 0;
-    bool swap = true;
-
-    while (swap && (pass < passlimit))
-    {
-      const miType pairlimit = passlimit - pass;
+    const svType sv = svptr[index];
+    const manType frman = GetFrMan(index);
+    miType slot = index;
+
+    while ((slot > 0) &&
+      ((sv > svptr[slot - 1]) || ((sv == svptr[slot - 1]) && (frman < GetFrMan(slot - 1)))))
+      slot--;
+    Rotate(slot, index);
+  };
+}
 
-      swap = false;
-      for (miType index0 = 0; index0 < pairlimit; index0++)
-      {
-        const miType index1 = index0 + 1;
-        const svType sv0 = FetchMove(index0).GetSv(), sv1 = FetchMove(index1).GetSv();
+void ML::SortUnsearchedBySv(const miType first) const
+{
+  // Order the moves from the given index by descending score value; a stable insertion sort
+  // gives the unsearched moves in the same order as repeated best move selection
 
-        if ((sv1 > sv0) ||
-          ((sv1 == sv0) && (FetchMove(index1).GetFrMan() < FetchMove(index0).GetFrMan())))
-        {
-          const Move tmpmove = FetchMove(index0);
+  for (miType index = first + 1; index < count; index++)
+  {
+    const svType sv = svptr[index];
+    miType slot = index;
 
-          RefMove(index0) = FetchMove(index1); RefMove(index1) = tmpmove; swap = true;
-        };
-      };
-      pass++;
-    };
+    while ((slot > first) && (sv > svptr[slot - 1])) slot--;
+    Rotate(slot, index);
   };
 }
 
+miType ML::SelectBestUnsearched(const miType first) const
+{
+  // Move the first highest scored unsearched move at or after the given index to that index;
+  // the other moves keep their relative order.  Return the index, or -1 if none remain.
+
+  miType pick = -1;
+  svType picksv = svBroken;
+
+  for (miType index = first; index < count; index++)
+    if (!IsSearched(index) && (svptr[index] > picksv)) {picksv = svptr[index]; pick = index;};
+
+  if (pick >= 0) {Rotate(first, pick); pick = first;};
+  return pick;
+}
+
 miType ML::LocateNoFail(const Move& move) const
 {
   // Return the index of the given move; signal a fatal error if the move is not found
@@ -213,18 +268,49 @@ miType ML::LocateNoFail(const Move& move) const
   return match;
 }
 
-void ML::MatchMove(const char *str, Move& move) const
+void ML::MatchMove(const char *str, Move& move, Pos& pos) const
 {
-  // Return the move of the given SAN move string; return void move if the move is not found
+  // Return the move of the given SAN move string; return void move if the move is not found.
+  // The list needs only disambiguation marking; the check/checkmate marking is applied only
+  // to the one move whose SAN matches the string apart from any check suffix
 
-  miType index = 0;
+  const ui length = StrLen(str);
 
   move.MakeVoid();
-  while (move.IsVoid() && (index < count))
+  if (length < sanLen)
   {
-    const SAN san(FetchMove(index));
+    char basestr[sanLen];
+    ui baselength = length;
+    miType index = 0;
+    bool found = false;
 
-    if (StrCmp(str, san.FetchStr()) == 0) move = FetchMove(index); else index++;
+    // Make a copy of the string without any check/checkmate suffix
+
+    for (ui offset = 0; offset <= length; offset++) basestr[offset] = str[offset];
+    if ((baselength > 0) && ((str[baselength - 1] == '+') || (str[baselength - 1] == '#')))
+    {
+      baselength--; basestr[baselength] = '\0';
+    };
+
+    // Scan for the move with the suffix free SAN match
+
+    while (!found && (index < count))
+    {
+      const SAN basesan(FetchMove(index));
+
+      if (StrCmp(basestr, basesan.FetchStr()) == 0) found = true; else index++;
+    };
+
+    // Mark the candidate and require an exact match
+
+    if (found)
+    {
+      MarkCheckAndCheckmate(pos, index);
+
+      const SAN san(FetchMove(index));
+
+      if (StrCmp(str, san.FetchStr()) == 0) move = FetchMove(index);
+    };
   };
 }
 
@@ -232,7 +318,7 @@ void ML::ClearSearchFlags(void) const
 {
   // Clear the "has been searched" flag in all the moves
 
-  for (miType index = 0; index < count; index++) RefMove(index).ResetFlagM(mfmSrch);
+  for (miType index = 0; index < count; index++) ResetFlagM(index, mfmSrch);
 }
 
 miType ML::FindBestCertainIndex(void) const
@@ -244,10 +330,7 @@ miType ML::FindBestCertainIndex(void) const
 
   for (miType index = 0; index < count; index++)
   {
-    if (FetchMove(index).IsCertain() && (FetchMove(index).GetSv() > bestsv))
-    {
-      bestindex = index; bestsv = FetchMove(index).GetSv();
-    };
+    if (IsCertain(index) && (svptr[index] > bestsv)) {bestindex = index; bestsv = svptr[index];};
   };
   return bestindex;
 }
@@ -260,7 +343,7 @@ bool ML::AllScoresCertain(void) const
   miType index = 0;
 
   while (allcertain && (index < count))
-    if (FetchMove(index).IsNotCertain()) allcertain = false; else index++;
+    if (IsNotCertain(index)) allcertain = false; else index++;
   return allcertain;
 }
 
@@ -269,7 +352,7 @@ void ML::AssignMaxGain(void) const
   // For each move, assign the maximum estimated gain metric
 
   for (miType index = 0; index < count; index++)
-    RefMove(index).PutSv(FetchMove(index).MaxGain());
+    PutSv(index, FetchMove(index).MaxGain());
 }
 
 void ML::AssignLikelyGain(const Pos& pos) const
@@ -277,7 +360,7 @@ void ML::AssignLikelyGain(const Pos& pos) const
   // For each move, assign the likely estimated gain metric
 
   for (miType index = 0; index < count; index++)
-    RefMove(index).PutSv(FetchMove(index).LikelyGain(pos));
+    PutSv(index, FetchMove(index).LikelyGain(pos));
 }
 
 void ML::AssignCenterTropismGain(void) const
@@ -285,21 +368,14 @@ void ML::AssignCenterTropismGain(void) const
   // For each move, assign the center tropism gain metric
 
   for (miType index = 0; index < count; index++)
-    RefMove(index).PutSv(FetchMove(index).CenterTropismGain());
+    PutSv(index, FetchMove(index).CenterTropismGain());
 }
 
 void ML::ShiftIndexedMoveToFront(const miType index)
 {
   // Move the move with the given index to the front of the list
 
-  if (index > 0)
-  {
-    const Move newtopmove = FetchMove(index);
-
-    for (miType toindex = index; toindex > 0; toindex--)
-      RefMove(toindex) = FetchMove(toindex - 1);
-    RefMove(0) = newtopmove;
-  };
+  if (index > 0) Rotate(0, index);
 }
 
 void ML::FilterByFrSqr(const sqrType sqr)
@@ -307,7 +383,7 @@ void ML::FilterByFrSqr(const sqrType sqr)
   // Remove all moves that don't have the indicated from-square
 
   for (miType index = 0; index < count; index++)
-    if (FetchMove(index).GetFrSqr() != sqr) RefMove(index).MakeVoid();
+    if (tmptr[index].GetFrSqr() != sqr) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -316,7 +392,7 @@ void ML::FilterByToSqr(const sqrType sqr)
   // Remove all moves that don't have the indicated to-square
 
   for (miType index = 0; index < count; index++)
-    if (FetchMove(index).GetToSqr() != sqr) RefMove(index).MakeVoid();
+    if (tmptr[index].GetToSqr() != sqr) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -325,7 +401,7 @@ void ML::FilterByFrMan(const manType man)
   // Remove all moves that don't have the indicated from-man
 
   for (miType index = 0; index < count; index++)
-    if (FetchMove(index).GetFrMan() != man) RefMove(index).MakeVoid();
+    if (GetFrMan(index) != man) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -334,7 +410,7 @@ void ML::FilterByToMan(const manType man)
   // Remove all moves that don't have the indicated to-man
 
   for (miType index = 0; index < count; index++)
-    if (FetchMove(index).GetToMan() != man) RefMove(index).MakeVoid();
+    if (FetchMove(index).GetToMan() != man) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -343,7 +419,7 @@ void ML::FilterByMsc(mscType msc)
   // Remove all moves that don't have the indicated to-man
 
   for (miType index = 0; index < count; index++)
-    if (FetchMove(index).GetMsc() != msc) RefMove(index).MakeVoid();
+    if (tmptr[index].GetMsc() != msc) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -351,8 +427,11 @@ void ML::FilterByMove(const Move& move)
 {
   // Remove all moves that aren't the given move
 
+  TinyMove tinymove;
+
+  tinymove.ConvertFromMove(move);
   for (miType index = 0; index < count; index++)
-    if (!Move::SameMove(FetchMove(index), move)) RefMove(index).MakeVoid();
+    if (!TinyMove::SameTinyMove(tmptr[index], tinymove)) MakeVoid(index);
   RemoveVoidMoves();
 }
 
@@ -364,14 +443,18 @@ void ML::RemoveVoidMoves(void)
 
   for (miType index = 0; index < count; index++)
   {
-    if (FetchMove(index).IsVoid()) delta++;
+    if (tmptr[index].IsVoid() && !mfmptr[index]) delta++;
     else
     {
-      if (delta) RefMove(index - delta) = FetchMove(index);
+      if (delta)
+      {
+        tmptr[index - delta] = tmptr[index]; svptr[index - delta] = svptr[index];
+        mfmptr[index - delta] = mfmptr[index];
+      };
     };
   };
 
-  if (delta) {count -= delta; nextptr = baseptr + count;};
+  count -= delta;
 }
 
 void ML::Print(void) const
@@ -10,59 +10,122 @@
 #ifndef Included_ML
 #define Included_ML
 
+class Board;
+class MoveStack;
 class Pos;
 
+// Standalone move list storage
+
+typedef struct
+{
+  TinyMove tinymoves[PosMovesLen];
+  svType svs[PosMovesLen];
+  mfmType mfms[PosMovesLen];
+} MLStore;
+
 // Move list class
 //
-// The ML class is used to represent a list of moves.
+// The ML class is used to represent a list of moves.  Each entry is a tiny move with its
+// score and flags held in parallel arrays; a full move is decoded on demand using the board
+// of the position where the list was generated, so the list is read only at that position.
 
 class ML
 {
   public:
-    ML(void) {baseptr = nextptr = 0; count = limit = 0;}
+    ML(void) {tmptr = 0; svptr = 0; mfmptr = 0; count = limit = 0; msptr = 0; boardptr = 0;}
     ML(const ML& priorml) {LoadFromPrior(priorml);}
-    ML(Move *ptr, const miType max) {baseptr = nextptr = ptr; count = 0; limit = max;}
+    ML(MLStore& mlstore, const Board& board)
+    {
+      Preset(mlstore.tinymoves, mlstore.svs, mlstore.mfms, PosMovesLen, 0, board);
+    }
     ~ML(void) {}
 
-    void Preset(Move moves[], const miType length)
+    void Preset(
+      TinyMove tinymoves[], svType svs[], mfmType mfms[], const miType length,
+      MoveStack *ptr, const Board& board)
     {
-      baseptr = moves; nextptr = baseptr; count = 0; limit = length;
+      tmptr = tinymoves; svptr = svs; mfmptr = mfms; count = 0; limit = length;
+      msptr = ptr; boardptr = &board;
     }
 
     void JamAssign(const ML& ml)
     {
-      baseptr = ml.baseptr; nextptr = ml.nextptr;
-      count = ml.count; limit = ml.limit;
+      tmptr = ml.tmptr; svptr = ml.svptr; mfmptr = ml.mfmptr;
+      count = ml.count; limit = ml.limit; msptr = ml.msptr; boardptr = ml.boardptr;
+    }
+
+    void JamAssignTail(const ML& ml, const miType first)
+    {
+      tmptr = ml.tmptr + first; svptr = ml.svptr + first; mfmptr = ml.mfmptr + first;
+      count = ml.count - first; limit = ml.limit - first;
+      msptr = ml.msptr; boardptr = ml.boardptr;
     }
 
     void LoadFromPrior(const ML& priorml)
     {
-      baseptr = nextptr = priorml.baseptr + priorml.count;
-      count = 0; limit = priorml.limit - priorml.count;
+      JamAssignTail(priorml, priorml.count);
     }
 
+    void Relocate(TinyMove tinymoves[], svType svs[], mfmType mfms[], const miType length);
+
+    const TinyMove *GetBasePtr(void) const {return tmptr;}
+
     miType GetCount(void) const {return count;}
-    void ResetCount(void) {count = 0; nextptr = baseptr;}
+    void ResetCount(void) {count = 0;}
+
+    void BindBoard(const Board& board) {boardptr = &board;}
 
     void Push(const Move& move)
     {
-      if (count < limit) {*nextptr++ = move; count++;} else DieFS(fsFeOverflowMS);
+      if (count < limit) StoreMove(count++, move); else PushFull(move);
+    }
+
+    Move FetchMove(const miType index) const
+    {
+      Move move;
+
+      tmptr[index].ConvertToMove(move, *boardptr);
+      move.PutFlags(mfmptr[index]); move.PutSv(svptr[index]);
+      return move;
     }
 
-    const Move& FetchMove(const miType index) const {return baseptr[index];}
-    Move& RefMove(const miType index) const {return baseptr[index];}
+    const TinyMove& FetchTinyMove(const miType index) const {return tmptr[index];}
 
+    svType GetSv(const miType index) const {return svptr[index];}
+    void PutSv(const miType index, const svType value) const {svptr[index] = value;}
+
+    mfmType GetFlags(const miType index) const {return mfmptr[index];}
+
+    void ResetFlagM(const miType index, const mfmType mfm) const {mfmptr[index] &= ~mfm;}
+    void SetFlagM(const miType index, const mfmType mfm) const {mfmptr[index] |= mfm;}
+    bool TestFlagM(const miType index, const mfmType mfm) const {return mfmptr[index] & mfm;}
+
+    bool IsBook(const miType index)       const {return TestFlagM(index, mfmBook);}
+    bool IsCertain(const miType index)    const {return TestFlagM(index, mfmCert);}
+    bool IsMate(const miType index)       const {return TestFlagM(index, mfmMate);}
+    bool IsNotCertain(const miType index) const {return !TestFlagM(index, mfmCert);}
+    bool IsSearched(const miType index)   const {return TestFlagM(index, mfmSrch);}
+
+    void SetCertain(const miType index, const svType value) const
+    {
+      PutSv(index, value); SetFlagM(index, mfmCert);
+    }
+
+    void MarkCheckAndCheckmate(Pos &pos, const miType index) const;
     void MarkChecksAndCheckmates(Pos &pos) const;
     void MarkDisambiguation(const Pos& pos) const;
     void MarkNotation(Pos& pos) const;
 
     void SortBySAN(void) const;
     void SortBySv(void) const;
+    void SortUnsearchedBySv(const miType first) const;
+
+    miType SelectBestUnsearched(const miType first) const;
 
     miType Locate(const Move& move) const;
     miType LocateNoFail(const Move& move) const;
 
-    void MatchMove(const char *str, Move& move) const;
+    void MatchMove(const char *str, Move& move, Pos& pos) const;
 
     void ClearSearchFlags(void) const;
 
@@ -87,20 +150,40 @@ class ML
     void Print(void) const;
 
   private:
+    void StoreMove(const miType index, const Move& move) const
+    {
+      tmptr[index].ConvertFromMove(move); svptr[index] = move.GetSv();
+      mfmptr[index] = move.GetFlags();
+    }
+
+    manType GetFrMan(const miType index) const {return boardptr->GetMan(tmptr[index].GetFrSqr());}
+
+    void MakeVoid(const miType index) const {tmptr[index].Reset(); mfmptr[index] = 0;}
+
+    void Rotate(const miType first, const miType last) const;
+
+    void PushFull(const Move& move);
+
     void RemoveVoidMoves(void);
 
-    Move *baseptr, *nextptr;
+    TinyMove *tmptr;          // Packed moves
+    svType *svptr;            // Move scores
+    mfmType *mfmptr;          // Move flags
     miType count, limit;
+    MoveStack *msptr;         // Owning move stack, if any
+    const Board *boardptr;    // Board of the generating position
 };
 
 inline miType ML::Locate(const Move& move) const
 {
   // Return the index of the given move if present; else return -1
 
+  TinyMove tinymove;
   miType match = -1, index = 0;
 
+  tinymove.ConvertFromMove(move);
   while ((match < 0) && (index < count))
-    if (Move::SameMove(move, FetchMove(index))) match = index; else index++;
+    if (TinyMove::SameTinyMove(tinymove, tmptr[index])) match = index; else index++;
   return match;
 }
 
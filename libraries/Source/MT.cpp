@@ -0,0 +1,232 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#include "MTE.h"
+#include "MT.h"
+
+#if (IsDevHost)
+bool MT::isbuilt = false;
+MTE MT::mtes[msigLen];
+#endif
+
+// Color entry: the non-pawn material score and the flags of one color signature
+
+typedef struct
+{
+  si16 sv;         // Non-pawn material score of the clamped counts
+  mtcfmType mtcfm; // Flags
+} MTCE;
+
+// Color entry construction from the clamped pawn, knight, bishop, rook, and queen counts
+
+#define MTCERow(p, n, b, r, q) \
+  { \
+    (si16) (((n) * svKnight) + ((b) * svBishop) + ((r) * svRook) + ((q) * svQueen)), \
+    (mtcfmType) ( \
+      (((p) > 0) ? mtcfmPawns : 0) | \
+      ((!(b) && !(r) && !(q)) ? mtcfmKnightsOnly : 0) | \
+      (((b) > 1) ? mtcfmBishopPair : 0) | \
+      (((p) || (r) || (q) || (((n) + (b)) > 1)) ? mtcfmSufficient : 0) | \
+      ((((b) == 1) && !(n) && !(r) && !(q)) ? mtcfmLoneBishop : 0) | \
+      (((r) || (q) || ((b) > 1)) ? mtcfmMating : 0) | \
+      ((!(p) && ((n) == 1) && ((b) == 1)) ? mtcfmKBN : 0) | \
+      ((((p) == 1) && !(n) && !(b)) ? mtcfmKP : 0)) \
+  }
+
+// Color entries indexed by color signature
+
+static const MTCE mtces[msigColorLen] PROGMEM =
+{
+  // Pawns: 0, knights: 0
+
+  MTCERow(0, 0, 0, 0, 0), MTCERow(0, 0, 0, 0, 1), MTCERow(0, 0, 0, 1, 0),
+  MTCERow(0, 0, 0, 1, 1), MTCERow(0, 0, 0, 2, 0), MTCERow(0, 0, 0, 2, 1),
+  MTCERow(0, 0, 1, 0, 0), MTCERow(0, 0, 1, 0, 1), MTCERow(0, 0, 1, 1, 0),
+  MTCERow(0, 0, 1, 1, 1), MTCERow(0, 0, 1, 2, 0), MTCERow(0, 0, 1, 2, 1),
+  MTCERow(0, 0, 2, 0, 0), MTCERow(0, 0, 2, 0, 1), MTCERow(0, 0, 2, 1, 0),
+  MTCERow(0, 0, 2, 1, 1), MTCERow(0, 0, 2, 2, 0), MTCERow(0, 0, 2, 2, 1),
+
+  // Pawns: 0, knights: 1
+
+  MTCERow(0, 1, 0, 0, 0), MTCERow(0, 1, 0, 0, 1), MTCERow(0, 1, 0, 1, 0),
+  MTCERow(0, 1, 0, 1, 1), MTCERow(0, 1, 0, 2, 0), MTCERow(0, 1, 0, 2, 1),
+  MTCERow(0, 1, 1, 0, 0), MTCERow(0, 1, 1, 0, 1), MTCERow(0, 1, 1, 1, 0),
+  MTCERow(0, 1, 1, 1, 1), MTCERow(0, 1, 1, 2, 0), MTCERow(0, 1, 1, 2, 1),
+  MTCERow(0, 1, 2, 0, 0), MTCERow(0, 1, 2, 0, 1), MTCERow(0, 1, 2, 1, 0),
+  MTCERow(0, 1, 2, 1, 1), MTCERow(0, 1, 2, 2, 0), MTCERow(0, 1, 2, 2, 1),
+
+  // Pawns: 0, knights: 2+
+
+  MTCERow(0, 2, 0, 0, 0), MTCERow(0, 2, 0, 0, 1), MTCERow(0, 2, 0, 1, 0),
+  MTCERow(0, 2, 0, 1, 1), MTCERow(0, 2, 0, 2, 0), MTCERow(0, 2, 0, 2, 1),
+  MTCERow(0, 2, 1, 0, 0), MTCERow(0, 2, 1, 0, 1), MTCERow(0, 2, 1, 1, 0),
+  MTCERow(0, 2, 1, 1, 1), MTCERow(0, 2, 1, 2, 0), MTCERow(0, 2, 1, 2, 1),
+  MTCERow(0, 2, 2, 0, 0), MTCERow(0, 2, 2, 0, 1), MTCERow(0, 2, 2, 1, 0),
+  MTCERow(0, 2, 2, 1, 1), MTCERow(0, 2, 2, 2, 0), MTCERow(0, 2, 2, 2, 1),
+
+  // Pawns: 1, knights: 0
+
+  MTCERow(1, 0, 0, 0, 0), MTCERow(1, 0, 0, 0, 1), MTCERow(1, 0, 0, 1, 0),
+  MTCERow(1, 0, 0, 1, 1), MTCERow(1, 0, 0, 2, 0), MTCERow(1, 0, 0, 2, 1),
+  MTCERow(1, 0, 1, 0, 0), MTCERow(1, 0, 1, 0, 1), MTCERow(1, 0, 1, 1, 0),
+  MTCERow(1, 0, 1, 1, 1), MTCERow(1, 0, 1, 2, 0), MTCERow(1, 0, 1, 2, 1),
+  MTCERow(1, 0, 2, 0, 0), MTCERow(1, 0, 2, 0, 1), MTCERow(1, 0, 2, 1, 0),
+  MTCERow(1, 0, 2, 1, 1), MTCERow(1, 0, 2, 2, 0), MTCERow(1, 0, 2, 2, 1),
+
+  // Pawns: 1, knights: 1
+
+  MTCERow(1, 1, 0, 0, 0), MTCERow(1, 1, 0, 0, 1), MTCERow(1, 1, 0, 1, 0),
+  MTCERow(1, 1, 0, 1, 1), MTCERow(1, 1, 0, 2, 0), MTCERow(1, 1, 0, 2, 1),
+  MTCERow(1, 1, 1, 0, 0), MTCERow(1, 1, 1, 0, 1), MTCERow(1, 1, 1, 1, 0),
+  MTCERow(1, 1, 1, 1, 1), MTCERow(1, 1, 1, 2, 0), MTCERow(1, 1, 1, 2, 1),
+  MTCERow(1, 1, 2, 0, 0), MTCERow(1, 1, 2, 0, 1), MTCERow(1, 1, 2, 1, 0),
+  MTCERow(1, 1, 2, 1, 1), MTCERow(1, 1, 2, 2, 0), MTCERow(1, 1, 2, 2, 1),
+
+  // Pawns: 1, knights: 2+
+
+  MTCERow(1, 2, 0, 0, 0), MTCERow(1, 2, 0, 0, 1), MTCERow(1, 2, 0, 1, 0),
+  MTCERow(1, 2, 0, 1, 1), MTCERow(1, 2, 0, 2, 0), MTCERow(1, 2, 0, 2, 1),
+  MTCERow(1, 2, 1, 0, 0), MTCERow(1, 2, 1, 0, 1), MTCERow(1, 2, 1, 1, 0),
+  MTCERow(1, 2, 1, 1, 1), MTCERow(1, 2, 1, 2, 0), MTCERow(1, 2, 1, 2, 1),
+  MTCERow(1, 2, 2, 0, 0), MTCERow(1, 2, 2, 0, 1), MTCERow(1, 2, 2, 1, 0),
+  MTCERow(1, 2, 2, 1, 1), MTCERow(1, 2, 2, 2, 0), MTCERow(1, 2, 2, 2, 1),
+
+  // Pawns: 2+, knights: 0
+
+  MTCERow(2, 0, 0, 0, 0), MTCERow(2, 0, 0, 0, 1), MTCERow(2, 0, 0, 1, 0),
+  MTCERow(2, 0, 0, 1, 1), MTCERow(2, 0, 0, 2, 0), MTCERow(2, 0, 0, 2, 1),
+  MTCERow(2, 0, 1, 0, 0), MTCERow(2, 0, 1, 0, 1), MTCERow(2, 0, 1, 1, 0),
+  MTCERow(2, 0, 1, 1, 1), MTCERow(2, 0, 1, 2, 0), MTCERow(2, 0, 1, 2, 1),
+  MTCERow(2, 0, 2, 0, 0), MTCERow(2, 0, 2, 0, 1), MTCERow(2, 0, 2, 1, 0),
+  MTCERow(2, 0, 2, 1, 1), MTCERow(2, 0, 2, 2, 0), MTCERow(2, 0, 2, 2, 1),
+
+  // Pawns: 2+, knights: 1
+
+  MTCERow(2, 1, 0, 0, 0), MTCERow(2, 1, 0, 0, 1), MTCERow(2, 1, 0, 1, 0),
+  MTCERow(2, 1, 0, 1, 1), MTCERow(2, 1, 0, 2, 0), MTCERow(2, 1, 0, 2, 1),
+  MTCERow(2, 1, 1, 0, 0), MTCERow(2, 1, 1, 0, 1), MTCERow(2, 1, 1, 1, 0),
+  MTCERow(2, 1, 1, 1, 1), MTCERow(2, 1, 1, 2, 0), MTCERow(2, 1, 1, 2, 1),
+  MTCERow(2, 1, 2, 0, 0), MTCERow(2, 1, 2, 0, 1), MTCERow(2, 1, 2, 1, 0),
+  MTCERow(2, 1, 2, 1, 1), MTCERow(2, 1, 2, 2, 0), MTCERow(2, 1, 2, 2, 1),
+
+  // Pawns: 2+, knights: 2+
+
+  MTCERow(2, 2, 0, 0, 0), MTCERow(2, 2, 0, 0, 1), MTCERow(2, 2, 0, 1, 0),
+  MTCERow(2, 2, 0, 1, 1), MTCERow(2, 2, 0, 2, 0), MTCERow(2, 2, 0, 2, 1),
+  MTCERow(2, 2, 1, 0, 0), MTCERow(2, 2, 1, 0, 1), MTCERow(2, 2, 1, 1, 0),
+  MTCERow(2, 2, 1, 1, 1), MTCERow(2, 2, 1, 2, 0), MTCERow(2, 2, 1, 2, 1),
+  MTCERow(2, 2, 2, 0, 0), MTCERow(2, 2, 2, 0, 1), MTCERow(2, 2, 2, 1, 0),
+  MTCERow(2, 2, 2, 1, 1), MTCERow(2, 2, 2, 2, 0), MTCERow(2, 2, 2, 2, 1)
+};
+
+void MT::OneTimeSetup(void)
+{
+  // Build the material table (development host only)
+
+#if (IsDevHost)
+  if (!isbuilt)
+  {
+    for (msigType wmsig = 0; wmsig < msigColorLen; wmsig++)
+      for (msigType bmsig = 0; bmsig < msigColorLen; bmsig++)
+        CalcMTE(wmsig, bmsig, mtes[(wmsig * msigColorLen) + bmsig]);
+    isbuilt = true;
+  };
+#endif
+}
+
+void MT::FetchMTE(const msigType wmsig, const msigType bmsig, MTE& mte)
+{
+  // Fetch the material table entry for a pair of color signatures
+
+#if (IsDevHost)
+  mte = mtes[(wmsig * msigColorLen) + bmsig];
+#endif
+
+#if (IsTarget)
+  CalcMTE(wmsig, bmsig, mte);
+#endif
+}
+
+void MT::CalcMTE(const msigType wmsig, const msigType bmsig, MTE& mte)
+{
+  // Calculate the material table entry for a pair of color signatures
+
+  const msigType msigbc[colorRLen] = {wmsig, bmsig};
+  svType svbc[colorRLen];
+  mtcfmType mtcfmbc[colorRLen];
+
+  // Fetch the color entries
+
+  for (colorType color = 0; color < colorRLen; color++)
+  {
+    svbc[color] = ReadFlashSi16(&mtces[msigbc[color]].sv);
+    mtcfmbc[color] = ReadFlashUi8(&mtces[msigbc[color]].mtcfm);
+  };
+
+  mte.Reset();
+
+  // Bishop pair bonus
+
+  svType imbalance = svEven;
+
+  if (mtcfmbc[colorWhite] & mtcfmBishopPair) imbalance += svBishopPair;
+  if (mtcfmbc[colorBlack] & mtcfmBishopPair) imbalance -= svBishopPair;
+  mte.PutImbalance(imbalance);
+
+  // Scale factors for each color when favored: without pawns, a small edge rarely wins
+
+  for (colorType color = 0; color < colorRLen; color++)
+  {
+    const colorType other = OtherColor(color);
+
+    if (!(mtcfmbc[color] & mtcfmPawns))
+    {
+      if ((svbc[color] < svRook) || (mtcfmbc[color] & mtcfmKnightsOnly))
+        mte.PutScale(color, mtsNone);
+      else
+      {
+        if ((svbc[color] - svbc[other]) <= svBishop) mte.PutScale(color, mtsHard);
+      };
+    };
+  };
+
+  // Insufficient material: no pawns, rooks, or queens and at most one minor piece per color
+
+  if (!((mtcfmbc[colorWhite] | mtcfmbc[colorBlack]) & mtcfmSufficient)) mte.SetFlag(mtefmDraw);
+
+  // Single bishops each with no other pieces; opposite colored bishops scale down later
+
+  if (mtcfmbc[colorWhite] & mtcfmbc[colorBlack] & mtcfmLoneBishop) mte.SetFlag(mtefmBishops);
+
+  // Specialized endgame evaluator selection: one color has a bare king
+
+  for (colorType color = 0; color < colorRLen; color++)
+  {
+    const colorType other = OtherColor(color);
+
+    if (!(mtcfmbc[other] & mtcfmPawns) && !svbc[other])
+    {
+      if (mtcfmbc[color] & mtcfmMating) mte.PutEgid(egidKXK, color);
+      else
+      {
+        if (mtcfmbc[color] & mtcfmKBN) mte.PutEgid(egidKBNK, color);
+#if (IsDevHost)
+        else
+        {
+          if (mtcfmbc[color] & mtcfmKP) mte.PutEgid(egidKPK, color);
+        };
+#endif
+      };
+    };
+  };
+}
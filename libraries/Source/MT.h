@@ -0,0 +1,40 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_MT
+#define Included_MT
+
+// Forward class declaration(s)
+
+class MTE;
+
+// Material table class; only statics, no instances
+//
+// The table maps a material signature to its imbalance correction, scale factors, draw
+// flag, and endgame evaluator identifier.  Each entry is combined from a pair of flash
+// color entries, one per color signature.  The development host builds the full table
+// once at startup; the target lacks the memory and so combines each entry on demand.
+
+class MT
+{
+  public:
+    static void OneTimeSetup(void);
+
+    static void FetchMTE(const msigType wmsig, const msigType bmsig, MTE& mte);
+
+  private:
+    static void CalcMTE(const msigType wmsig, const msigType bmsig, MTE& mte);
+
+#if (IsDevHost)
+    static bool isbuilt;
+    static MTE mtes[msigLen];
+#endif
+};
+
+#endif
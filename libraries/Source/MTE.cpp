@@ -0,0 +1,20 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#include "MTE.h"
+
+void MTE::Reset(void)
+{
+  imbalance = svEven; scales[colorWhite] = scales[colorBlack] = mtsFull;
+  egid = (ui8) egidNone; egcolor = (ui8) colorWhite; mtefm = 0;
+}
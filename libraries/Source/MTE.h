@@ -0,0 +1,47 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_MTE
+#define Included_MTE
+
+// Material table entry class
+
+class MTE
+{
+  public:
+    void Reset(void);
+
+    svType GetImbalance(void) const {return imbalance;}
+    void PutImbalance(const svType sv) {imbalance = sv;}
+
+    ui8 GetScale(const colorType color) const {return scales[color];}
+    void PutScale(const colorType color, const ui8 scale) {scales[color] = scale;}
+
+    egidType GetEgid(void) const {return (egidType) egid;}
+    colorType GetEgColor(void) const {return (colorType) egcolor;}
+
+    void PutEgid(const egidType egidvalue, const colorType color)
+    {
+      egid = (ui8) egidvalue; egcolor = (ui8) color;
+    }
+
+    bool IsDraw(void) const {return mtefm & mtefmDraw;}
+    bool IsBishops(void) const {return mtefm & mtefmBishops;}
+
+    void SetFlag(const mtefmType mask) {mtefm |= mask;}
+
+  private:
+    svType imbalance;          // Imbalance correction from White's point of view
+    ui8 scales[colorRLen];     // Score scale factor when favoring each color
+    ui8 egid;                  // Specialized endgame evaluator identifier
+    ui8 egcolor;               // Specialized endgame evaluator strong color
+    mtefmType mtefm;           // Flags
+};
+
+#endif
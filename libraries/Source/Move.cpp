@@ -18,6 +18,7 @@
 #include "Board.h"
 #include "CNPair.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "SAN.h"
 #include "ML.h"
 #include "FEnv.h"
@@ -25,6 +26,7 @@
 #include "Hash.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
 svType Move::MaxGain(void) const
@@ -79,6 +81,8 @@ void Move::Mark(Pos& pos, const ML& priorml)
 
   ML ml(priorml);
 
+  ml.BindBoard(pos);
+
   // Phase 1: Process generation according to check status
 
   if (pos.InCheck()) pos.GenEvasion(ml);
@@ -119,7 +123,7 @@ void Move::Mark(Pos& pos, const ML& priorml)
 
   // Phase 4: Find this move in the generation list and calculate any new marking flags
 
-  const mfmType addflags = ml.FetchMove(ml.LocateNoFail(*this)).GetFlags() & mfmNotation;
+  const mfmType addflags = ml.GetFlags(ml.LocateNoFail(*this)) & mfmNotation;
 
   // Phase 5: Apply any flags to this move
 
@@ -154,6 +158,32 @@ void Move::Print(const FEnv& fenv) const
   cnpair.Print(); PrintSpace(); san.LoadFromMove(*this); san.Print();
 }
 
+void Move::EncodeUCI(char **bptrptr) const
+{
+  // Encode the UCI coordinate representation for the move; a castling move is encoded as
+  // its king move and a promotion piece is in lower case
+
+  if (IsNullOrVoid()) EncodeFS(bptrptr, fsUcNullMove);
+  else
+  {
+    EncodeChar(bptrptr, CharOfFile(MapSqrToFile(frsqr)));
+    EncodeChar(bptrptr, CharOfRank(MapSqrToRank(frsqr)));
+    EncodeChar(bptrptr, CharOfFile(MapSqrToFile(tosqr)));
+    EncodeChar(bptrptr, CharOfRank(MapSqrToRank(tosqr)));
+    if (IsPromotion())
+      EncodeChar(bptrptr, CharOfMan(synthman[colorBlack][cvpromtopiece[cvmsctoprom[msc]]]));
+  };
+}
+
+void Move::PrintUCI(void) const
+{
+  // Print the UCI coordinate representation for the move
+
+  char cv[ucimLen], *cptr = cv;
+
+  EncodeUCI(&cptr); *cptr = '\0'; PrintStr(cv);
+}
+
 void Move::PrintVTMS(const Move *mptr)
 {
   // Print a void move terminated move sequence
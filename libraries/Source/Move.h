@@ -96,6 +96,9 @@ class Move
     void Print(void) const;
     void Print(const FEnv& fenv) const;
 
+    void EncodeUCI(char **bptrptr) const;
+    void PrintUCI(void) const;
+
     static bool SameMove(const Move& move0, const Move& move1);
 
     static void PrintVTMS(const Move *mptr);
@@ -0,0 +1,132 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#endif
+
+#include "Board.h"
+#include "FEnv.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "ML.h"
+#include "MoveStack.h"
+
+MoveStack::MoveStack(void)
+{
+#if (IsDevHost)
+  segcount = 0;
+  for (ui index = 0; index < MoveSegLen; index++) {segptrs[index] = 0; segbases[index] = 0;};
+#endif
+  ResetStats();
+}
+
+#if (IsDevHost)
+MoveStack::~MoveStack(void)
+{
+  // Release the extension segments
+
+  for (ui index = 0; index < segcount; index++) delete segptrs[index];
+}
+#endif
+
+void MoveStack::PresetML(ML& ml, const Board& board)
+{
+  // Set a move list to cover the entire fixed stack
+
+  ml.Preset(fixedseg.tinymoves, fixedseg.svs, fixedseg.mfms, MoveStackLen, this, board);
+}
+
+bool MoveStack::Extend(ML& ml)
+{
+  // Handle a push onto a full move list; return true if the list now has room
+
+  bool extended = false;
+
+#if (IsDevHost)
+  // Locate the storage of the list: -1 for the fixed stack, else the segment index
+
+  const TinyMove *baseptr = ml.GetBasePtr();
+  si level = -1;
+
+  for (ui index = 0; index < segcount; index++)
+    if (IsInSeg(baseptr, index))
+      level = (si) index;
+
+  // Move the list to the next segment; any lists already there are no longer in use
+
+  const ui nextlevel = (ui) (level + 1);
+
+  if (nextlevel < MoveSegLen)
+  {
+    MSSeg *segptr;
+
+    if (nextlevel == segcount) segptrs[segcount++] = new MSSeg;
+    segptr = segptrs[nextlevel];
+    segbases[nextlevel] = CalcUsage(ml) - ml.GetCount();
+    ml.Relocate(segptr->tinymoves, segptr->svs, segptr->mfms, MoveStackLen);
+    extendcount++; extended = true;
+  };
+#endif
+
+  if (!extended) overflowcount++;
+  return extended;
+}
+
+void MoveStack::ResetStats(void)
+{
+  // Reset the usage statistics
+
+  for (plyType ply = 0; ply < MaxPlyLenP1; ply++) peaks[ply] = 0;
+  extendcount = overflowcount = 0;
+}
+
+void MoveStack::PrintStats(void) const
+{
+  // Print the peak usage overall and by ply, then the extension and overflow counts
+
+  miType peak = 0;
+  plyType plylimit = 0;
+
+  for (plyType ply = 0; ply < MaxPlyLenP1; ply++)
+    if (peaks[ply]) {plylimit = ply + 1; if (peaks[ply] > peak) peak = peaks[ply];};
+
+  PrintFSL(fsLbMoveStackPeak); PrintSi16(peak);
+  PrintISM(); PrintFSL(fsLbExtensions); PrintUi32(extendcount);
+  PrintISM(); PrintFSL(fsLbOverflows); PrintUi32(overflowcount);
+  if (plylimit)
+  {
+    PrintISM(); PrintFSL(fsLbPlyPeaks);
+    for (plyType ply = 0; ply < plylimit; ply++)
+    {
+      if (ply) PrintSpace();
+      PrintSi16(peaks[ply]);
+    };
+  };
+}
+
+miType MoveStack::CalcUsage(const ML& ml) const
+{
+  // Return the fixed stack units in use up to the end of a move list
+
+  const TinyMove *baseptr = ml.GetBasePtr();
+  miType usage = (miType) (baseptr - fixedseg.tinymoves);
+
+#if (IsDevHost)
+  for (ui index = 0; index < segcount; index++)
+    if (IsInSeg(baseptr, index))
+      usage = segbases[index] + (miType) (baseptr - segptrs[index]->tinymoves);
+#endif
+
+  return usage + ml.GetCount();
+}
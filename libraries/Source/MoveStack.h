@@ -0,0 +1,96 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_MoveStack
+#define Included_MoveStack
+
+// Forward class declaration(s)
+
+class Board;
+class ML;
+
+// Move stack extension segment limit (host only)
+
+#if (IsDevHost)
+#define MoveSegLen 8
+#endif
+
+// Move stack storage segment
+
+typedef struct
+{
+  TinyMove tinymoves[MoveStackLen];
+  svType svs[MoveStackLen];
+  mfmType mfms[MoveStackLen];
+} MSSeg;
+
+// Move stack class
+//
+// The MoveStack class is the arena for all search move lists; each node's list is carved
+// from the unused tail of its parent's list.  The storage holds tiny moves with parallel
+// score and flag arrays (see the ML class).  A push onto a full list calls Extend():
+//
+// Host: the list is moved to the next extension segment (allocated on first use and then
+// kept for reuse) and the push proceeds.
+//
+// Target: the push is dropped and counted as an overflow; the search then stops as it
+// would for a time limit.
+//
+// The peak usage at each ply is kept in units of the fixed stack (an extension segment
+// continues from where its first list would have started) for sizing MoveStackLen.
+
+class MoveStack
+{
+  public:
+    MoveStack(void);
+#if (IsDevHost)
+    ~MoveStack(void);
+#endif
+
+    void PresetML(ML& ml, const Board& board);
+
+    bool Extend(ML& ml);
+
+    void Mark(const plyType ply, const ML& ml)
+    {
+      const miType usage = CalcUsage(ml);
+
+      if (usage > peaks[ply]) peaks[ply] = usage;
+    }
+
+    void ResetStats(void);
+
+    bool IsOverflow(void) const {return overflowcount > 0;}
+
+    void PrintStats(void) const;
+
+  private:
+    miType CalcUsage(const ML& ml) const;
+
+#if (IsDevHost)
+    bool IsInSeg(const TinyMove *ptr, const ui index) const
+    {
+      const TinyMove *baseptr = segptrs[index]->tinymoves;
+
+      return (ptr >= baseptr) && (ptr <= (baseptr + MoveStackLen));
+    }
+#endif
+
+    MSSeg fixedseg;                // Fixed stack storage
+#if (IsDevHost)
+    MSSeg *segptrs[MoveSegLen];    // Extension segments
+    miType segbases[MoveSegLen];   // Extension segment starts in fixed stack units
+    ui segcount;                   // Extension segments allocated
+#endif
+    miType peaks[MaxPlyLenP1];     // Peak usage by ply
+    ui32 extendcount;              // Lists moved to an extension segment
+    ui32 overflowcount;            // Pushes dropped
+};
+
+#endif
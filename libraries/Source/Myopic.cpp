@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -20,14 +21,20 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
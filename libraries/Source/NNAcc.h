@@ -0,0 +1,38 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_NNAcc
+#define Included_NNAcc
+
+#if (IsDevHost)
+
+// Neural network dimensions: one input per man/square, one hidden layer per perspective
+
+#define nnInputLen  (manRLen * sqrLen)
+#define nnHiddenLen 128
+
+// Neural network accumulator class
+//
+// The NNAcc class holds the first layer sums of the neural network evaluator, one
+// set for each color's point of view.  It is updated incrementally as men are added,
+// deleted, and moved; an accumulator copy is saved at each ply of the search.
+
+class NNAcc
+{
+  public:
+    const si16 *FetchVec(const colorType color) const {return vecs[color];}
+    si16 *RefVec(const colorType color) {return vecs[color];}
+
+  private:
+    alignas(32) si16 vecs[colorRLen][nnHiddenLen];
+};
+
+#endif
+
+#endif
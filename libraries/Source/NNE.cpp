@@ -0,0 +1,242 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#if (defined(__AVX2__) || defined(__SSE4_1__))
+#include <immintrin.h>
+#endif
+#endif
+
+#if (IsDevHost)
+
+#include "Board.h"
+#include "Score.h"
+#include "NNAcc.h"
+#include "NNE.h"
+
+// Vector routines; the instruction set is selected at compile time (e.g., -mavx2)
+
+static inline void AddVec(si16 *vec, const si16 *wvec)
+{
+#if defined(__AVX2__)
+  for (ui index = 0; index < nnHiddenLen; index += 16)
+  {
+    __m256i *ptr = (__m256i *) (vec + index);
+    const __m256i w = _mm256_loadu_si256((const __m256i *) (wvec + index));
+
+    _mm256_storeu_si256(ptr, _mm256_add_epi16(_mm256_loadu_si256(ptr), w));
+  };
+#elif defined(__SSE4_1__)
+  for (ui index = 0; index < nnHiddenLen; index += 8)
+  {
+    __m128i *ptr = (__m128i *) (vec + index);
+    const __m128i w = _mm_loadu_si128((const __m128i *) (wvec + index));
+
+    _mm_storeu_si128(ptr, _mm_add_epi16(_mm_loadu_si128(ptr), w));
+  };
+#else
+  for (ui index = 0; index < nnHiddenLen; index++) vec[index] += wvec[index];
+#endif
+}
+
+static inline void SubVec(si16 *vec, const si16 *wvec)
+{
+#if defined(__AVX2__)
+  for (ui index = 0; index < nnHiddenLen; index += 16)
+  {
+    __m256i *ptr = (__m256i *) (vec + index);
+    const __m256i w = _mm256_loadu_si256((const __m256i *) (wvec + index));
+
+    _mm256_storeu_si256(ptr, _mm256_sub_epi16(_mm256_loadu_si256(ptr), w));
+  };
+#elif defined(__SSE4_1__)
+  for (ui index = 0; index < nnHiddenLen; index += 8)
+  {
+    __m128i *ptr = (__m128i *) (vec + index);
+    const __m128i w = _mm_loadu_si128((const __m128i *) (wvec + index));
+
+    _mm_storeu_si128(ptr, _mm_sub_epi16(_mm_loadu_si128(ptr), w));
+  };
+#else
+  for (ui index = 0; index < nnHiddenLen; index++) vec[index] -= wvec[index];
+#endif
+}
+
+static inline void SubAddVec(si16 *vec, const si16 *subwvec, const si16 *addwvec)
+{
+#if defined(__AVX2__)
+  for (ui index = 0; index < nnHiddenLen; index += 16)
+  {
+    __m256i *ptr = (__m256i *) (vec + index);
+    const __m256i subw = _mm256_loadu_si256((const __m256i *) (subwvec + index));
+    const __m256i addw = _mm256_loadu_si256((const __m256i *) (addwvec + index));
+    const __m256i diff = _mm256_sub_epi16(_mm256_loadu_si256(ptr), subw);
+
+    _mm256_storeu_si256(ptr, _mm256_add_epi16(diff, addw));
+  };
+#elif defined(__SSE4_1__)
+  for (ui index = 0; index < nnHiddenLen; index += 8)
+  {
+    __m128i *ptr = (__m128i *) (vec + index);
+    const __m128i subw = _mm_loadu_si128((const __m128i *) (subwvec + index));
+    const __m128i addw = _mm_loadu_si128((const __m128i *) (addwvec + index));
+
+    _mm_storeu_si128(ptr, _mm_add_epi16(_mm_sub_epi16(_mm_loadu_si128(ptr), subw), addw));
+  };
+#else
+  for (ui index = 0; index < nnHiddenLen; index++) vec[index] += addwvec[index] - subwvec[index];
+#endif
+}
+
+static inline si32 DotClipped(const si16 *vec, const si8 *wvec)
+{
+  // Clip the accumulator to [0, nnQA] unsigned bytes, then multiply by the signed byte weights
+
+#if defined(__AVX2__)
+  const __m256i zero = _mm256_setzero_si256(), qa = _mm256_set1_epi16(nnQA);
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sum = zero;
+
+  for (ui index = 0; index < nnHiddenLen; index += 32)
+  {
+    __m256i v0 = _mm256_loadu_si256((const __m256i *) (vec + index));
+    __m256i v1 = _mm256_loadu_si256((const __m256i *) (vec + index + 16));
+
+    v0 = _mm256_min_epi16(_mm256_max_epi16(v0, zero), qa);
+    v1 = _mm256_min_epi16(_mm256_max_epi16(v1, zero), qa);
+
+    // The byte pack works within 128 bit lanes, so the quadwords need reordering
+
+    const __m256i u8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(v0, v1), 0xd8);
+    const __m256i s8 = _mm256_loadu_si256((const __m256i *) (wvec + index));
+
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(u8, s8), ones));
+  };
+
+  __m128i sum128 = _mm256_castsi256_si128(sum);
+
+  sum128 = _mm_add_epi32(sum128, _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4e));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xb1));
+  return _mm_cvtsi128_si32(sum128);
+#elif defined(__SSE4_1__)
+  const __m128i zero = _mm_setzero_si128(), qa = _mm_set1_epi16(nnQA), ones = _mm_set1_epi16(1);
+  __m128i sum = zero;
+
+  for (ui index = 0; index < nnHiddenLen; index += 16)
+  {
+    __m128i v0 = _mm_loadu_si128((const __m128i *) (vec + index));
+    __m128i v1 = _mm_loadu_si128((const __m128i *) (vec + index + 8));
+
+    v0 = _mm_min_epi16(_mm_max_epi16(v0, zero), qa);
+    v1 = _mm_min_epi16(_mm_max_epi16(v1, zero), qa);
+
+    const __m128i u8 = _mm_packus_epi16(v0, v1);
+    const __m128i s8 = _mm_loadu_si128((const __m128i *) (wvec + index));
+
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(u8, s8), ones));
+  };
+
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+  return _mm_cvtsi128_si32(sum);
+#else
+  si32 sum = 0;
+
+  for (ui index = 0; index < nnHiddenLen; index++)
+  {
+    const si32 value = vec[index];
+
+    sum += ((value < 0) ? 0 : ((value > nnQA) ? nnQA : value)) * wvec[index];
+  };
+  return sum;
+#endif
+}
+
+bool NNE::LoadFromFile(const char *fn)
+{
+  // Load the network weights from a file; return validity status
+
+  std::ifstream ifs(fn, std::ios::in | std::ios::binary);
+  char magic[4];
+  ui32 hidden = 0;
+
+  ifs.read(magic, sizeof(magic));
+  ifs.read((char *) &hidden, sizeof(hidden));
+  if (!ifs || (memcmp(magic, "MNN1", sizeof(magic)) != 0) || (hidden != nnHiddenLen))
+    return false;
+
+  ifs.read((char *) ftbias, sizeof(ftbias));
+  ifs.read((char *) ftweights, sizeof(ftweights));
+  ifs.read((char *) outweights, sizeof(outweights));
+  ifs.read((char *) &outbias, sizeof(outbias));
+  return (bool) ifs;
+}
+
+void NNE::Refresh(NNAcc& nnacc, const Board& board) const
+{
+  // Recalculate both accumulators from scratch
+
+  for (colorType color = 0; color < colorRLen; color++)
+  {
+    si16 *vec = nnacc.RefVec(color);
+
+    for (ui index = 0; index < nnHiddenLen; index++) vec[index] = ftbias[index];
+    for (sqrType sqr = 0; sqr < sqrLen; sqr++)
+    {
+      const manType man = board.GetMan(sqr);
+
+      if (IsManNotVacant(man)) AddVec(vec, ftweights[CalcInput(color, man, sqr)]);
+    };
+  };
+}
+
+void NNE::AddFeature(NNAcc& nnacc, const manType man, const sqrType sqr) const
+{
+  for (colorType color = 0; color < colorRLen; color++)
+    AddVec(nnacc.RefVec(color), ftweights[CalcInput(color, man, sqr)]);
+}
+
+void NNE::DelFeature(NNAcc& nnacc, const manType man, const sqrType sqr) const
+{
+  for (colorType color = 0; color < colorRLen; color++)
+    SubVec(nnacc.RefVec(color), ftweights[CalcInput(color, man, sqr)]);
+}
+
+void NNE::MoveFeature(
+  NNAcc& nnacc, const manType man, const sqrType frsqr, const sqrType tosqr) const
+{
+  for (colorType color = 0; color < colorRLen; color++)
+    SubAddVec(
+      nnacc.RefVec(color),
+      ftweights[CalcInput(color, man, frsqr)], ftweights[CalcInput(color, man, tosqr)]);
+}
+
+svType NNE::Evaluate(const NNAcc& nnacc, const colorType good) const
+{
+  // Evaluate from the good player's point of view; the result is kept clear of mate scores
+
+  const si32 sum =
+    DotClipped(nnacc.FetchVec(good), outweights[0]) +
+    DotClipped(nnacc.FetchVec(OtherColor(good)), outweights[1]) + outbias;
+  const si32 limit = svSlowMate / 2;
+  si32 sv = (si32) (((long long) sum * nnScale) / (nnQA * nnQB));
+
+  if (sv > limit) sv = limit; else if (sv < -limit) sv = -limit;
+  return (svType) sv;
+}
+
+#endif
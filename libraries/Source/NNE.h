@@ -0,0 +1,68 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_NNE
+#define Included_NNE
+
+#if (IsDevHost)
+
+// Neural network evaluator class
+//
+// The NNE class holds the weights of a small efficiently updatable neural network
+// that can replace the hand written evaluation.  The first layer maps each man/square
+// input to an accumulator; only the inputs changed by a move need to be applied.  The
+// clipped accumulators of the side to move and of the other side feed a single output.
+//
+// The network file is little endian:
+//
+//   "MNN1"                           Four character magic identifier
+//   ui32 hidden                      Hidden layer length (must be nnHiddenLen)
+//   si16 ftbias[hidden]              First layer biases
+//   si16 ftweights[768][hidden]      First layer weights; input is (man * 64) + sqr
+//   si8  outweights[2][hidden]       Output weights; side to move first
+//   si32 outbias                     Output bias
+//
+// Inputs are from each color's point of view: Black's inputs use the color swapped
+// man and the rank flipped square.  Activations are clipped to [0, nnQA] and the
+// output is scaled by nnScale / (nnQA * nnQB) to give centipawns.
+
+#define nnQA    127
+#define nnQB     64
+#define nnScale 400
+
+class NNE
+{
+  public:
+    bool LoadFromFile(const char *fn);
+
+    void Refresh(NNAcc& nnacc, const Board& board) const;
+
+    void AddFeature(NNAcc& nnacc, const manType man, const sqrType sqr) const;
+    void DelFeature(NNAcc& nnacc, const manType man, const sqrType sqr) const;
+    void MoveFeature(
+      NNAcc& nnacc, const manType man, const sqrType frsqr, const sqrType tosqr) const;
+
+    svType Evaluate(const NNAcc& nnacc, const colorType good) const;
+
+  private:
+    static ui CalcInput(const colorType color, const manType man, const sqrType sqr)
+    {
+      return IsColorWhite(color) ?
+        ((man * sqrLen) + sqr) : ((otherman[man] * sqrLen) + OtherSqr(sqr));
+    }
+
+    alignas(32) si16 ftbias[nnHiddenLen];
+    alignas(32) si16 ftweights[nnInputLen][nnHiddenLen];
+    alignas(32) si8 outweights[colorRLen][nnHiddenLen];
+    si32 outbias;
+};
+
+#endif
+
+#endif
@@ -19,6 +19,13 @@
 #include "TBV.h"
 #include "MGS.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "PIR.h"
 
-void PIR::Reset(void) {mgs.Reset(); penv.Reset();}
+void PIR::Reset(void)
+{
+  mgs.Reset();
+#if (!UseCopyMake)
+  penv.Reset();
+#endif
+}
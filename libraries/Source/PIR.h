@@ -20,12 +20,26 @@ class PIR
     const MGS& FetchMGS(void) const {return mgs;}
     MGS& RefMGS(void) {return mgs;}
 
+    // The position environment snapshots are needed only by execute/retract
+
+#if (!UseCopyMake)
     const PEnv& FetchPEnv(void) const {return penv;}
     PEnv& RefPEnv(void) {return penv;}
 
+#if (IsDevHost)
+    const NNAcc& FetchNNAcc(void) const {return nnacc;}
+    NNAcc& RefNNAcc(void) {return nnacc;}
+#endif
+#endif
+
   private:
     MGS mgs;
+#if (!UseCopyMake)
     PEnv penv;
+#if (IsDevHost)
+    NNAcc nnacc;
+#endif
+#endif
 };
 
 #endif
@@ -0,0 +1,126 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "Score.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "UnDo.h"
+#include "UnDoStack.h"
+#include "ML.h"
+#include "MoveStack.h"
+#include "Hash.h"
+#include "History.h"
+#include "TBV.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
+#include "Pos.h"
+#include "PVTable.h"
+#include "PIR.h"
+#include "Search.h"
+#include "State.h"
+#include "CIB.h"
+#include "PND.h"
+
+// Ponder data; the position prior to the predicted move is kept for matching the input
+
+struct PNDData
+{
+  Pos pos;              // Position prior to the predicted move
+  Move pondermove;      // Predicted user move
+  std::string line;     // Input line
+  bool eof;             // Input end of file flag
+  bool hit;             // Ponder hit flag
+};
+
+static void ReadInput(PNDData *dataptr, State *stateptr)
+{
+  // Input thread: read the next command line, then either convert the ponder search to a
+  // timed search (a single token that matches the predicted move) or interrupt it
+
+  std::istringstream iss;
+  std::string token, extra;
+
+  dataptr->eof = !std::getline(std::cin, dataptr->line);
+  iss.str(dataptr->line);
+  if (!dataptr->eof && (iss >> token) && !(iss >> extra))
+  {
+    MLStore mlstore;
+    ML ml(mlstore, dataptr->pos);
+    Move move;
+
+    dataptr->pos.MatchMove(token.c_str(), move, ml);
+    dataptr->hit = move.IsNotVoid() && Move::SameMove(move, dataptr->pondermove);
+  };
+
+  if (dataptr->hit) stateptr->RestartTimeLimit(stateptr->GetLimitMsec());
+  else
+    stateptr->Interrupt();
+}
+
+PND::PND(void)
+{
+  dataptr = new PNDData;
+  dataptr->pondermove.MakeVoid(); dataptr->eof = dataptr->hit = false;
+}
+
+PND::~PND(void) {delete dataptr;}
+
+bool PND::Run(const Move& move, CIB& cib)
+{
+  // Ponder on the given predicted user move until the next command line is read; the line
+  // is loaded into the command input buffer.  Return the ponder hit status.
+
+  dataptr->pos.LoadPosFromFPos(stateptr->FetchSearchFPos());
+  dataptr->pondermove = move; dataptr->hit = false;
+
+  // Play the predicted move, then search while the input thread waits for the user; the
+  // prompt is flushed here as there is no line read by the main thread.  Stale requests are
+  // dropped before the input thread starts, so a hit or a miss it reports before the search
+  // starts stays pending for the search to take.
+
+  stateptr->ResetInterrupt(); stateptr->Play(move); FlushOutput();
+  {
+    std::thread reader(ReadInput, dataptr, stateptr);
+
+    if (!stateptr->IsOver()) stateptr->RunPonderSearch();
+    reader.join();
+  };
+
+  // Drop any leftover request; a ponder miss takes back the predicted move
+
+  stateptr->ResetInterrupt();
+  if (!dataptr->hit) stateptr->Unplay();
+  cib.LoadFromStr(dataptr->line.c_str(), dataptr->eof);
+  return dataptr->hit;
+}
+
+#endif
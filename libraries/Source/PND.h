@@ -0,0 +1,48 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_PND
+#define Included_PND
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class CIB;
+class Move;
+class State;
+
+struct PNDData;
+
+// Ponder class
+//
+// The PND class runs a search on the user's time.  The predicted user move is played
+// and its position is searched without a time limit while an input thread waits for the
+// user's next command line.  If that line is the predicted move (a ponder hit), the search
+// continues under the normal time limit starting from the moment of the hit; otherwise
+// (a ponder miss), the search is interrupted and the predicted move is taken back.
+
+class PND
+{
+  public:
+    PND(void);
+    ~PND(void);
+
+    void SetStatePtr(State *ptr) {stateptr = ptr;}
+
+    bool Run(const Move& move, CIB& cib);
+
+  private:
+    State *stateptr;
+    PNDData *dataptr;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,307 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#endif
+
+#if (IsDevHost)
+
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+
+// The packed position is also the binary file record
+
+static_assert(sizeof(PPos) == pposLen, "PPos: record layout");
+
+static bool IsCharBlank(const char ch) {return (ch == ' ') || (ch == '\t');}
+
+static bool IsDigitsToken(const char *str)
+{
+  // Check for an unsigned integer token ended by a blank or the end of the string
+
+  bool isdigits = IsCharDigit(*str);
+
+  while (isdigits && *str && !IsCharBlank(*str)) if (!IsCharDigit(*str++)) isdigits = false;
+  return isdigits;
+}
+
+static char *EncodeUi16(char *str, const ui16 value)
+{
+  // Encode a blank and then an unsigned decimal value; return the next string location
+
+  char digits[5];
+  ui count = 0, residue = value;
+
+  do {digits[count++] = CharOfDigit(residue % 10); residue /= 10;} while (residue);
+  *str++ = ' ';
+  while (count) *str++ = digits[--count];
+  return str;
+}
+
+void PPos::Reset(void)
+{
+  // All squares vacant, all environment bytes zero
+
+  for (ui index = 0; index < pposBoardLen; index++) bytes[index] = (manVacant << 4) | manVacant;
+  for (ui index = pposBoardLen; index < pposLen; index++) bytes[index] = 0;
+}
+
+bool PPos::LoadFromStr(const char *str, const char **restptrptr)
+{
+  // Load by parsing a FEN record or an EPD record (four fields, the counters default to
+  // zero and one); if the rest pointer pointer is non-null, it gets the location of the
+  // text following the position fields.  Return validity status.
+
+  bool valid = true;
+  ui mancount[manRLen];
+  char ch;
+
+  Reset();
+  for (manType man = 0; man < manRLen; man++) mancount[man] = 0;
+
+  // The first field is the chessboard MPD (Man Placement Data); men are counted here
+
+  while (IsCharBlank(*str)) str++;
+  {
+    rankType rank = rank8;
+    fileType file = fileA;
+
+    ch = *str++;
+    while (valid && ch && !IsCharBlank(ch))
+    {
+      if (ch == '/')
+      {
+        if (rank == rank1) valid = false; else {file = fileA; rank--;};
+      }
+      else
+      {
+        if (IsCharMan(ch))
+        {
+          if (file > fileH) valid = false;
+          else
+          {
+            const manType man = MapCharToMan(ch);
+
+            PutMan(MapFileRankToSqr(file++, rank), man); mancount[man]++;
+          };
+        }
+        else
+        {
+          const ui digit = MapCharToDigit(ch);
+
+          if (!IsCharDigit(ch) || (digit == 0) || ((file + digit) > fileLen)) valid = false;
+          else
+            file += digit;
+        };
+      };
+      ch = *str++;
+    };
+    if (valid && ((rank != rank1) || !ch)) valid = false;
+  };
+
+  // The second field is the active color
+
+  if (valid)
+  {
+    while (IsCharBlank(*str)) str++;
+    ch = *str++;
+    if (!IsCharColor(ch) || !IsCharBlank(*str)) valid = false;
+    else
+      bytes[pposGoodIndex] = MapCharToColor(ch);
+  };
+
+  // The third field is the castling availability
+
+  if (valid)
+  {
+    while (IsCharBlank(*str)) str++;
+    if (*str == '-') str++;
+    else
+    {
+      if (!IsCharCast(*str)) valid = false;
+      while (valid && IsCharCast(*str))
+      {
+        const castType cast = MapCharToCast(*str++);
+
+        if (GetCsab() & BX(cast)) valid = false; else bytes[pposCsabIndex] |= BX(cast);
+      };
+    };
+    if (valid && !IsCharBlank(*str)) valid = false;
+  };
+
+  // The fourth field is the en passant target square
+
+  if (valid)
+  {
+    while (IsCharBlank(*str)) str++;
+    bytes[pposEpsqIndex] = (ui8) sqrNil;
+    if (*str == '-') str++;
+    else
+    {
+      if (!IsCharFile(str[0]) || !IsCharRank(str[1])) valid = false;
+      else
+      {
+        bytes[pposEpsqIndex] =
+          (ui8) MapFileRankToSqr(MapCharToFile(str[0]), MapCharToRank(str[1]));
+        str += 2;
+      };
+    };
+    if (valid && *str && !IsCharBlank(*str)) valid = false;
+  };
+
+  // The fifth and sixth fields are the counters; an EPD record goes without them
+
+  if (valid)
+  {
+    const char *cptr = str;
+
+    while (IsCharBlank(*cptr)) cptr++;
+    PutUi16(pposHmvcIndex, 0); PutUi16(pposFmvnIndex, 1);
+    if (IsDigitsToken(cptr))
+    {
+      const char *hmvcptr = cptr;
+
+      while (IsCharDigit(*cptr)) cptr++;
+      while (IsCharBlank(*cptr)) cptr++;
+      if (IsDigitsToken(cptr))
+      {
+        ui32 hmvc = 0, fmvn = 0;
+
+        while (IsCharDigit(*hmvcptr)) hmvc = (hmvc * 10) + MapCharToDigit(*hmvcptr++);
+        while (IsCharDigit(*cptr)) fmvn = (fmvn * 10) + MapCharToDigit(*cptr++);
+        if ((hmvc > 0xffff) || (fmvn > 0xffff)) valid = false;
+        else
+        {
+          PutUi16(pposHmvcIndex, (ui16) hmvc); PutUi16(pposFmvnIndex, (ui16) fmvn);
+          str = cptr;
+        };
+      };
+    };
+  };
+
+  // Validation using the man counts, then the rest of the text
+
+  if (valid && !IsValid(mancount)) valid = false;
+  if (valid && restptrptr)
+  {
+    while (IsCharBlank(*str)) str++;
+    *restptrptr = str;
+  };
+  return valid;
+}
+
+void PPos::LoadFromFPos(const FPos& fpos)
+{
+  // Load from a FEN position
+
+  Reset();
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++) PutMan(sqr, fpos.GetMan(sqr));
+  bytes[pposGoodIndex] = fpos.GetGood(); bytes[pposCsabIndex] = fpos.GetCsab();
+  bytes[pposEpsqIndex] = (ui8) fpos.GetEpsq();
+  PutUi16(pposHmvcIndex, fpos.GetHmvc()); PutUi16(pposFmvnIndex, fpos.GetFmvn());
+}
+
+void PPos::EncodeFEN(char *str) const
+{
+  // Encode as a FEN string; the string must have room for fenLen characters plus the NUL
+
+  for (rankType rank = rank8; rank >= rank1; rank--)
+  {
+    ui spaces = 0;
+
+    for (fileType file = 0; file < fileLen; file++)
+    {
+      const manType man = GetMan(MapFileRankToSqr(file, rank));
+
+      if (IsManVacant(man)) spaces++;
+      else
+      {
+        if (spaces) {*str++ = CharOfDigit(spaces); spaces = 0;};
+        *str++ = CharOfMan(man);
+      };
+    };
+    if (spaces) *str++ = CharOfDigit(spaces);
+    if (rank != rank1) *str++ = '/';
+  };
+
+  // Use FEN ordering for the castling availability
+
+  *str++ = ' '; *str++ = CharOfColor(GetGood()); *str++ = ' ';
+  if (GetCsab() == csabNone) *str++ = '-';
+  else
+  {
+    if (GetCsab() & csabWK) *str++ = CharOfCast(castWK);
+    if (GetCsab() & csabWQ) *str++ = CharOfCast(castWQ);
+    if (GetCsab() & csabBK) *str++ = CharOfCast(castBK);
+    if (GetCsab() & csabBQ) *str++ = CharOfCast(castBQ);
+  };
+  *str++ = ' ';
+  if (IsSqrNil(GetEpsq())) *str++ = '-';
+  else
+  {
+    *str++ = CharOfFile(MapSqrToFile(GetEpsq()));
+    *str++ = CharOfRank(MapSqrToRank(GetEpsq()));
+  };
+  str = EncodeUi16(EncodeUi16(str, GetHmvc()), GetFmvn()); *str = '\0';
+}
+
+bool PPos::IsValid(const ui mancount[manRLen]) const
+{
+  // Validity checking short of attack detection; the same rules as for a FEN position
+
+  bool valid = Board::IsValidManCounts(mancount);
+
+  // No pawns on the first rank or the last rank
+
+  for (fileType file = 0; valid && (file < fileLen); file++)
+    if ((cvmantopiece[GetMan(MapFileRankToSqr(file, rank1))] == piecePawn) ||
+      (cvmantopiece[GetMan(MapFileRankToSqr(file, rank8))] == piecePawn))
+      valid = false;
+
+  // The king and the rook of each castling must be on their home squares
+
+  for (castType cast = 0; valid && (cast < castLen); cast++)
+  {
+    if (GetCsab() & BX(cast))
+    {
+      const colorType color = cvcasttocolor[cast];
+
+      if ((GetMan(kinghomesqr[color]) != synthman[color][pieceKing]) ||
+        (GetMan(rookhomesqr[cast]) != synthman[color][pieceRook])) valid = false;
+    };
+  };
+
+  // En passant target: on the right rank with a zero half move counter, an empty target
+  // and predecessor square, and an enemy pawn on the right square
+
+  if (valid && IsSqrNotNil(GetEpsq()))
+  {
+    const colorType good = GetGood(), evil = OtherColor(good);
+    const sqrType epsq = GetEpsq();
+
+    if ((GetHmvc() != 0) || (MapSqrToRank(epsq) != r6rank[good]) ||
+      IsManNotVacant(GetMan(epsq)) || IsManNotVacant(GetMan(epsq - pawnadvdel[evil])) ||
+      (GetMan(epsq + pawnadvdel[evil]) != synthman[evil][piecePawn]))
+      valid = false;
+  };
+
+  // The full move number starts at one
+
+  if (valid && (GetFmvn() < 1)) valid = false;
+  return valid;
+}
+
+#endif
@@ -0,0 +1,80 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_PPos
+#define Included_PPos
+
+#if (IsDevHost)
+
+// Packed position record layout (all byte sized; multibyte values are little endian)
+
+#define pposBoardLen (sqrLen / 2)        // Board: one man per nybble, low nybble first
+#define pposGoodIndex (pposBoardLen + 0) // Active color
+#define pposCsabIndex (pposBoardLen + 1) // Castling availability bits
+#define pposEpsqIndex (pposBoardLen + 2) // En passant target square; 0xff if none
+#define pposHmvcIndex (pposBoardLen + 3) // Half move counter (two bytes)
+#define pposFmvnIndex (pposBoardLen + 5) // Full move number (two bytes)
+#define pposLen       (pposBoardLen + 8) // Record length; the last byte is reserved (zero)
+
+// Forward class declaration(s)
+
+class FPos;
+
+// Packed position class
+//
+// The PPos class is a compact (40 byte) position for bulk storage: the packed board
+// plus the FEN environment.  It is also the record of the binary position file format
+// and so it contains nothing but bytes.  A FEN or EPD record is parsed directly into a
+// packed position with the men counted along the way, so validation needs no further
+// pass over the board; the attack based checks are left to Pos::LoadPosFromPPos.
+
+class PPos
+{
+  public:
+    bool LoadFromStr(const char *str, const char **restptrptr);
+    void LoadFromFPos(const FPos& fpos);
+
+    void EncodeFEN(char *str) const;
+
+    manType GetMan(const sqrType sqr) const
+    {
+      return (bytes[sqr >> 1] >> ((sqr & 0x01) << 2)) & 0x0f;
+    }
+
+    colorType GetGood(void) const {return bytes[pposGoodIndex];}
+    csabType GetCsab(void) const {return bytes[pposCsabIndex];}
+    sqrType GetEpsq(void) const {return (sqrType) bytes[pposEpsqIndex];}
+    hmvcType GetHmvc(void) const {return GetUi16(pposHmvcIndex);}
+    fmvnType GetFmvn(void) const {return GetUi16(pposFmvnIndex);}
+
+  private:
+    void Reset(void);
+
+    void PutMan(const sqrType sqr, const manType man)
+    {
+      const ui shift = (sqr & 0x01) << 2;
+
+      bytes[sqr >> 1] = (bytes[sqr >> 1] & ~(0x0f << shift)) | (man << shift);
+    }
+
+    ui16 GetUi16(const ui index) const {return bytes[index] | (bytes[index + 1] << 8);}
+
+    void PutUi16(const ui index, const ui16 value)
+    {
+      bytes[index] = (ui8) value; bytes[index + 1] = (ui8) (value >> 8);
+    }
+
+    bool IsValid(const ui mancount[manRLen]) const;
+
+    ui8 bytes[pposLen];
+};
+
+#endif
+
+#endif
@@ -0,0 +1,269 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
+#include "PRF.h"
+
+#if (IsDevHost)
+#include "Counter.h"
+#include "MGS.h"
+#include "SSB.h"
+#endif
+
+#if (IsTarget && UseProfiler)
+unsigned long int TargetElapsedUsec(void);
+#endif
+
+// Host tick source selection
+
+#if (IsDevHost)
+#define PRFUseRDTSC (defined(__x86_64__) || defined(__i386__))
+#endif
+
+// Search statistics block attached to the thread, if any
+
+#if (IsDevHost)
+thread_local SSB *PRF::ssbptr = 0;
+#endif
+
+#if (IsDevHost || UseProfiler)
+prftType PRF::ReadTicks(void)
+{
+#if (IsDevHost)
+#if (PRFUseRDTSC)
+  return __builtin_ia32_rdtsc();
+#endif
+#if (!PRFUseRDTSC)
+  return (prftType) std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+#endif
+
+#if (IsTarget)
+  return TargetElapsedUsec();
+#endif
+}
+#endif
+
+#if (UseProfiler)
+
+// Phase names and tick unit
+
+static const char fsPrfpExecute[]    PROGMEM = "execute";
+static const char fsPrfpRetract[]    PROGMEM = "retract";
+static const char fsPrfpRegen[]      PROGMEM = "regen";
+static const char fsPrfpEvaluate[]   PROGMEM = "evaluate";
+static const char fsPrfpGenerate[]   PROGMEM = "generate";
+static const char fsPrfpRepetition[] PROGMEM = "repetition";
+
+static const char fsPrfCalls[]       PROGMEM = "calls";
+static const char fsPrfMean[]        PROGMEM = "mean";
+static const char fsPrfTicks[]       PROGMEM = "ticks";
+
+#if (IsDevHost)
+#if (PRFUseRDTSC)
+static const char fsPrfUnit[]        PROGMEM = "Profile (tick: cycle)\n";
+#endif
+#if (!PRFUseRDTSC)
+static const char fsPrfUnit[]        PROGMEM = "Profile (tick: nanosecond)\n";
+#endif
+#endif
+
+#if (IsTarget)
+static const char fsPrfUnit[]        PROGMEM = "Profile (tick: microsecond)\n";
+#endif
+
+// Profile data block: per phase call counts, tick totals, and log2 tick histograms
+
+typedef struct
+{
+  prftType calls[prfpLen];
+  prftType ticks[prfpLen];
+  prftType buckets[prfpLen][prfbLen];
+} PRFData;
+
+static void ResetData(PRFData& prfdata)
+{
+  for (ui prfp = 0; prfp < prfpLen; prfp++)
+  {
+    prfdata.calls[prfp] = prfdata.ticks[prfp] = 0;
+    for (ui prfb = 0; prfb < prfbLen; prfb++) prfdata.buckets[prfp][prfb] = 0;
+  };
+}
+
+#if (IsDevHost)
+
+// Host: one block per thread, registered for display; the blocks outlive their threads
+
+static std::mutex prfmutex;
+static std::vector<PRFData *> prfdatavec;
+static thread_local PRFData *prfdataptr = 0;
+
+static PRFData& FetchData(void)
+{
+  if (!prfdataptr)
+  {
+    prfdataptr = new PRFData; ResetData(*prfdataptr);
+
+    const std::lock_guard<std::mutex> lock(prfmutex);
+
+    prfdatavec.push_back(prfdataptr);
+  };
+  return *prfdataptr;
+}
+
+#endif
+
+#if (IsTarget)
+
+// Target: a single block
+
+static PRFData prfdata;
+static bool prfdatareset = false;
+
+static PRFData& FetchData(void)
+{
+  if (!prfdatareset) {ResetData(prfdata); prfdatareset = true;};
+  return prfdata;
+}
+
+#endif
+
+static void PrintPhase(const prfpType prfp)
+{
+  switch (prfp)
+  {
+    case prfpExecute:    PrintFS(fsPrfpExecute);    break;
+    case prfpRetract:    PrintFS(fsPrfpRetract);    break;
+    case prfpRegen:      PrintFS(fsPrfpRegen);      break;
+    case prfpEvaluate:   PrintFS(fsPrfpEvaluate);   break;
+    case prfpGenerate:   PrintFS(fsPrfpGenerate);   break;
+    case prfpRepetition: PrintFS(fsPrfpRepetition); break;
+    default: SwitchFault(); break;
+  };
+}
+
+static void PrintTicks(const prftType value)
+{
+  // Print a tick counter value; it may be wider than 32 bits
+
+  prftType residue = value;
+  ui count = 0;
+  char cv[20];
+
+  do {cv[count++] = residue % 10; residue /= 10;} while (residue);
+  while (count) PrintDigit(cv[--count]);
+}
+
+static void RecordData(const prfpType prfp, const prftType ticks)
+{
+  PRFData& prfdata = FetchData();
+  prftType residue = ticks;
+  ui prfb = 0;
+
+  // Locate the bucket: the integer log2 of the tick count, limited to the last bucket
+
+  while ((residue > 1) && (prfb < (prfbLen - 1))) {residue >>= 1; prfb++;};
+  prfdata.calls[prfp]++; prfdata.ticks[prfp] += ticks; prfdata.buckets[prfp][prfb]++;
+}
+
+void PRF::Reset(void)
+{
+#if (IsDevHost)
+  const std::lock_guard<std::mutex> lock(prfmutex);
+
+  for (ui index = 0; index < prfdatavec.size(); index++) ResetData(*prfdatavec[index]);
+#endif
+
+#if (IsTarget)
+  ResetData(FetchData());
+#endif
+}
+
+void PRF::Print(void)
+{
+  // Sum the data blocks, then print a line per phase followed by its nonempty buckets
+
+  PRFData sum;
+
+  ResetData(sum);
+
+#if (IsDevHost)
+  {
+    const std::lock_guard<std::mutex> lock(prfmutex);
+
+    for (ui index = 0; index < prfdatavec.size(); index++)
+    {
+      const PRFData& prfdata = *prfdatavec[index];
+
+      for (ui prfp = 0; prfp < prfpLen; prfp++)
+      {
+        sum.calls[prfp] += prfdata.calls[prfp]; sum.ticks[prfp] += prfdata.ticks[prfp];
+        for (ui prfb = 0; prfb < prfbLen; prfb++)
+          sum.buckets[prfp][prfb] += prfdata.buckets[prfp][prfb];
+      };
+    };
+  };
+#endif
+
+#if (IsTarget)
+  sum = FetchData();
+#endif
+
+  PrintFS(fsPrfUnit);
+  for (ui prfp = 0; prfp < prfpLen; prfp++)
+  {
+    PrintSpaces(2); PrintPhase((prfpType) prfp); PrintChar(':');
+    PrintSpace(); PrintFS(fsPrfCalls); PrintSpace(); PrintTicks(sum.calls[prfp]);
+    PrintSpace(); PrintFS(fsPrfTicks); PrintSpace(); PrintTicks(sum.ticks[prfp]);
+    PrintSpace(); PrintFS(fsPrfMean); PrintSpace();
+    PrintTicks(sum.calls[prfp] ? (sum.ticks[prfp] / sum.calls[prfp]) : 0);
+    PrintNL();
+    if (sum.calls[prfp])
+    {
+      PrintSpaces(3);
+      for (ui prfb = 0; prfb < prfbLen; prfb++)
+      {
+        if (sum.buckets[prfp][prfb])
+        {
+          PrintSpace(); PrintChar('2'); PrintChar('^'); PrintUi32(prfb); PrintChar(':');
+          PrintTicks(sum.buckets[prfp][prfb]);
+        };
+      };
+      PrintNL();
+    };
+  };
+}
+
+#endif
+
+#if (IsDevHost || UseProfiler)
+void PRF::Record(const prfpType prfp, const prftType ticks)
+{
+  // Record the ticks of a timed instrumentation point in the profile data and the attached
+  // search statistics block, if any
+
+#if (UseProfiler)
+  RecordData(prfp, ticks);
+#endif
+
+#if (IsDevHost && PRFHooked)
+  if (ssbptr) ssbptr->NotePhase(prfp, ticks);
+#endif
+}
+#endif
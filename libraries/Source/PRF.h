@@ -0,0 +1,124 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_PRF
+#define Included_PRF
+
+// Forward class declaration(s)
+
+#if (IsDevHost)
+class SSB;
+#endif
+
+// Profiled phases; on the host these are also the phases timed for the search statistics
+
+typedef enum
+{
+  prfpNil = -1,
+  prfpExecute,    // Pos::Execute (includes its regeneration)
+  prfpRetract,    // Pos::Retract
+  prfpRegen,      // Pos::Regen
+  prfpEvaluate,   // Pos::Evaluate
+  prfpGenerate,   // Move generation by the search
+  prfpRepetition  // History repetition checks
+} prfpType;
+
+#define prfpLen (prfpRepetition + 1)
+
+// Histogram bucket count; bucket N counts the calls taking 2^N to 2^(N+1)-1 ticks, and
+// the last bucket also counts all longer calls
+
+#define prfbLen 16
+
+// Tick counter type: cycles (x86 host), nanoseconds (other hosts), or microseconds (target)
+
+#if (IsDevHost)
+typedef ui64 prftType;
+#endif
+
+#if (IsTarget)
+typedef ui32 prftType;
+#endif
+
+// Profiler class
+//
+// The PRF class has only static members.  Each host thread gathers into its own data
+// block so that the worker pool tools can be profiled without locking; a display sums
+// the blocks of all threads.  The target has a single block.
+//
+// The instrumentation points are also the only phase timers of the host search statistics
+// block: a search attaches its block to its thread, and while a block is attached each
+// instrumentation point is timed and fed to it.  The points are compiled in only with the
+// profiler or (host only) the search statistics phase times; otherwise they are empty.
+
+#define PRFHooked (UseProfiler || (IsDevHost && UseSSBPhases))
+
+class PRF
+{
+  public:
+    static prftType ReadTicks(void);
+    static void Record(const prfpType prfp, const prftType ticks);
+
+#if (UseProfiler)
+    static void Reset(void);
+    static void Print(void);
+#endif
+
+#if (IsDevHost)
+    static void AttachSSB(SSB *ptr) {ssbptr = ptr;}
+    static bool IsTimed(void) {return UseProfiler || (ssbptr != 0);}
+
+  private:
+    static thread_local SSB *ssbptr;
+#endif
+};
+
+// Scoped instrumentation point; the elapsed ticks are recorded at scope exit
+
+#if (IsDevHost && PRFHooked)
+class PRFScope
+{
+  public:
+    PRFScope(const prfpType value)
+    {
+      prfp = value; timed = PRF::IsTimed(); if (timed) startticks = PRF::ReadTicks();
+    }
+    ~PRFScope(void) {if (timed) PRF::Record(prfp, PRF::ReadTicks() - startticks);}
+
+  private:
+    prfpType prfp;
+    bool timed;
+    prftType startticks;
+};
+
+#define PRFHook(prfp) const PRFScope prfscope(prfp)
+#endif
+
+#if (IsTarget && UseProfiler)
+class PRFScope
+{
+  public:
+    PRFScope(const prfpType value) {prfp = value; startticks = PRF::ReadTicks();}
+    ~PRFScope(void) {PRF::Record(prfp, PRF::ReadTicks() - startticks);}
+
+  private:
+    prfpType prfp;
+    prftType startticks;
+};
+
+#define PRFHook(prfp) const PRFScope prfscope(prfp)
+#endif
+
+// Instrumentation points compile to nothing when nothing gathers their times
+
+#if (!PRFHooked)
+#define PRFHook(prfp)
+#endif
+
+#endif
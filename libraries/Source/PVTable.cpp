@@ -18,6 +18,7 @@
 #include "Board.h"
 #include "Score.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "PVTable.h"
 
 PVTable::PVTable(void)
@@ -49,7 +50,7 @@ void PVTable::ResetTrace(void)
 {
   // Reset the trace triangle; this is potential PV move sequence data stored by ply
 
-  for (miType index = 0; index < PVTableLen; index++) trace[index].MakeVoid();
+  for (miType index = 0; index < PVTableLen; index++) trace[index].Reset();
 }
 
 void PVTable::CopyUpToPly(const plyType toply, const Move& move)
@@ -64,7 +65,7 @@ void PVTable::CopyUpToPly(const plyType toply, const Move& move)
 
     // Copy up the first move of the new PV sequence
 
-    trace[toindex++] = move;
+    trace[toindex++].ConvertFromMove(move);
 
     // Copy the remainder of the PV if the source is within the compile time limit
 
@@ -77,28 +78,18 @@ void PVTable::CopyUpToPly(const plyType toply, const Move& move)
 
     // Ensure void move termination of the new PV sequence
 
-    trace[toindex++].MakeVoid();
+    trace[toindex++].Reset();
   };
 }
 
-void PVTable::CopyToPrior(const svType sv)
+void PVTable::SavePrior(Move moves[MaxPVLenP1]) const
 {
-  // The prior PV is updated via a copy of the ply zero PV from the trace data
-
-  plyType index = 0;
-
-  while ((index < MaxPVLen) && trace[index].IsNotVoid())
-  {
-    prior[index] = trace[index]; index++;
-  };
-
-  // Because of various referencing of the prior PV, *all* trailing data *must* be void
-
-  while (index < MaxPVLen) prior[index++].MakeVoid();
-
-  // Finally, add the score data to the first move to give the score result of the search
+  for (plyType ply = 0; ply < MaxPVLenP1; ply++) moves[ply] = prior[ply];
+}
 
-  prior[0].PutSv(sv);
+void PVTable::RestorePrior(const Move moves[MaxPVLenP1])
+{
+  for (plyType ply = 0; ply < MaxPVLenP1; ply++) prior[ply] = moves[ply];
 }
 
 void PVTable::SetSingleMovePV(const Move& move)
@@ -15,6 +15,9 @@
 #define PVTableLen (((MaxPVLen * MaxPVLen) + (MaxPVLen * 3)) / 2)
 
 // Predicted variation table class
+//
+// The trace triangle holds tiny moves; a full prior PV move is decoded from its trace move
+// in the position where it is played.
 
 class PVTable
 {
@@ -32,10 +35,17 @@ class PVTable
 
     Move *GetPVBase(void) {return prior;}
 
-    void ClearAtPly(const plyType ply) {if (ply < MaxPVLen) trace[bases[ply]].MakeVoid();}
+    void SavePrior(Move moves[MaxPVLenP1]) const;
+    void RestorePrior(const Move moves[MaxPVLenP1]);
+
+    void ClearAtPly(const plyType ply) {if (ply < MaxPVLen) trace[bases[ply]].Reset();}
     void CopyUpToPly(const plyType frply, const Move& move);
 
-    void CopyToPrior(const svType sv);
+    bool IsTraceMove(const plyType ply) const {return (ply < MaxPVLen) && trace[ply].IsNotVoid();}
+    void LoadPriorMove(const plyType ply, const Board& board)
+    {
+      trace[ply].ConvertToMove(prior[ply], board);
+    }
 
     void SetSingleMovePV(const Move& move);
 
@@ -44,9 +54,9 @@ class PVTable
     void PrintPVAndScore(const FEnv& fenv) const;
 
   private:
-    Move prior[MaxPVLenP1]; // This is the result of prior analysis
-    Move trace[PVTableLen]; // A triangular semi-matrix with ply indexed PV moves
-    miType bases[MaxPVLen]; // Bases used to address ply indexed trace move data
+    Move prior[MaxPVLenP1];     // This is the result of prior analysis
+    TinyMove trace[PVTableLen]; // A triangular semi-matrix with ply indexed PV moves
+    miType bases[MaxPVLen];     // Bases used to address ply indexed trace move data
 };
 
 #endif
@@ -13,22 +13,54 @@
 
 #if (IsDevHost)
 #include <cassert>
+#include <cstddef>
 #endif
 
 #include "Board.h"
 #include "FEnv.h"
 #include "FPos.h"
+#include "PPos.h"
 #include "Move.h"
 #include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
+#include "PRF.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "NNE.h"
+#include "MTE.h"
+#include "MT.h"
 #include "Pos.h"
 
+#if (IsDevHost)
+void Pos::CheckLayout(void)
+{
+  // Layout checks: with a line aligned position, the board fills the first cache line, the
+  // target bit vectors directly follow the environments and end within the third line, and
+  // the whole position (less the neural network accumulators) stays within five lines
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+  static_assert(sizeof(Board) == CacheLineLen, "Pos: board layout");
+  static_assert(
+    offsetof(Pos, targettbv) == (sizeof(Board) + sizeof(FEnv) + sizeof(PEnv)),
+    "Pos: target bit vector offset");
+  static_assert(
+    (offsetof(Pos, tbvbm) + sizeof(tbvbm)) ==
+      (offsetof(Pos, targettbv) + (sizeof(TBV) * (2 + colorRLen + manRLen))),
+    "Pos: target bit vector packing");
+  static_assert(
+    (offsetof(Pos, tbvbm) + sizeof(tbvbm)) <= (3 * CacheLineLen), "Pos: hot member layout");
+  static_assert(sizeof(Pos) <= (sizeof(NNAcc) + (5 * CacheLineLen)), "Pos: size");
+  static_assert((alignof(Pos) % alignof(NNAcc)) == 0, "Pos: alignment");
+#pragma GCC diagnostic pop
+}
+#endif
+
 void Pos::Reset(void)
 {
   // Reset the base classes
@@ -40,7 +72,10 @@ void Pos::Reset(void)
   for (manType man = 0; man < manRLen; man++) {mcbm[man] = 0; tbvbm[man].Reset();};
   for (colorType color = 0; color < colorRLen; color++)
   {
-    mcbc[color] = 0; msbc[color] = svEven; tbvbc[color].Reset();
+    mcbc[color] = 0; msbc[color] = svEven; msigbc[color] = 0; tbvbc[color].Reset();
+#if (IsDevHost)
+    bbbc[color] = 0;
+#endif
   };
   for (sqrType sqr = 0; sqr < sqrLen; sqr++) sqrtotid[sqr] = tidNil;
   for (tidType tid = 0; tid < tidLen; tid++) tidtosqr[tid] = sqrNil;
@@ -63,27 +98,55 @@ void Pos::LoadPosFromFPos(const FPos& fpos)
 
   // Scan the FEN position board and load the men
 
-  for (sqrType sqr = 0; sqr < sqrLen; sqr++)
-  {
-    // For a given square, get the man and its color
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++) LoadMan(sqr, fpos.GetMan(sqr), tids);
+  LoadFinish();
+}
+
+#if (IsDevHost)
+bool Pos::LoadPosFromPPos(const PPos& ppos)
+{
+  // Load the position directly from a packed position; return false if the passive color
+  // king is attacked or if the active color king has more than two attackers
 
-    const manType man = fpos.GetMan(sqr);
-    const colorType color = cvmantocolor[man];
+  tidType tids[colorRLen];
 
-    // Was a man found?
+  // Reset the position then set the FEN environment data
 
-    if (IsColorNotVacant(color))
-    {
-      // Add the man to the position; kings get special target ID treatment
+  Reset();
+  SetGood(ppos.GetGood()); PutCsab(ppos.GetCsab()); PutEpsq(ppos.GetEpsq());
+  PutHmvc(ppos.GetHmvc()); PutFmvn(ppos.GetFmvn());
 
-      if (IsManKing(man))
-        AddMan(sqr, man, cvcolortokingtid[color]);
-      else
-        AddMan(sqr, man, tids[color]++);
-    };
+  // Initialize the target ID assignment counter pair
+
+  for (colorType color = 0; color < colorRLen; color++) tids[color] = (color * troopLen) + 1;
+
+  // Scan the packed board and load the men
+
+  for (sqrType sqr = 0; sqr < sqrLen; sqr++) LoadMan(sqr, ppos.GetMan(sqr), tids);
+  LoadFinish();
+
+  return !GoodAttacksSquare(LocateEvilKing()) && (checkercount <= 2);
+}
+#endif
+
+void Pos::LoadMan(const sqrType sqr, const manType man, tidType tids[colorRLen])
+{
+  // Add a man, if any, while loading a position; kings get special target ID treatment
+
+  const colorType color = cvmantocolor[man];
+
+  if (IsColorNotVacant(color))
+  {
+    if (IsManKing(man))
+      AddMan(sqr, man, cvcolortokingtid[color]);
+    else
+      AddMan(sqr, man, tids[color]++);
   };
+}
 
-  // Handle the castling hash codes
+void Pos::LoadFinish(void)
+{
+  // Finish loading a position after the men have been added: castling hash codes first
 
   for (castType cast = 0; cast < castLen; cast++) if (TestCast(cast)) pdhash.FoldCast(cast);
 
@@ -94,6 +157,12 @@ void Pos::LoadPosFromFPos(const FPos& fpos)
   // Regenerate the checking data and the pinned/frozen target bit vectors
 
   Regen();
+
+#if (IsDevHost)
+  // Recalculate the neural network accumulators, if in use
+
+  if (nneptr) nneptr->Refresh(nnacc, *this);
+#endif
 }
 
 void Pos::SetInitialArray(void)
@@ -105,6 +174,16 @@ void Pos::SetInitialArray(void)
   fpos.SetInitialArray(); LoadPosFromFPos(fpos);
 }
 
+#if (IsDevHost)
+void Pos::AttachNNE(const NNE *ptr)
+{
+  // Attach (or detach, if null) a neural network evaluator; accumulators are recalculated
+
+  nneptr = ptr; nnhold = false;
+  if (nneptr) nneptr->Refresh(nnacc, *this);
+}
+#endif
+
 void Pos::Flip(void)
 {
   // Flip the position by exchanging colors and status
@@ -241,10 +320,10 @@ void Pos::PrintBookMoveList(const ML& priorml)
 
     for (miType index = 0; index < ml.GetCount(); index++)
     {
-      if (ml.FetchMove(index).IsBook())
+      if (ml.IsBook(index))
       {
         ml.FetchMove(index).Print(*this); PrintSpace();
-        PrintChar('('); PrintUi16(ml.FetchMove(index).GetSv());
+        PrintChar('('); PrintUi16(ml.GetSv(index));
         PrintChar('/'); PrintUi16(popsum);
         PrintChar(')'); PrintNL();
       };
@@ -252,22 +331,21 @@ void Pos::PrintBookMoveList(const ML& priorml)
   };
 }
 
-bool Pos::HasSufficientWhite(void) const
+void Pos::FetchMTE(MTE& mte) const
 {
-  // Does White have sufficient checkmating material?
+  // Fetch the material table entry for the current man counts
 
-  return
-    mcbm[manWhitePawn] || mcbm[manWhiteRook] || mcbm[manWhiteQueen] ||
-    ((mcbm[manWhiteKnight] + mcbm[manWhiteBishop]) > 1);
+  MT::FetchMTE(msigbc[colorWhite], msigbc[colorBlack], mte);
 }
 
-bool Pos::HasSufficientBlack(void) const
+bool Pos::IsDrawInsufficient(void) const
 {
-  // Does Black have sufficient checkmating material?
+  // Does neither side have sufficient checkmating material?
 
-  return
-    mcbm[manBlackPawn] || mcbm[manBlackRook] || mcbm[manBlackQueen] ||
-    ((mcbm[manBlackKnight] + mcbm[manBlackBishop]) > 1);
+  MTE mte;
+
+  FetchMTE(mte);
+  return mte.IsDraw();
 }
 
 bool Pos::IsLikelyDraw(const History& history) const
@@ -335,13 +413,14 @@ bool Pos::IsLoseIn1AfterMove(const Move& move, const ML& priorml)
   Gen(ml);
   while (!islosing && (index < ml.GetCount()))
   {
+    const Move reply = ml.FetchMove(index);
     FEnv fenv1;
     tidType capttid1;
     PEnv penv1;
 
-    Execute(ml.FetchMove(index), fenv1, capttid1, penv1);
+    Execute(reply, fenv1, capttid1, penv1);
     if (IsCheckmate()) islosing = true;
-    Retract(ml.FetchMove(index), fenv1, capttid1, penv1);
+    Retract(reply, fenv1, capttid1, penv1);
     index++;
   };
   Retract(move, fenv0, capttid0, penv0);
@@ -350,6 +429,8 @@ bool Pos::IsLoseIn1AfterMove(const Move& move, const ML& priorml)
 
 void Pos::Regen(void)
 {
+  PRFHook(prfpRegen);
+
   // Collect and record checking data
 
   CalcColorAttacksToSquare(GetEvil(), LocateGoodKing(), checkertbv);
@@ -458,7 +539,7 @@ void Pos::MatchMove(const char *str, Move& move, const ML& priorml)
 
   ML ml(priorml);
 
-  GenMarked(ml); ml.MatchMove(str, move);
+  Gen(ml); ml.MarkDisambiguation(*this); ml.MatchMove(str, move, *this);
 }
 
 bool Pos::IsSane(void) const
@@ -634,40 +715,3 @@ bool Pos::IsSane(void) const
 
   return okay;
 }
-
-// Score values for pawn placement; white then black
-
-const si8 Pos::pawnplacement[colorsqrLen] PROGMEM =
-{
-    0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0, -20, -20,   0,   0,   0,
-   10,  10,  10,  20,  20,  10,  10,  10,
-   15,  15,  15,  40,  40,  15,  15,  15,
-   30,  30,  40,  60,  60,  40,  30,  30,
-   50,  60,  70,  80,  80,  70,  60,  50,
-   70,  80,  90, 100, 100,  90,  80,  70,
-    0,   0,   0,   0,   0,   0,   0,   0,
-
-    0,   0,   0,   0,   0,   0,   0,   0,
-   70,  80,  90, 100, 100,  90,  80,  70,
-   50,  60,  70,  80,  80,  70,  60,  50,
-   30,  30,  40,  60,  60,  40,  30,  30,
-   15,  15,  15,  40,  40,  15,  15,  15,
-   10,  10,  10,  20,  20,  10,  10,  10,
-    0,   0,   0, -20, -20,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0
-};
-
-// Score values for knight center tropism
-
-const si8 Pos::knightcentertropism[sqrLen] PROGMEM =
-{
-  -24, -16,  -8,   0,   0,  -8, -16, -24,
-  -16,  -8,   0,   8,   8,   0,  -8, -16,
-   -8,   0,   8,  16,  16,   8,   0,  -8,
-    0,   8,  16,  24,  24,  16,   8,   0,
-    0,   8,  16,  24,  24,  16,   8,   0,
-   -8,   0,   8,  16,  16,   8,   0,  -8,
-  -16,  -8,   0,   8,   8,   0,  -8, -16,
-  -24, -16,  -8,   0,   0,  -8, -16, -24,
-};
@@ -12,15 +12,28 @@
 
 // Formard class declaration(s)
 
+class EEnv;
+class EPV;
 class History;
+class MTE;
+class NNE;
+class PPos;
 
 // General position class
 
-class Pos: public FPos, public PEnv
+class PosAlignment Pos: public FPos, public PEnv
 {
   public:
+#if (IsDevHost)
+    Pos(void) {nneptr = 0; nnhold = false;}
+#endif
+
     void LoadPosFromFPos(const FPos& fpos);
 
+#if (IsDevHost)
+    bool LoadPosFromPPos(const PPos& ppos);
+#endif
+
     void SetInitialArray(void);
 
     ui8 GetManCountByColor(const colorType color) const {return mcbc[color];}
@@ -60,7 +73,20 @@ class Pos: public FPos, public PEnv
     void CalcColorAttacksToSquare(
       const colorType color, const sqrType tosqr, TBV& attackertbv) const;
 
-    svType Evaluate(void);
+#if (IsDevHost)
+    void AttachNNE(const NNE *ptr);
+    bool UsesNNE(void) const {return nneptr != 0;}
+
+    const NNAcc& FetchNNAcc(void) const {return nnacc;}
+    void HoldNNAcc(void) {nnhold = true;}
+    void RestoreNNAcc(const NNAcc& acc) {nnacc = acc; nnhold = false;}
+#endif
+
+    svType Evaluate(const EPV& epv) const;
+
+#if (IsDevHost)
+    svType Evaluate(const EPV& epv, si32 coefs[]) const;
+#endif
 
     void Execute(const Move& move);
     void Execute(const Move& move, FEnv& fenv, tidType& tid, PEnv& penv);
@@ -70,15 +96,17 @@ class Pos: public FPos, public PEnv
 
     void GenAddNonEvasionFromSquare(const genmType genm, const sqrType frsqr, ML& ml) const;
     void GenNonEvasion(const genmType genm, ML& ml) const;
+    void GenNonEvasionByPiece(const genmType genm, ML& ml) const;
     void GenNonEvasion(ML& ml) const;
     void GenEvasion(ML& ml) const;
 
     void Gen(ML& ml) const;
-    void GenMarked(ML& ml);
     void GenCanonical(ML& ml);
 
     miType CountMoves(void) const;
 
+    bool IsHolderLegal(const Move& move) const;
+
     void PrintMoves(const ML& priorml);
     void PrintBookMoveList(const ML& priorml);
 
@@ -110,12 +138,22 @@ class Pos: public FPos, public PEnv
   private:
     void Reset(void);
 
-    svType EvaluatePawn(void) const;
-    svType EvaluateKnight(void) const;
-    svType EvaluateBishop(void) const;
-    svType EvaluateRook(void) const;
-    svType EvaluateQueen(void) const;
-    svType EvaluateKing(void) const;
+    void LoadMan(const sqrType sqr, const manType man, tidType tids[colorRLen]);
+    void LoadFinish(void);
+
+    svType Weigh(const EEnv& eenv, const epType ep, const si count) const;
+
+    svType EvaluatePawn(const EEnv& eenv) const;
+    svType EvaluateKnight(const EEnv& eenv) const;
+    svType EvaluateBishop(const EEnv& eenv) const;
+    svType EvaluateRook(const EEnv& eenv) const;
+    svType EvaluateQueen(const EEnv& eenv) const;
+    svType EvaluateKing(const EEnv& eenv) const;
+    svType EvaluateAux(const MTE& mte, EEnv& eenv) const;
+
+    svType EvaluateEndgame(const MTE& mte) const;
+
+    static ui CalcKingDistance(const sqrType frsqr, const sqrType tosqr);
 
     sqrType LocateKing(const colorType color) const {return colortrooptosqr[color][troopKing];}
     sqrType LocateGoodKing(void) const {return LocateKing(GetGood());}
@@ -155,14 +193,23 @@ class Pos: public FPos, public PEnv
     bool NoMovesNonEvasion(void) const;
     bool NoMovesEvasion(void) const;
 
-    bool HasSufficientWhite(void) const;
-    bool HasSufficientBlack(void) const;
-    bool HasSufficient(void) const {return HasSufficientWhite() || HasSufficientBlack();}
+#if (IsDevHost)
+    ui64 CalcColorAttackMask(const colorType color, const ui64 occupied) const;
+
+    miType CountMovesPawnBB(const sqrType frsqr, const ui64 occupied, const ui64 tomask) const;
+    miType CountMovesBB(const bool anyflag) const;
+
+    miType CountMovesByGen(void) const;
+
+    static void CheckLayout(void);
+#endif
+
+    void FetchMTE(MTE& mte) const;
 
     bool IsRepeated(const History& history) const;
 
     bool IsDrawFiftyMoves(void) const {return GetHmvc() >= (Fifty * colorRLen);};
-    bool IsDrawInsufficient(void) const {return !HasSufficient();}
+    bool IsDrawInsufficient(void) const;
     bool IsDrawRepetition(const History& history) const;
     bool IsDrawStalemate(void) const {return IsStalemate();};
 
@@ -171,17 +218,40 @@ class Pos: public FPos, public PEnv
       return IsDrawFiftyMoves() || IsDrawInsufficient() || IsDrawRepetition(history);
     }
 
-    static const si8 pawnplacement[colorsqrLen] PROGMEM;
-    static const si8 knightcentertropism[sqrLen] PROGMEM;
+    // The target bit vectors follow the FPos and PEnv bases; on the host the board fills the
+    // first cache line and the environments plus these sixteen 32 bit vectors share the next
+    // two.  They are read by nearly every generation and attack detection routine.
+
+    TBV targettbv;        // All men target bit vector
+    TBV sweepertbv;       // Sweeper men only target bit vector
+    TBV tbvbc[colorRLen]; // Target bit vectors indexed by color
+
+    union
+    {
+      TBV tbvbm[manRLen]; // Target bit vectors indexed by man
+      TBV tbvbcp[colorRLen][pieceRLen]; // And by color/piece
+    };
+
+#if (IsDevHost)
+    ui64 bbbc[colorRLen]; // Occupancy bitboards indexed by color
+#endif
+
+    Hash pdhash; // Position data hash
+
+    svType msbc[colorRLen]; // Material scores by color
 
     ui8 mcbc[colorRLen]; // Man counts indexed by color
 
+    msigType msigbc[colorRLen]; // Material signatures indexed by color
+
     union
     {
       ui8 mcbm[manRLen]; // Man counts indexed by man
       ui8 mcbcp[colorRLen][pieceRLen]; // And by color/piece
     };
 
+    tidType capttid; // Target ID of the last captured man
+
     tidType sqrtotid[sqrLen]; // Map of target IDs indexed by square
 
     union
@@ -190,26 +260,11 @@ class Pos: public FPos, public PEnv
       sqrType colortrooptosqr[colorRLen][troopLen]; // And by color/troop
     };
 
-    TBV targettbv;        // All men target bit vector
-    TBV sweepertbv;       // Sweeper men only target bit vector
-    TBV tbvbc[colorRLen]; // Target bit vectors indexed by color
-
-    union
-    {
-      TBV tbvbm[manRLen]; // Target bit vectors indexed by man
-      TBV tbvbcp[colorRLen][pieceRLen]; // And by color/piece
-    };
-
-    svType msbc[colorRLen]; // Material scores by color
-
-    Hash pdhash; // Position data hash
-
-    tidType capttid; // Target ID of the last captured man
-
-    colorType thiscolor, thatcolor;    // Evaluation colors
-    sqrType thissqr;                   // Evaluation square
-    tidType thistid;                   // Evaluation target ID
-    ui8 filepawns[colorRLen][fileLen]; // Evaluation pawn counts per file/color
+#if (IsDevHost)
+    const NNE *nneptr; // Neural network evaluator, if in use
+    bool nnhold;       // Neural network accumulator updates suspended
+    NNAcc nnacc;       // Neural network accumulators
+#endif
 };
 
 #endif
@@ -22,10 +22,12 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
 miType Pos::CountMovesNonEvasionFromSquarePawn(const sqrType frsqr) const
@@ -373,5 +375,17 @@ miType Pos::CountMovesEvasion(void) const
 
 miType Pos::CountMoves(void) const
 {
+#if (IsDevHost)
+  const miType count = CountMovesBB(false);
+
+#if (BBCrossCheck)
+  assert(count == CountMovesByGen());
+#endif
+
+  return count;
+#endif
+
+#if (IsTarget)
   return (InCheck() ? CountMovesEvasion() : CountMovesNonEvasion());
+#endif
 }
@@ -0,0 +1,217 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#endif
+
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "ML.h"
+#include "Hash.h"
+#include "TBV.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "Pos.h"
+
+#if (IsDevHost)
+
+// Bitboard (one bit per square) move counting; host only
+//
+// The legal moves are counted from attack masks without generating any moves: the check
+// and pin data kept by the position restrict each man's destination mask (a pinned man
+// stays on its pin line, a single check limits destinations to the checker and the
+// interposition squares) and the destinations are then counted by population count.
+
+ui64 Pos::CalcColorAttackMask(const colorType color, const ui64 occupied) const
+{
+  // Return the squares attacked by the men of a color for the given occupancy
+
+  TBV scantbv = tbvbc[color];
+  tidType scantid;
+  ui64 mask = 0;
+
+  while (IsTidNotNil(scantid = scantbv.NextTid()))
+  {
+    const sqrType frsqr = tidtosqr[scantid];
+    const manType frman = GetMan(frsqr);
+
+    switch (cvmantopiece[frman])
+    {
+      case piecePawn:   mask |= Board::FetchPawnAttackMask(color, frsqr); break;
+      case pieceKnight: mask |= Board::FetchKnightMask(frsqr); break;
+      case pieceKing:   mask |= Board::FetchKingMask(frsqr); break;
+
+      case pieceBishop:
+      case pieceRook:
+      case pieceQueen:
+        for (dirType dir = mands0dir[frman]; dir <= mands1dir[frman]; dir++)
+          mask |= Board::CalcSweepMask(frsqr, dir, occupied);
+        break;
+
+      default: SwitchFault(); break;
+    };
+  };
+  return mask;
+}
+
+miType Pos::CountMovesPawnBB(const sqrType frsqr, const ui64 occupied, const ui64 tomask) const
+{
+  // Count the pawn moves from a square, excluding en passant; promotions count once per piece;
+  // the destination mask already excludes squares of the pawn's own color
+
+  const rankType frrank = MapSqrToRank(frsqr);
+  const miType multiplier = (frrank == r7rank[GetGood()]) ? promLen : 1;
+  const sqrType tosqr1 = frsqr + pawnadvdel[GetGood()];
+  const ui64 tobit1 = ((ui64) 1) << tosqr1;
+  miType count = 0;
+
+  // Pawn advancement, including promotion
+
+  if (!(occupied & tobit1))
+  {
+    if (tomask & tobit1) count += multiplier;
+    if (frrank == r2rank[GetGood()])
+    {
+      const ui64 tobit2 = ((ui64) 1) << (tosqr1 + pawnadvdel[GetGood()]);
+
+      if (!(occupied & tobit2) && (tomask & tobit2)) count++;
+    };
+  };
+
+  // Pawn capturing, including promotion
+
+  count +=
+    multiplier * (miType) __builtin_popcountll(
+      Board::FetchPawnAttackMask(GetGood(), frsqr) & occupied & tomask);
+
+  return count;
+}
+
+miType Pos::CountMovesBB(const bool anyflag) const
+{
+  // Count the legal moves; if the flag is set, stop counting once a move is found
+
+  const sqrType kingsqr = LocateGoodKing();
+  const ui64 kingbit = ((ui64) 1) << kingsqr;
+  const ui64 goodmask = bbbc[GetGood()];
+  const ui64 evilmask = bbbc[GetEvil()];
+  const ui64 occupied = goodmask | evilmask;
+  miType count = 0;
+
+  // King moves first; the king is removed so it can't hide in its own shadow
+
+  const ui64 evilattackmask = CalcColorAttackMask(GetEvil(), occupied & ~kingbit);
+
+  count +=
+    (miType) __builtin_popcountll(Board::FetchKingMask(kingsqr) & ~goodmask & ~evilattackmask);
+
+  // All other men can move only if not in double check
+
+  if (!(anyflag && count) && (checkercount < 2))
+  {
+    ui64 targetmask = ~goodmask;
+    TBV scantbv = tbvbc[GetGood()];
+    tidType scantid;
+
+    // A single check restricts destinations to the checker and any interposition squares
+
+    if (checkercount == 1)
+    {
+      const sqrType checkersqr = tidtosqr[checkertbv.FirstTid()];
+
+      targetmask &= Board::FetchBetweenMask(kingsqr, checkersqr) | (((ui64) 1) << checkersqr);
+    };
+
+    // Scan the men other than the king
+
+    scantbv.ResetTid(cvcolortokingtid[GetGood()]);
+    while (!(anyflag && count) && IsTidNotNil(scantid = scantbv.NextTid()))
+    {
+      // Frozen men are unmovable; pinned men stay on the line through the king
+
+      if (!frozentbv.TestTid(scantid))
+      {
+        const sqrType frsqr = tidtosqr[scantid];
+        const manType frman = GetMan(frsqr);
+        const ui64 tomask = pinnedtbv.TestTid(scantid) ?
+          (targetmask & Board::FetchLineMask(kingsqr, frsqr)) : targetmask;
+
+        switch (cvmantopiece[frman])
+        {
+          case piecePawn:
+            count += CountMovesPawnBB(frsqr, occupied, tomask);
+            break;
+
+          case pieceKnight:
+            count += (miType) __builtin_popcountll(Board::FetchKnightMask(frsqr) & tomask);
+            break;
+
+          case pieceBishop:
+          case pieceRook:
+          case pieceQueen:
+            {
+              ui64 attackmask = 0;
+
+              for (dirType dir = mands0dir[frman]; dir <= mands1dir[frman]; dir++)
+                attackmask |= Board::CalcSweepMask(frsqr, dir, occupied);
+              count += (miType) __builtin_popcountll(attackmask & tomask);
+            };
+            break;
+
+          default: SwitchFault(); break;
+        };
+      };
+    };
+
+    // En passant captures; the full test also handles any discovered or remaining check
+
+    if (!(anyflag && count) && IsEpsqNotNil())
+    {
+      const manType goodpawnman = GoodMan(piecePawn);
+
+      for (flankType flank = 0; flank < flankLen; flank++)
+      {
+        const sqrType frsqr = Board::FetchNextSquare(GetEpsq(), pawncapdir[GetEvil()][flank]);
+
+        if (IsSqrNotNil(frsqr) && (GetMan(frsqr) == goodpawnman) &&
+          IsEnPassantLegal(frsqr, kingsqr))
+          count++;
+      };
+    };
+
+    // Castling
+
+    if (!(anyflag && count) && !InCheck() && IsSomeCastling())
+      for (flankType flank = 0; flank < flankLen; flank++)
+        if (IsCastlingLegal(cvcolorflanktocast[GetGood()][flank])) count++;
+  };
+
+  return count;
+}
+
+miType Pos::CountMovesByGen(void) const
+{
+  // Count the legal moves by full generation; used only for cross-checking
+
+  MLStore mlstore;
+  ML ml(mlstore, *this);
+
+  Gen(ml);
+  return ml.GetCount();
+}
+
+#endif
@@ -0,0 +1,97 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#endif
+
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "ML.h"
+#include "Hash.h"
+#include "TBV.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "MTE.h"
+#include "KPK.h"
+#include "Pos.h"
+
+ui Pos::CalcKingDistance(const sqrType frsqr, const sqrType tosqr)
+{
+  // The number of king steps between two squares
+
+  const ui absfiledelta = CalcAbsFileDelta(frsqr, tosqr);
+  const ui absrankdelta = CalcAbsRankDelta(frsqr, tosqr);
+
+  return (absfiledelta > absrankdelta) ? absfiledelta : absrankdelta;
+}
+
+svType Pos::EvaluateEndgame(const MTE& mte) const
+{
+  // Evaluate with a specialized endgame evaluator from the good player's point of view
+
+  const colorType strong = mte.GetEgColor(), weak = OtherColor(strong);
+  const sqrType strongksqr = LocateKing(strong), weakksqr = LocateKing(weak);
+  const ui kingdistance = CalcKingDistance(strongksqr, weakksqr);
+  svType sv;
+
+  switch (mte.GetEgid())
+  {
+    case egidKXK:
+      {
+        // Drive the bare king to the rim with the other king close by
+
+        sv =
+          svKnownWin + msbc[strong] + (FetchCenterTropismDistance(weakksqr) / 4) +
+          ((7 - kingdistance) * 8);
+      };
+      break;
+
+    case egidKBNK:
+      {
+        // Drive the bare king into a corner of the same color as the bishop
+
+        const sqrType bishopsqr = tidtosqr[tbvbcp[strong][pieceBishop].FirstTid()];
+        const bool islight = IsSqrWhite(bishopsqr);
+        const ui cornerdistance0 = CalcKingDistance(weakksqr, islight ? sqrH1 : sqrA1);
+        const ui cornerdistance1 = CalcKingDistance(weakksqr, islight ? sqrA8 : sqrH8);
+        const ui cornerdistance =
+          (cornerdistance0 < cornerdistance1) ? cornerdistance0 : cornerdistance1;
+
+        sv = svKnownWin + msbc[strong] + ((7 - cornerdistance) * 20) + ((7 - kingdistance) * 8);
+      };
+      break;
+
+#if (IsDevHost)
+    case egidKPK:
+      {
+        // Probe the bitbase from the pawn side's point of view as White
+
+        const ui flip = IsColorWhite(strong) ? 0x00 : 0x38;
+        const sqrType psqr = tidtosqr[tbvbcp[strong][piecePawn].FirstTid()] ^ flip;
+
+        if (KPK::IsWin(IsColorGood(strong), strongksqr ^ flip, weakksqr ^ flip, psqr))
+          sv = svKnownWin + svPawn + (MapSqrToRank(psqr) * 10);
+        else
+          sv = svEven;
+      };
+      break;
+#endif
+
+    default: sv = svEven; SwitchFault(); break;
+  };
+  return IsColorGood(strong) ? sv : -sv;
+}
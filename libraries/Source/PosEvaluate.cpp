@@ -19,115 +19,151 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
+#include "PRF.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "NNE.h"
+#include "EPV.h"
+#include "MTE.h"
+#include "EEnv.h"
 #include "Pos.h"
 
-svType Pos::EvaluatePawn(void) const
+inline svType Pos::Weigh(const EEnv& eenv, const epType ep, const si count) const
 {
+  // Apply a weight to a term count; the coefficient is also recorded if tuning
+
+#if (IsDevHost)
+  if (eenv.GetCoefPtr())
+    eenv.GetCoefPtr()[ep] += IsColorGood(eenv.GetThisColor()) ? count : -count;
+#endif
+
+  return (svType) (eenv.FetchEPV().GetParm(ep) * count);
+}
+
+svType Pos::EvaluatePawn(const EEnv& eenv) const
+{
+  const colorType thiscolor = eenv.GetThisColor();
+  const sqrType thissqr = eenv.GetThisSqr();
   svType pscore = svEven;
 
   // Basic placement
 
-  pscore += (svType) ReadFlashSi8(pawnplacement + (thiscolor << 6) + thissqr);
+  pscore +=
+    Weigh(eenv, epPawnPlacementBase + (IsColorWhite(thiscolor) ? thissqr : OtherSqr(thissqr)), 1);
 
   // Multiple penalty
 
-  if (filepawns[thiscolor][MapSqrToFile(thissqr)] > 1) pscore += -(svCP * 15);
+  if (eenv.GetFilePawns(thiscolor, MapSqrToFile(thissqr)) > 1)
+    pscore += Weigh(eenv, epPawnMultiple, 1);
 
   return pscore;
 }
 
-svType Pos::EvaluateKnight(void) const
+svType Pos::EvaluateKnight(const EEnv& eenv) const
 {
+  const colorType thatcolor = eenv.GetThatColor();
+  const sqrType thissqr = eenv.GetThisSqr();
+  const tidType thistid = eenv.GetThisTid();
   const sdbType sdb = FetchSDB(thissqr, LocateKing(thatcolor));
   svType pscore = svEven;
 
   // Rim penalty
 
-  if (IsRimSqr(thissqr)) pscore += -(svCP * 12);
+  if (IsRimSqr(thissqr)) pscore += Weigh(eenv, epKnightRim, 1);
 
   // Center tropism
 
-  pscore += ReadFlashSi8(knightcentertropism + thissqr) / 2;
+  pscore += Weigh(eenv, epKnightCenterBase + thissqr, 1);
 
   // Other color king tropism
 
-  pscore += (MapSdbToSumFR(sdb) - 7) * -(svCP * 4);
+  pscore += Weigh(eenv, epKnightKingTropism, MapSdbToSumFR(sdb) - 7);
 
   // Mobility
 
   if (pinnedtbv.TestTid(thistid))
-    pscore += -(svCP * 20);
+    pscore += Weigh(eenv, epKnightPinned, 1);
   else
-    pscore += (CountAttacksFromSquare(thissqr) - 5) * (svCP * 4);
+    pscore += Weigh(eenv, epKnightMobility, CountAttacksFromSquare(thissqr) - 5);
 
   return pscore;
 }
 
-svType Pos::EvaluateBishop(void) const
+svType Pos::EvaluateBishop(const EEnv& eenv) const
 {
+  const sqrType thissqr = eenv.GetThisSqr();
+  const tidType thistid = eenv.GetThisTid();
   svType pscore = svEven;
 
   // Rim penalty
 
-  if (IsRimSqr(thissqr)) pscore += -(svCP * 10);
+  if (IsRimSqr(thissqr)) pscore += Weigh(eenv, epBishopRim, 1);
 
   // Mobility
 
   if (pinnedtbv.TestTid(thistid))
-    pscore += -(svCP * 20);
+    pscore += Weigh(eenv, epBishopPinned, 1);
   else
-    pscore += (CountAttacksFromSquare(thissqr) - 6) * (svCP * 3);
+    pscore += Weigh(eenv, epBishopMobility, CountAttacksFromSquare(thissqr) - 6);
 
   return pscore;
 }
 
-svType Pos::EvaluateRook(void) const
+svType Pos::EvaluateRook(const EEnv& eenv) const
 {
+  const colorType thiscolor = eenv.GetThisColor();
+  const colorType thatcolor = eenv.GetThatColor();
+  const sqrType thissqr = eenv.GetThisSqr();
+  const tidType thistid = eenv.GetThisTid();
   svType pscore = svEven;
 
   // Mobility
 
   if (pinnedtbv.TestTid(thistid))
-    pscore += -(svCP * 25);
+    pscore += Weigh(eenv, epRookPinned, 1);
   else
-    pscore += (CountAttacksFromSquare(thissqr) - 7) * (svCP * 2);
+    pscore += Weigh(eenv, epRookMobility, CountAttacksFromSquare(thissqr) - 7);
 
   // Open/semi-open file bonus
 
   const fileType file = MapSqrToFile(thissqr);
-  const ui pc0 = filepawns[thiscolor][file], pc1 = filepawns[thatcolor][file];
+  const ui pc0 = eenv.GetFilePawns(thiscolor, file), pc1 = eenv.GetFilePawns(thatcolor, file);
 
-  if ((pc0 + pc1) == 0) pscore += (svCP * 20);
+  if ((pc0 + pc1) == 0) pscore += Weigh(eenv, epRookOpenFile, 1);
   else
-    if (pc0 == 0) pscore += (svCP * 15);
+    if (pc0 == 0) pscore += Weigh(eenv, epRookSemiOpenFile, 1);
 
   return pscore;
 }
 
-svType Pos::EvaluateQueen(void) const
+svType Pos::EvaluateQueen(const EEnv& eenv) const
 {
+  const sqrType thissqr = eenv.GetThisSqr();
+  const tidType thistid = eenv.GetThisTid();
   svType pscore = svEven;
 
   // Rim penalty
 
-  if (IsRimSqr(thissqr)) pscore += -(svCP * 8);
+  if (IsRimSqr(thissqr)) pscore += Weigh(eenv, epQueenRim, 1);
 
   // Mobility
 
   if (pinnedtbv.TestTid(thistid))
-    pscore += -(svCP * 30);
+    pscore += Weigh(eenv, epQueenPinned, 1);
   else
-    pscore += (CountAttacksFromSquare(thissqr) - 11) * svCP;
+    pscore += Weigh(eenv, epQueenMobility, CountAttacksFromSquare(thissqr) - 11);
 
   return pscore;
 }
 
-svType Pos::EvaluateKing(void) const
+svType Pos::EvaluateKing(const EEnv& eenv) const
 {
+  const colorType thatcolor = eenv.GetThatColor();
+  const sqrType thissqr = eenv.GetThisSqr();
   svType pscore = svEven;
 
   // Center tropism based on other color material
@@ -140,7 +176,7 @@ svType Pos::EvaluateKing(void) const
   return pscore;
 }
 
-svType Pos::Evaluate(void)
+svType Pos::EvaluateAux(const MTE& mte, EEnv& eenv) const
 {
   svType pscores[colorRLen];
 
@@ -148,14 +184,12 @@ svType Pos::Evaluate(void)
 
   for (ui colorindex = 0; colorindex < colorRLen; colorindex++)
   {
-    for (ui fileindex = 0; fileindex < fileLen; fileindex++)
-      filepawns[colorindex][fileindex] = 0;
-
     TBV pawntbv = tbvbcp[colorindex][piecePawn];
     tidType pawntid;
 
+    eenv.ResetFilePawns((colorType) colorindex);
     while (IsTidNotNil(pawntid = pawntbv.NextTid()))
-      filepawns[colorindex][MapSqrToFile(tidtosqr[pawntid])]++;
+      eenv.IncFilePawns((colorType) colorindex, MapSqrToFile(tidtosqr[pawntid]));
   };
 
   // Calculate positional score components for each color
@@ -164,33 +198,36 @@ svType Pos::Evaluate(void)
   {
     // Assign evaluation colors
 
-    thiscolor = (colorType) colorindex; thatcolor = OtherColor(thiscolor);
-    pscores[thiscolor] = svEven;
+    const colorType thiscolor = (colorType) colorindex;
+
+    eenv.PutThisColor(thiscolor); pscores[thiscolor] = svEven;
 
     // Calculate positional score components for one color
 
     TBV scantbv = tbvbc[thiscolor];
+    tidType thistid;
 
     // Scan through each target ID of the current color
 
     while (IsTidNotNil(thistid = scantbv.NextTid()))
     {
+      const sqrType thissqr = tidtosqr[thistid];
       svType pscore;
 
-      // Set the evaluation square
+      // Set the evaluation square and target ID
 
-      thissqr = tidtosqr[thistid];
+      eenv.PutThisSqr(thissqr); eenv.PutThisTid(thistid);
 
       // Process evaluation according to piece kind
 
       switch (GetPiece(thissqr))
       {
-        case piecePawn:   pscore = EvaluatePawn();   break;
-        case pieceKnight: pscore = EvaluateKnight(); break;
-        case pieceBishop: pscore = EvaluateBishop(); break;
-        case pieceRook:   pscore = EvaluateRook();   break;
-        case pieceQueen:  pscore = EvaluateQueen();  break;
-        case pieceKing:   pscore = EvaluateKing();   break;
+        case piecePawn:   pscore = EvaluatePawn(eenv);   break;
+        case pieceKnight: pscore = EvaluateKnight(eenv); break;
+        case pieceBishop: pscore = EvaluateBishop(eenv); break;
+        case pieceRook:   pscore = EvaluateRook(eenv);   break;
+        case pieceQueen:  pscore = EvaluateQueen(eenv);  break;
+        case pieceKing:   pscore = EvaluateKing(eenv);   break;
         default: pscore = 0; SwitchFault(); break;
       };
 
@@ -202,14 +239,73 @@ svType Pos::Evaluate(void)
 
   // Apply the on-the-move bonus
 
-  pscores[GetGood()] += svPawn / 10;
+  eenv.PutThisColor(GetGood()); pscores[GetGood()] += Weigh(eenv, epOnMove, 1);
 
   // Combine the material and the positional score components
 
   const svType goodscore = msbc[GetGood()] + pscores[GetGood()];
   const svType evilscore = msbc[GetEvil()] + pscores[GetEvil()];
 
+  // Apply the material table imbalance correction
+
+  svType sv = goodscore - evilscore;
+
+  sv += IsColorWhite(GetGood()) ? mte.GetImbalance() : -mte.GetImbalance();
+
+  // Scale down drawish material; tuning skips this to keep the evaluation linear
+
+#if (IsDevHost)
+  if (!eenv.GetCoefPtr())
+#endif
+  {
+    ui scale = mte.GetScale((sv > 0) ? GetGood() : GetEvil());
+
+    if (mte.IsBishops())
+    {
+      const sqrType sqr0 = tidtosqr[tbvbcp[colorWhite][pieceBishop].FirstTid()];
+      const sqrType sqr1 = tidtosqr[tbvbcp[colorBlack][pieceBishop].FirstTid()];
+
+      if (CalcSqrColor(sqr0) != CalcSqrColor(sqr1)) scale /= 2;
+    };
+    if (scale != mtsFull) sv = (svType) (((si32) sv * (si32) scale) / mtsFull);
+  };
+
   // Return the evaluation from the good player's point of view
 
-  return goodscore - evilscore;
+  return sv;
+}
+
+svType Pos::Evaluate(const EPV& epv) const
+{
+  PRFHook(prfpEvaluate);
+
+  // Evaluate the position with a specialized endgame evaluator if the material selects one
+
+  MTE mte;
+
+  FetchMTE(mte);
+  if (mte.GetEgid() != egidNone) return EvaluateEndgame(mte);
+
+  // Otherwise use the given weights, or the neural network if in use
+
+#if (IsDevHost)
+  if (nneptr) return nneptr->Evaluate(nnacc, GetGood());
+#endif
+
+  EEnv eenv(epv);
+
+  return EvaluateAux(mte, eenv);
+}
+
+#if (IsDevHost)
+svType Pos::Evaluate(const EPV& epv, si32 coefs[]) const
+{
+  // Evaluate the position using the given weights; also add the weight coefficients
+
+  MTE mte;
+  EEnv eenv(epv);
+
+  FetchMTE(mte); eenv.PutCoefPtr(coefs);
+  return EvaluateAux(mte, eenv);
 }
+#endif
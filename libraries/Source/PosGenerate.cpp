@@ -22,10 +22,12 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
 void Pos::GenAddNonEvasionFromSquarePawn(
@@ -291,11 +293,103 @@ void Pos::GenNonEvasion(const genmType genm, ML& ml) const
   TBV scantbv = tbvbc[GetGood()];
   tidType scantid;
 
-  ml.ResetCount();
+  ml.ResetCount(); ml.BindBoard(*this);
   while (IsTidNotNil(scantid = scantbv.NextTid()))
     GenAddNonEvasionFromSquare(genm, tidtosqr[scantid], ml);
 }
 
+void Pos::GenNonEvasionByPiece(const genmType genm, ML& ml) const
+{
+  // Generate by piece kind (pawns first) and then by target ID
+
+  ml.ResetCount(); ml.BindBoard(*this);
+  for (pieceType piece = piecePawn; piece <= pieceKing; piece++)
+  {
+    TBV scantbv = tbvbcp[GetGood()][piece];
+    tidType scantid;
+
+    while (IsTidNotNil(scantid = scantbv.NextTid()))
+      GenAddNonEvasionFromSquare(genm, tidtosqr[scantid], ml);
+  };
+}
+
+bool Pos::IsHolderLegal(const Move& move) const
+{
+  // Test a holder move from elsewhere in the tree for legality here; not for evasion nodes
+
+  const sqrType frsqr = move.GetFrSqr(), tosqr = move.GetToSqr();
+  const manType frman = GetMan(frsqr);
+  bool legal = false;
+
+  if ((frman == move.GetFrMan()) && (cvmantocolor[frman] == GetGood()) && move.IsHolder())
+  {
+    if (move.IsCastling())
+    {
+      const castType cast = cvcolorflanktocast[GetGood()][cvmsctoflank[move.GetMsc()]];
+
+      legal = IsSomeCastling() && IsCastlingLegal(cast) && (tosqr == kingawaysqr[cast]);
+    }
+    else
+    {
+      const tidType tid = sqrtotid[frsqr];
+
+      if (move.IsRegular() && IsOccupantVacant(tosqr) && !frozentbv.TestTid(tid))
+      {
+        const bool pinflag = pinnedtbv.TestTid(tid);
+        const bdrType bdr =
+          (pinflag ? cvsweepdirtobdr[Board::ExtractDirection(LocateGoodKing(), frsqr)] : bdrNil);
+
+        switch (cvmantopiece[frman])
+        {
+          case piecePawn:
+            if ((!pinflag || (bdr == bdrN)) && (MapSqrToRank(frsqr) != r7rank[GetGood()]))
+            {
+              const sqrType sqr1 = Board::FetchNextSquare(frsqr, pawnadvdir[GetGood()]);
+
+              if (tosqr == sqr1) legal = true;
+              else
+                legal =
+                  (MapSqrToRank(frsqr) == r2rank[GetGood()]) && IsOccupantVacant(sqr1) &&
+                  (tosqr == Board::FetchNextSquare(sqr1, pawnadvdir[GetGood()]));
+            };
+            break;
+
+          case pieceKnight:
+            {
+              const ui filedelta = CalcAbsFileDelta(frsqr, tosqr);
+              const ui rankdelta = CalcAbsRankDelta(frsqr, tosqr);
+
+              legal =
+                ((filedelta == 1) && (rankdelta == 2)) || ((filedelta == 2) && (rankdelta == 1));
+            };
+            break;
+
+          case pieceBishop:
+          case pieceRook:
+          case pieceQueen:
+            {
+              const dirType dir = Board::ExtractDirection(frsqr, tosqr);
+
+              legal =
+                IsDirSweep(dir) && (dir >= mands0dir[frman]) && (dir <= mands1dir[frman]) &&
+                (!pinflag || (cvsweepdirtobdr[dir] == bdr)) && IsClearPath(frsqr, tosqr, dir);
+            };
+            break;
+
+          case pieceKing:
+            legal = CalcAdjacent(frsqr, tosqr) && !EvilAttacksSquare(tosqr);
+            break;
+
+          default:
+            SwitchFault();
+            break;
+        };
+      };
+    };
+  };
+  return legal;
+}
+
 void Pos::GenEvasion(ML& ml) const
 {
   const tidType goodkingtid = cvcolortokingtid[GetGood()];
@@ -307,7 +401,7 @@ void Pos::GenEvasion(ML& ml) const
   const sqrType checkersqr = (singlecheck ? tidtosqr[checkertid] : sqrNil);
   const manType checkerman = (singlecheck ? GetMan(checkersqr) : manNil);
 
-  ml.ResetCount();
+  ml.ResetCount(); ml.BindBoard(*this);
 
   // Capture single checker, but not with the king
 
@@ -528,6 +622,4 @@ void Pos::Gen(ML& ml) const
   if (InCheck()) GenEvasion(ml); else GenNonEvasion(ml);
 }
 
-void Pos::GenMarked(ML& ml) {Gen(ml); ml.MarkNotation(*this);}
-
-void Pos::GenCanonical(ML& ml) {GenMarked(ml); ml.SortBySAN();}
+void Pos::GenCanonical(ML& ml) {Gen(ml); ml.MarkNotation(*this); ml.SortBySAN();}
@@ -19,10 +19,14 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
+#include "PRF.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "NNE.h"
 #include "Pos.h"
 
 void Pos::AddMan(const sqrType sqr, const manType man, const tidType tid)
@@ -32,10 +36,16 @@ void Pos::AddMan(const sqrType sqr, const manType man, const tidType tid)
   const colorType color = cvmantocolor[man];
 
   PutMan(sqr, man);
+  if (mcbm[man] < cvmantomsigcap[man]) msigbc[color] += cvmantomsigstep[man];
   mcbc[color]++; mcbm[man]++; msbc[color] += cvmantosv[man];
   sqrtotid[sqr] = tid; tidtosqr[tid] = sqr; targettbv.SetTid(tid);
   if (sweeperflag[man]) sweepertbv.SetTid(tid);
   tbvbc[color].SetTid(tid); tbvbm[man].SetTid(tid); pdhash.FoldManSqr(man, sqr);
+
+#if (IsDevHost)
+  bbbc[color] |= ((ui64) 1) << sqr;
+  if (nneptr && !nnhold) nneptr->AddFeature(nnacc, man, sqr);
+#endif
 }
 
 void Pos::DelMan(const sqrType sqr)
@@ -48,9 +58,15 @@ void Pos::DelMan(const sqrType sqr)
 
   ResetMan(sqr);
   --mcbc[color]; --mcbm[man]; msbc[color] -= cvmantosv[man];
+  if (mcbm[man] < cvmantomsigcap[man]) msigbc[color] -= cvmantomsigstep[man];
   sqrtotid[sqr] = tidNil; tidtosqr[tid] = sqrNil; targettbv.ResetTid(tid);
   if (sweeperflag[man]) sweepertbv.ResetTid(tid);
   tbvbc[color].ResetTid(tid); tbvbm[man].ResetTid(tid); pdhash.FoldManSqr(man, sqr);
+
+#if (IsDevHost)
+  bbbc[color] &= ~(((ui64) 1) << sqr);
+  if (nneptr && !nnhold) nneptr->DelFeature(nnacc, man, sqr);
+#endif
 }
 
 void Pos::MoveMan(const sqrType frsqr, const sqrType tosqr)
@@ -63,10 +79,17 @@ void Pos::MoveMan(const sqrType frsqr, const sqrType tosqr)
   Board::MoveMan(frsqr, tosqr);
   sqrtotid[frsqr] = tidNil; sqrtotid[tosqr] = tid; tidtosqr[tid] = tosqr;
   pdhash.FoldManSqrSqr(man, frsqr, tosqr);
+
+#if (IsDevHost)
+  bbbc[cvmantocolor[man]] ^= (((ui64) 1) << frsqr) | (((ui64) 1) << tosqr);
+  if (nneptr && !nnhold) nneptr->MoveFeature(nnacc, man, frsqr, tosqr);
+#endif
 }
 
 void Pos::Execute(const Move& move)
 {
+  PRFHook(prfpExecute);
+
   const sqrType frsqr = move.GetFrSqr(), tosqr = move.GetToSqr();
   const mscType msc = move.GetMsc();
   const bool null = move.IsNull();
@@ -199,6 +222,8 @@ void Pos::Execute(const Move& move, FEnv& fenv, tidType& tid, PEnv& penv)
 
 void Pos::Retract(const Move& move, const FEnv& fenv, const tidType savedtid)
 {
+  PRFHook(prfpRetract);
+
   const csabType savedcsab = GetCsab();
   const sqrType savedepsq = GetEpsq();
 
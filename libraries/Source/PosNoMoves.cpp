@@ -22,10 +22,12 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "ML.h"
 #include "Hash.h"
 #include "TBV.h"
 #include "PEnv.h"
+#include "NNAcc.h"
 #include "Pos.h"
 
 bool Pos::NoMovesNonEvasionFromSquarePawn(const sqrType frsqr) const
@@ -343,5 +345,17 @@ bool Pos::NoMovesEvasion(void) const
 
 bool Pos::NoMoves(void) const
 {
+#if (IsDevHost)
+  const bool nomoves = (CountMovesBB(true) == 0);
+
+#if (BBCrossCheck)
+  assert(nomoves == (CountMovesByGen() == 0));
+#endif
+
+  return nomoves;
+#endif
+
+#if (IsTarget)
   return (InCheck() ? NoMovesEvasion() : NoMovesNonEvasion());
+#endif
 }
@@ -0,0 +1,469 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+#include "Score.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "SAN.h"
+#include "UnDo.h"
+#include "UnDoStack.h"
+#include "ML.h"
+#include "MoveStack.h"
+#include "Hash.h"
+#include "BookMove.h"
+#include "Book.h"
+#include "History.h"
+#include "TBV.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
+#include "Pos.h"
+#include "PVTable.h"
+#include "PIR.h"
+#include "Search.h"
+#include "State.h"
+#include "TBP.h"
+#include "BPL.h"
+#include "WPL.h"
+#include "SPM.h"
+
+// Opening library line length limit and game length limit (adjudicated as a draw)
+
+#define SPMBookPly 8
+#define SPMGamePly 500
+
+// Sequential probability ratio test: Elo hypotheses and error rates
+
+#define SPMSprtElo0  0.0
+#define SPMSprtElo1  5.0
+#define SPMSprtAlpha 0.05
+#define SPMSprtBeta  0.05
+
+// PGN movetext line length limit
+
+#define SPMLineLen 79
+
+// Program configuration
+
+typedef struct
+{
+  std::string spec;      // Configuration as given
+  std::string evalfn;    // Evaluation weight file (if any)
+  std::string networkfn; // Neural network file (if any)
+  std::string tbdir;     // Tablebase directory (if any)
+} SPMConfig;
+
+// Opening: the start position and the opening library moves (if any) that follow it
+
+typedef struct
+{
+  FPos fpos;
+  std::vector<Move> moves;
+  bool setup; // The start position is not the initial array
+} SPMOpening;
+
+// Per game result
+
+typedef struct
+{
+  std::string pgn; // PGN game text
+  ui points;       // Half points scored by configuration A
+} SPMResult;
+
+// Match work shared by the workers
+
+typedef struct
+{
+  const SPMConfig *configs;
+  const std::vector<SPMOpening> *openingvecptr;
+  std::vector<SPMResult> *resultvecptr;
+  msType limitmsec;
+  plyType limitply;
+  ui32 limitnodes;
+} SPMWork;
+
+static bool ParseConfig(const char *spec, SPMConfig& config)
+{
+  // Parse a configuration: "-" or a comma separated list of items
+
+  std::istringstream iss(spec);
+  std::string item;
+  bool valid = true;
+
+  config.spec = spec;
+  if (config.spec != "-")
+  {
+    while (valid && std::getline(iss, item, ','))
+    {
+      const std::string value = (item.size() > 2) ? item.substr(2) : "";
+
+      if ((item.size() < 3) || (item[1] != '=')) valid = false;
+      else
+      {
+        switch (item[0])
+        {
+          case 'e': config.evalfn = value; break;
+          case 'n': config.networkfn = value; break;
+          case 't': config.tbdir = value; break;
+          default: valid = false; break;
+        };
+      };
+    };
+  };
+  if (!valid) std::cerr << "Bad configuration: " << spec << '\n';
+  return valid;
+}
+
+static bool SetupState(State& state, const SPMConfig& config, const SPMWork& work)
+{
+  // Set up a program instance: the limits, no opening library book (the openings are
+  // played beforehand), and the configuration
+
+  bool okay = true;
+
+  state.OneTimeSetup(); state.SetOption(optnNL);
+  state.PutLimitMsec(work.limitmsec); state.PutLimitPly(work.limitply);
+  state.PutLimitNodes(work.limitnodes);
+  if (okay && !config.evalfn.empty()) okay = state.RefEPV().LoadFromFile(config.evalfn.c_str());
+  if (okay && !config.networkfn.empty())
+  {
+    okay = state.LoadNetwork(config.networkfn.c_str());
+    if (okay) state.SetOption(optnNN);
+  };
+  if (okay && !config.tbdir.empty())
+  {
+    okay = state.LoadTablebases(config.tbdir.c_str(), tbpMenLen);
+    if (okay) state.SetOption(optnTB);
+  };
+  return okay;
+}
+
+static void MakeBookOpening(Pos& pos, SPMOpening& opening)
+{
+  // Follow a random opening library line from the initial array
+
+  bool inbook = true;
+
+  opening.fpos.SetInitialArray(); opening.setup = false;
+  pos.LoadPosFromFPos(opening.fpos);
+  while (inbook && (opening.moves.size() < SPMBookPly))
+  {
+    MLStore mlstore;
+    ML ml(mlstore, pos);
+
+    pos.Gen(ml);
+
+    const miType index = Book::PickBookMove(ml, pos);
+
+    if (index < 0) inbook = false;
+    else
+    {
+      const Move move = ml.FetchMove(index);
+
+      opening.moves.push_back(move); pos.Execute(move);
+    };
+  };
+}
+
+static void AppendToken(std::string& movetext, ui& linelen, const std::string& token)
+{
+  // Append a movetext token, starting a new line as needed
+
+  if (linelen && ((linelen + 1 + token.size()) > SPMLineLen)) {movetext += '\n'; linelen = 0;};
+  if (linelen) {movetext += ' '; linelen++;};
+  movetext += token; linelen += (ui) token.size();
+}
+
+static void PlayGame(const SPMWork& work, State *stateptrs[], Pos& pos, const ui32 gameindex)
+{
+  // Play one game; configuration A has White in the first game of each pair and Black in
+  // the second
+
+  const SPMOpening& opening = (*work.openingvecptr)[gameindex / 2];
+  const ui whiteconfig = gameindex % 2;
+  SPMResult& result = (*work.resultvecptr)[gameindex];
+  std::string movetext, resultstr;
+  ui linelen = 0, ply = 0;
+
+  for (ui config = 0; config < 2; config++) stateptrs[config]->LoadStateFromFPos(opening.fpos);
+  while (!stateptrs[0]->IsOver() && (ply < SPMGamePly))
+  {
+    MLStore mlstore;
+    ML ml(mlstore, pos);
+    Move move;
+
+    // An opening library move or a search by the configuration on the move
+
+    pos.LoadPosFromFPos(stateptrs[0]->FetchSearchFPos());
+    if (ply < opening.moves.size()) move = opening.moves[ply];
+    else
+    {
+      const ui config = pos.IsWTM() ? whiteconfig : (1 - whiteconfig);
+
+      stateptrs[config]->RunABSearch(); move = stateptrs[config]->PVMove(0);
+    };
+
+    // Record the move with full notation, then play it for both configurations
+
+    Move markedmove = move;
+
+    markedmove.Mark(pos, ml);
+
+    if (pos.IsWTM() || (ply == 0))
+      AppendToken(
+        movetext, linelen, std::to_string(pos.GetFmvn()) + (pos.IsWTM() ? "." : "..."));
+    AppendToken(movetext, linelen, SAN(markedmove).FetchStr());
+    for (ui config = 0; config < 2; config++) stateptrs[config]->Play(markedmove);
+    ply++;
+  };
+
+  // Score the game from the point of view of configuration A
+
+  if (stateptrs[0]->CalcFT() != ftCheckmate) {resultstr = "1/2-1/2"; result.points = 1;}
+  else
+  {
+    const bool whitewins = stateptrs[0]->FetchSearchFPos().IsBTM();
+
+    resultstr = whitewins ? "1-0" : "0-1";
+    result.points = (whitewins == (whiteconfig == 0)) ? 2 : 0;
+  };
+  AppendToken(movetext, linelen, resultstr);
+
+  // Assemble the PGN game text
+
+  std::ostringstream oss;
+  const SPMConfig& white = work.configs[whiteconfig];
+  const SPMConfig& black = work.configs[1 - whiteconfig];
+
+  oss << "[Event \"Myopic self-play match\"]\n";
+  oss << "[Site \"?\"]\n";
+  oss << "[Date \"????.??.??\"]\n";
+  oss << "[Round \"" << (gameindex + 1) << "\"]\n";
+  oss << "[White \"A " << white.spec << "\"]\n";
+  oss << "[Black \"B " << black.spec << "\"]\n";
+  oss << "[Result \"" << resultstr << "\"]\n";
+  if (opening.setup)
+  {
+    PPos ppos;
+    char fen[fenLen + 1];
+
+    ppos.LoadFromFPos(opening.fpos); ppos.EncodeFEN(fen);
+    oss << "[SetUp \"1\"]\n";
+    oss << "[FEN \"" << fen << "\"]\n";
+  };
+  if (!stateptrs[0]->IsOver()) oss << "[Termination \"adjudication\"]\n";
+  oss << '\n' << movetext << "\n\n";
+  result.pgn = oss.str();
+}
+
+// Match worker: each pool thread has its own instance of each configuration
+
+class SPMWorker
+{
+  public:
+    SPMWorker(const SPMWork& value);
+    ~SPMWorker(void);
+
+    void Run(const ui32 index) {PlayGame(work, stateptrs, *posptr, index);}
+
+  private:
+    const SPMWork& work;
+    State *stateptrs[2];
+    Pos *posptr;
+};
+
+SPMWorker::SPMWorker(const SPMWork& value): work(value)
+{
+  posptr = new Pos;
+  for (ui config = 0; config < 2; config++)
+  {
+    stateptrs[config] = new State;
+
+    // The configurations were checked before the workers started
+
+    const bool setup = SetupState(*stateptrs[config], work.configs[config], work);
+
+    assert(setup); (void) setup;
+  };
+}
+
+SPMWorker::~SPMWorker(void)
+{
+  for (ui config = 0; config < 2; config++) delete stateptrs[config];
+  delete posptr;
+}
+
+static double CalcElo(const double score) {return 400.0 * log10(score / (1.0 - score));}
+
+static double CalcEloScore(const double elo) {return 1.0 / (1.0 + pow(10.0, -elo / 400.0));}
+
+static void PrintSummary(const ui32 wins, const ui32 draws, const ui32 losses)
+{
+  // Report the score of configuration A with its Elo difference and the SPRT status; the
+  // log likelihood ratio uses the normal approximation of the game score distribution
+
+  const ui32 count = wins + draws + losses;
+  const double score = (wins + (draws / 2.0)) / count;
+  const double variance =
+    ((wins * pow(1.0 - score, 2.0)) + (draws * pow(0.5 - score, 2.0)) +
+      (losses * pow(score, 2.0))) / count;
+
+  std::cout << "  Games: " << count << '\n';
+  std::cout << "  A wins: " << wins << "   Draws: " << draws << "   A losses: " << losses << '\n';
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "  A score: " << (score * 100.0) << "%\n";
+  if ((score > 0.0) && (score < 1.0))
+  {
+    const double margin = 1.96 * sqrt(variance / count);
+    const double lo = ((score - margin) > 0.0) ? CalcElo(score - margin) : -INFINITY;
+    const double hi = ((score + margin) < 1.0) ? CalcElo(score + margin) : INFINITY;
+
+    std::cout << "  A Elo difference: " << CalcElo(score) <<
+      "   95% interval: [" << lo << ", " << hi << "]\n";
+  }
+  else
+    std::cout << "  A Elo difference: unbounded\n";
+
+  const double score0 = CalcEloScore(SPMSprtElo0), score1 = CalcEloScore(SPMSprtElo1);
+  const double lower = log(SPMSprtBeta / (1.0 - SPMSprtAlpha));
+  const double upper = log((1.0 - SPMSprtBeta) / SPMSprtAlpha);
+  const double llr =
+    (variance > 0.0) ?
+      ((count * (score1 - score0) * ((2.0 * score) - score0 - score1)) / (2.0 * variance)) :
+      0.0;
+
+  std::cout << std::setprecision(2);
+  std::cout << "  SPRT (Elo " << SPMSprtElo0 << " vs " << SPMSprtElo1 << "): LLR " << llr <<
+    "   bounds: [" << lower << ", " << upper << "]   " <<
+    ((llr >= upper) ? "H1 accepted" : ((llr <= lower) ? "H0 accepted" : "continue")) << '\n';
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+bool SPM::RunMatch(
+  const State *stateptr, const ui32 gamecount, const char *speca, const char *specb,
+  const char *pgnfn, const ui32 limitnodes, const char *posfn)
+{
+  // Run a match; a node limit replaces the time limit.  The depth limit applies.  The
+  // openings come from the position file if one is given, else from the opening library.
+
+  const msType startmsec = ElapsedMsec();
+  SPMConfig configs[2];
+  std::vector<SPMOpening> openingvec((gamecount + 1) / 2);
+  SPMWork work;
+  bool okay = ParseConfig(speca, configs[0]) && ParseConfig(specb, configs[1]);
+
+  work.configs = configs; work.openingvecptr = &openingvec;
+  work.limitmsec = limitnodes ? msInfinite : stateptr->GetLimitMsec();
+  work.limitply = stateptr->GetLimitPly(); work.limitnodes = limitnodes;
+
+  // Check each configuration by setting up one instance; this also completes any one-time
+  // initialization shared by the instances before the workers start
+
+  for (ui config = 0; okay && (config < 2); config++)
+  {
+    State *checkptr = new State;
+
+    okay = SetupState(*checkptr, configs[config], work);
+    delete checkptr;
+  };
+
+  // Make the openings
+
+  if (okay)
+  {
+    Pos *posptr = new Pos;
+
+    if (posfn)
+    {
+      BPL bpl;
+
+      okay = bpl.LoadFile(posfn);
+      if (okay && (bpl.GetCount() == 0)) {std::cerr << "No usable positions\n"; okay = false;};
+      for (ui32 index = 0; okay && (index < openingvec.size()); index++)
+      {
+        openingvec[index].fpos.LoadFromPPos(bpl.FetchPPos(index % bpl.GetCount()));
+        openingvec[index].setup = true;
+      };
+    }
+    else
+      for (ui32 index = 0; index < openingvec.size(); index++)
+        MakeBookOpening(*posptr, openingvec[index]);
+    delete posptr;
+  };
+
+  // Play the games
+
+  if (okay)
+  {
+    std::vector<SPMResult> resultvec(gamecount);
+    std::ofstream ofs(pgnfn);
+
+    if (ofs.fail()) {std::cerr << "Can't open PGN output file\n"; okay = false;};
+    if (okay)
+    {
+      work.resultvecptr = &resultvec;
+
+      const ui workercount = WPL::RunPool<SPMWorker>(gamecount, 0, work);
+
+      // Write the games in order, then report
+
+      const msType wallmsec = ElapsedMsec() - startmsec;
+      ui32 wins = 0, draws = 0, losses = 0;
+
+      for (ui32 index = 0; index < gamecount; index++)
+      {
+        const SPMResult& result = resultvec[index];
+
+        ofs << result.pgn;
+        if (result.points == 2) wins++; else {if (result.points == 1) draws++; else losses++;};
+      };
+      if (ofs.fail()) {std::cerr << "Can't write PGN output file\n"; okay = false;};
+
+      std::cout << "Match summary\n";
+      std::cout << "  A: " << configs[0].spec << '\n';
+      std::cout << "  B: " << configs[1].spec << '\n';
+      std::cout << "  Openings: " << (posfn ? posfn : "opening library") << '\n';
+      std::cout << "  Threads: " << workercount << '\n';
+      if (gamecount) PrintSummary(wins, draws, losses);
+      std::cout << "  Seconds: " << std::fixed << std::setprecision(3) <<
+        (wallmsec / 1000.0) << '\n';
+      std::cout.unsetf(std::ios::floatfield);
+    };
+  };
+  return okay;
+}
+
+#endif
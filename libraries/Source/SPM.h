@@ -0,0 +1,43 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_SPM
+#define Included_SPM
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class State;
+
+// Self-play match class
+//
+// The SPM class plays a match between two configurations of the program, A and B, to
+// measure the effect of a change.  A configuration is "-" for the built-in program or a
+// comma separated list of items: "e=<file>" loads evaluation weights (as written by the
+// "te" command), "n=<file>" loads and uses a neural network, and "t=<directory>" loads
+// and probes tablebases.  Games are played in pairs from the same opening with the
+// colors reversed; the openings are random opening library lines or the records of a
+// position file.  The games are played concurrently by a pool of worker threads, each
+// with its own State instance per configuration.  All games go to a PGN file; the
+// summary gives the score, the Elo difference, and a sequential probability ratio test.
+
+class SPM
+{
+  public:
+    bool RunMatch(
+      const State *stateptr, const ui32 gamecount, const char *speca, const char *specb,
+      const char *pgnfn, const ui32 limitnodes, const char *posfn);
+
+  private:
+};
+
+#endif
+
+#endif
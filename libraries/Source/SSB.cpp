@@ -0,0 +1,145 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+
+// JSON key names: node types, pick states, and timed phases
+
+static const char * const abnnames[ssbabnLen] = {"base", "evad", "full", "gain"};
+
+static const char * const psnames[psLen] =
+{
+  "BaseInit", "BaseNext",
+  "EvadInit", "EvadPV", "EvadNext",
+  "FullInit", "FullPV", "FullGainSeqInit", "FullGainSeqMove", "FullKiller", "FullKillerPM2",
+  "FullHoldSeqInit", "FullHoldSeqMove",
+  "GainInit", "GainPV", "GainNext",
+  "Term"
+};
+
+#if (PRFHooked)
+static const char * const prfpnames[prfpLen] =
+{
+  "execute", "retract", "regen", "evaluate", "generate", "repetition"
+};
+#endif
+
+static double CalcRatio(const ui64 numerator, const ui64 denominator)
+{
+  return denominator ? (((double) numerator) / denominator) : 0.0;
+}
+
+void SSB::Reset(void)
+{
+  nodecount = qnodecount = 0;
+  for (ui index = 0; index < ssbabnLen; index++) abncounts[index] = 0;
+  for (ui index = 0; index < psLen; index++)
+    pickcounts[index] = cutoffcounts[index] = firstcutoffcounts[index] = 0;
+  iterationcount = 0;
+  for (ui index = 0; index < prfpLen; index++) phasecalls[index] = phaseticks[index] = 0;
+}
+
+void SSB::NoteIteration(const Counter& nodecounter)
+{
+  // Record the cumulative node count at the end of an iteration
+
+  if (iterationcount < MaxPlyLen)
+    iterationnodes[iterationcount++] = (ui64) nodecounter.CalcDoubleValue();
+}
+
+void SSB::PrintJSON(void) const
+{
+  // Print the statistics as a single line JSON object.  A pick state entry gives the moves
+  // it picked, the beta cutoffs they caused, and how many of those were by the first move
+  // searched at the node.  The effective branching factor of an iteration is the ratio of
+  // its node count to that of the prior iteration.  The phase times are in profiler ticks.
+
+  std::ostringstream oss;
+  const ui64 killerpicks = pickcounts[psFullKiller] + pickcounts[psFullKillerPM2];
+  const ui64 killercutoffs = cutoffcounts[psFullKiller] + cutoffcounts[psFullKillerPM2];
+  ui64 cutoffs = 0;
+
+  for (ui index = 0; index < psLen; index++) cutoffs += cutoffcounts[index];
+
+  oss << std::fixed << std::setprecision(4);
+  oss << "{\"nodes\":" << nodecount << ",\"qnodes\":" << qnodecount <<
+    ",\"qratio\":" << CalcRatio(qnodecount, nodecount);
+
+  oss << ",\"abn\":{";
+  for (ui index = 0; index < ssbabnLen; index++)
+    oss << (index ? "," : "") << '"' << abnnames[index] << "\":" << abncounts[index];
+  oss << '}';
+
+  oss << ",\"cutoffs\":" << cutoffs << ",\"picks\":{";
+  {
+    bool first = true;
+
+    for (ui index = 0; index < psLen; index++)
+    {
+      if (pickcounts[index])
+      {
+        oss << (first ? "" : ",") << '"' << psnames[index] << "\":{\"picks\":" <<
+          pickcounts[index] << ",\"cutoffs\":" << cutoffcounts[index] <<
+          ",\"firstcutoffs\":" << firstcutoffcounts[index] <<
+          ",\"cutoffrate\":" << CalcRatio(cutoffcounts[index], pickcounts[index]) <<
+          ",\"firstrate\":" << CalcRatio(firstcutoffcounts[index], cutoffcounts[index]) << '}';
+        first = false;
+      };
+    };
+  };
+  oss << '}';
+
+  oss << ",\"killers\":{\"picks\":" << killerpicks << ",\"cutoffs\":" << killercutoffs <<
+    ",\"hitrate\":" << CalcRatio(killercutoffs, killerpicks) << '}';
+
+  oss << ",\"iterations\":[";
+  {
+    ui64 priornodes = 0;
+
+    for (ui index = 0; index < iterationcount; index++)
+    {
+      const ui64 nodes = iterationnodes[index] - (index ? iterationnodes[index - 1] : 0);
+
+      oss << (index ? "," : "") << "{\"depth\":" << (index + 1) << ",\"nodes\":" << nodes <<
+        ",\"ebf\":" << CalcRatio(nodes, priornodes) << '}';
+      priornodes = nodes;
+    };
+  };
+  oss << ']';
+
+  // The phase times are present only if the instrumentation points are compiled in
+
+#if (PRFHooked)
+  oss << ",\"phases\":{";
+  for (ui index = 0; index < prfpLen; index++)
+    oss << (index ? "," : "") << '"' << prfpnames[index] << "\":{\"calls\":" <<
+      phasecalls[index] << ",\"ticks\":" << phaseticks[index] << '}';
+  oss << '}';
+#endif
+  oss << '}';
+
+  PrintStr(oss.str().c_str());
+}
+
+#endif
@@ -0,0 +1,71 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_SSB
+#define Included_SSB
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class Counter;
+
+// Node types (abnType) count
+
+#define ssbabnLen (abnGain + 1)
+
+// Search statistics block class
+//
+// The SSB class collects move ordering and cost statistics for a single search.  The
+// search keeps a null pointer to its block unless the "ss" trace option is set, so the
+// only cost of an idle block is a pointer test at each collection point.  The phase times
+// come from the profiler instrumentation points (see PRF) while the block is attached to
+// the search thread; they are gathered only in profiler or UseSSBPhases builds.  The block
+// is reported as a single line JSON object.
+
+class SSB
+{
+  public:
+    void Reset(void);
+
+    void NoteNode(const bool isquiescence)
+    {
+      nodecount++; if (isquiescence) qnodecount++;
+    }
+
+    void NoteABNode(const abnType abn) {abncounts[abn]++;}
+
+    void NotePick(const psType ps) {pickcounts[ps]++;}
+
+    void NoteCutOff(const psType ps, const bool isfirst)
+    {
+      cutoffcounts[ps]++; if (isfirst) firstcutoffcounts[ps]++;
+    }
+
+    void NoteIteration(const Counter& nodecounter);
+
+    void NotePhase(const prfpType prfp, const prftType ticks)
+    {
+      phasecalls[prfp]++; phaseticks[prfp] += ticks;
+    }
+
+    void PrintJSON(void) const;
+
+  private:
+    ui64 nodecount, qnodecount;
+    ui64 abncounts[ssbabnLen];
+    ui64 pickcounts[psLen], cutoffcounts[psLen], firstcutoffcounts[psLen];
+    ui64 iterationnodes[MaxPlyLen];
+    ui iterationcount;
+    ui64 phasecalls[prfpLen], phaseticks[prfpLen];
+};
+
+#endif
+
+#endif
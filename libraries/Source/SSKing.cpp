@@ -14,9 +14,11 @@
 #include <cassert>
 #endif
 
+#include "Board.h"
 #include "SSKing.h"
 
-// Lists of king run squares indexed by initial square
+#if (IsTarget)
+// Lists of king run squares indexed by initial square (the host uses generated tables)
 
 const sqrType SSKing::kingrunsqr[kingrunLen] PROGMEM =
 {
@@ -92,3 +94,5 @@ const sqrType SSKing::kingrunsqr[kingrunLen] PROGMEM =
   sqrH8,  sqrF8,  sqrG7,  sqrF7,  sqrH7,  sqrNil, sqrNil, sqrNil, sqrNil,
   sqrG8,  sqrH7,  sqrG7,  sqrNil, sqrNil, sqrNil, sqrNil, sqrNil, sqrNil
 };
+
+#endif
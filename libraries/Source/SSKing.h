@@ -10,22 +10,25 @@
 #ifndef Included_SSKing
 #define Included_SSKing
 
-// Byte length of the king run square table
-
-#define kingspanLen (dirSLen + 1)
-#define kingrunLen (sqrLen * kingspanLen)
-
 // Square scanner class for a king
 
 class SSKing
 {
   public:
+#if (IsDevHost)
+    SSKing(const sqrType sqr) {byteptr = Board::FetchKingRun(sqr);}
+#endif
+
+#if (IsTarget)
     SSKing(const sqrType sqr) {byteptr = kingrunsqr + (sqr * kingspanLen);}
+#endif
 
     sqrType Advance(void) {return (sqrType) ReadFlashSi8(byteptr++);}
 
   private:
+#if (IsTarget)
     static const sqrType kingrunsqr[kingrunLen] PROGMEM;
+#endif
 
     const sqrType *byteptr;
 };
@@ -14,9 +14,11 @@
 #include <cassert>
 #endif
 
+#include "Board.h"
 #include "SSKnight.h"
 
-// Lists of knight run squares indexed by initial square
+#if (IsTarget)
+// Lists of knight run squares indexed by initial square (the host uses generated tables)
 
 const sqrType SSKnight::knightrunsqr[knightrunLen] PROGMEM =
 {
@@ -92,3 +94,5 @@ const sqrType SSKnight::knightrunsqr[knightrunLen] PROGMEM =
   sqrE7,  sqrF6,  sqrH6,  sqrNil, sqrNil, sqrNil, sqrNil, sqrNil, sqrNil,
   sqrF7,  sqrG6,  sqrNil, sqrNil, sqrNil, sqrNil, sqrNil, sqrNil, sqrNil
 };
+
+#endif
@@ -10,22 +10,25 @@
 #ifndef Included_SSKnight
 #define Included_SSKnight
 
-// Byte length of the knight run square table
-
-#define knightspanLen (dirCLen + 1)
-#define knightrunLen (sqrLen * knightspanLen)
-
 // Square scanner class for a knight
 
 class SSKnight
 {
   public:
+#if (IsDevHost)
+    SSKnight(const sqrType sqr) {byteptr = Board::FetchKnightRun(sqr);}
+#endif
+
+#if (IsTarget)
     SSKnight(const sqrType sqr) {byteptr = knightrunsqr + (sqr * knightspanLen);}
+#endif
 
     sqrType Advance(void) {return (sqrType) ReadFlashSi8(byteptr++);}
 
   private:
+#if (IsTarget)
     static const sqrType knightrunsqr[knightrunLen] PROGMEM;
+#endif
 
     const sqrType *byteptr;
 };
@@ -0,0 +1,222 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+#include "Score.h"
+#include "Move.h"
+#include "STS.h"
+
+// Sink buffer length (bytes); the buffer is written when it reaches this length
+
+#define STSBufLen (1 << 16)
+
+// Search termination names
+
+static const char * const stnames[stLen] =
+{
+  "AllCertain", "Book", "ForcedLose", "ForcedMate", "Interrupt",
+  "LimitDepth", "LimitMoves", "LimitNodes", "LimitTime",
+  "MateIn1", "NoMoves", "Singleton", "Unterminated"
+};
+
+// Buffered file sink; the buffer is also written at program exit
+
+class STSSink
+{
+  public:
+    STSSink(void) {ofsptr = 0; sidcount = 0;}
+    ~STSSink(void) {Close();}
+
+    void Close(void)
+    {
+      if (ofsptr) {Flush(); delete ofsptr; ofsptr = 0;};
+    }
+
+    void Flush(void)
+    {
+      if (!buf.empty()) {ofsptr->write(buf.data(), buf.size()); ofsptr->flush(); buf.clear();};
+    }
+
+    std::mutex mutex;
+    std::ofstream *ofsptr;
+    std::string buf;
+    ui32 sidcount;
+};
+
+static STSSink stssink;
+
+static ui64 CalcNodes(const Counter& counter) {return (ui64) counter.CalcDoubleValue();}
+
+static void EncodeMove(std::ostringstream& oss, const Move& move)
+{
+  char cv[ucimLen], *cptr = cv;
+
+  move.EncodeUCI(&cptr); *cptr = '\0'; oss << '"' << cv << '"';
+}
+
+static void EncodeScore(std::ostringstream& oss, const svType sv)
+{
+  if (IsSvMating(sv)) oss << "{\"mate\":" << CalcMateDistance(sv) << '}';
+  else
+  {
+    if (IsSvLosing(sv)) oss << "{\"mate\":-" << CalcLoseDistance(sv) << '}';
+    else
+      oss << "{\"cp\":" << sv << '}';
+  };
+}
+
+static void EncodePV(std::ostringstream& oss, const Move *pvptr)
+{
+  oss << "\"pv\":[";
+  for (plyType index = 0; (index < MaxPVLen) && pvptr[index].IsNotVoid(); index++)
+  {
+    if (index) oss << ',';
+    EncodeMove(oss, pvptr[index]);
+  };
+  oss << ']';
+}
+
+static void Emit(const std::ostringstream& oss)
+{
+  // Append a completed event line to the sink buffer; the line is dropped if the stream
+  // was closed after its search started
+
+  const std::lock_guard<std::mutex> lock(stssink.mutex);
+
+  if (stssink.ofsptr)
+  {
+    stssink.buf += oss.str(); stssink.buf += '\n';
+    if (stssink.buf.size() >= STSBufLen) stssink.Flush();
+  };
+}
+
+bool STS::Open(const char *fn)
+{
+  // Open (append) the stream file, closing any prior stream
+
+  bool okay = true;
+  const std::lock_guard<std::mutex> lock(stssink.mutex);
+
+  stssink.Close();
+  stssink.ofsptr = new std::ofstream(fn, std::ios::app | std::ios::binary);
+  if (stssink.ofsptr->fail())
+  {
+    std::cerr << "Can't open trace stream output file\n";
+    delete stssink.ofsptr; stssink.ofsptr = 0; okay = false;
+  };
+  return okay;
+}
+
+void STS::Close(void)
+{
+  const std::lock_guard<std::mutex> lock(stssink.mutex);
+
+  stssink.Close();
+}
+
+ui32 STS::NoteStart(
+  const FPos& fpos, const bool mp,
+  const plyType limitply, const msType limitmsec, const ui32 limitnodes)
+{
+  // Assign the search ID, if the stream is open, and emit the start event
+
+  ui32 sid = 0;
+
+  {
+    const std::lock_guard<std::mutex> lock(stssink.mutex);
+
+    if (stssink.ofsptr) sid = ++stssink.sidcount;
+  };
+
+  if (sid)
+  {
+    std::ostringstream oss;
+    PPos ppos;
+    char fen[fenLen + 1];
+
+    ppos.LoadFromFPos(fpos); ppos.EncodeFEN(fen);
+    oss << "{\"ev\":\"start\",\"sid\":" << sid << ",\"mode\":\"" << (mp ? "mp" : "ab") <<
+      "\",\"fen\":\"" << fen << "\",\"depthlimit\":" << (ui) limitply <<
+      ",\"mseclimit\":" << limitmsec << ",\"nodelimit\":" << limitnodes << '}';
+    Emit(oss);
+  };
+  return sid;
+}
+
+void STS::NoteIteration(
+  const ui32 sid, const plyType depth, const Counter& nodecounter, const msType msec)
+{
+  std::ostringstream oss;
+
+  oss << "{\"ev\":\"iter\",\"sid\":" << sid << ",\"depth\":" << (ui) depth <<
+    ",\"nodes\":" << CalcNodes(nodecounter) << ",\"msec\":" << msec << '}';
+  Emit(oss);
+}
+
+void STS::NotePV(
+  const ui32 sid, const plyType depth, const Move *pvptr,
+  const Counter& nodecounter, const msType msec)
+{
+  std::ostringstream oss;
+
+  oss << "{\"ev\":\"pv\",\"sid\":" << sid << ",\"depth\":" << (ui) depth << ",\"score\":";
+  EncodeScore(oss, pvptr[0].GetSv());
+  oss << ",\"nodes\":" << CalcNodes(nodecounter) << ",\"msec\":" << msec << ',';
+  EncodePV(oss, pvptr);
+  oss << '}';
+  Emit(oss);
+}
+
+void STS::NotePerft(const ui32 sid, const Move& move, const Counter& counter)
+{
+  std::ostringstream oss;
+
+  oss << "{\"ev\":\"perft\",\"sid\":" << sid << ",\"move\":";
+  EncodeMove(oss, move);
+  oss << ",\"count\":" << CalcNodes(counter) << '}';
+  Emit(oss);
+}
+
+void STS::NoteEnd(
+  const ui32 sid, const stType st, const Move *pvptr,
+  const Counter& nodecounter, const msType msec)
+{
+  // The final score and PV are omitted if there is no result
+
+  std::ostringstream oss;
+
+  oss << "{\"ev\":\"end\",\"sid\":" << sid << ",\"st\":\"" << stnames[st] <<
+    "\",\"nodes\":" << CalcNodes(nodecounter) << ",\"msec\":" << msec;
+  if (pvptr && pvptr[0].IsNotVoid())
+  {
+    oss << ",\"score\":"; EncodeScore(oss, pvptr[0].GetSv()); oss << ','; EncodePV(oss, pvptr);
+  };
+  oss << '}';
+  Emit(oss);
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_STS
+#define Included_STS
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class Counter;
+class FPos;
+class Move;
+
+// Search Trace Stream class
+//
+// The STS class has only static members.  It writes search trace events as newline
+// delimited JSON (one object per line) through a buffered file sink shared by all of the
+// searches, including those run by the tool worker threads.  Each search that starts
+// while the stream is open gets a nonzero ID carried by all of its events; a search with
+// a zero ID emits nothing.  The "ev" key names the event:
+//
+//   start  sid, mode ("ab" or "mp"), fen, depthlimit, msec limit, and node limit
+//   iter   sid, depth, nodes, and msec of a completed iteration
+//   pv     sid, depth, score, nodes, msec, and UCI moves of a new root PV
+//   perft  sid, UCI move, and movepath count of a root move
+//   end    sid, termination (stType name), nodes, msec, and the final score and PV
+//
+// A score is an object with either a "cp" or a "mate" key as in the UCI protocol.
+
+class STS
+{
+  public:
+    static bool Open(const char *fn);
+    static void Close(void);
+
+    static ui32 NoteStart(
+      const FPos& fpos, const bool mp,
+      const plyType limitply, const msType limitmsec, const ui32 limitnodes);
+    static void NoteIteration(
+      const ui32 sid, const plyType depth, const Counter& nodecounter, const msType msec);
+    static void NotePV(
+      const ui32 sid, const plyType depth, const Move *pvptr,
+      const Counter& nodecounter, const msType msec);
+    static void NotePerft(const ui32 sid, const Move& move, const Counter& counter);
+    static void NoteEnd(
+      const ui32 sid, const stType st, const Move *pvptr,
+      const Counter& nodecounter, const msType msec);
+};
+
+#endif
+
+#endif
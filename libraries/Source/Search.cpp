@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -19,54 +20,70 @@
 #include "Board.h"
 #include "FEnv.h"
 #include "FPos.h"
+#include "Score.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
 #include "Search.h"
 
-void Search::OneTimeSetup(const ML& priorml, History& history, UnDoStack& undostack)
+void Search::OneTimeSetup(MoveStack& movestack, History& history, UnDoStack& undostack)
 {
   // This routine is be called only ONCE before any other Search method
 
-  options = 0; rootml.LoadFromPrior(priorml);
-  historyptr = &history; undostackptr = &undostack;
-  ply = 0; depth = DefaultSD; SetInitialArray();
+  options = 0; ply = 0; movestack.PresetML(rootml, SPos());
+#if (IsDevHost)
+  nneptr = 0; tbpptr = 0; tbplimit = 0; multipvcount = 1; ssbptr = 0; stsid = 0;
+#endif
+  historyptr = &history; undostackptr = &undostack; movestackptr = &movestack;
+  depth = DefaultSD; SetInitialArray();
 }
 
 void Search::ResetAux(void)
 {
-  // Reset work done prior to the start of a search (spos not modified here)
+  // Reset work done prior to the start of a search (SPos() not modified here)
 
-  abort = false; isftdown = true; isprelim = false; fastmp = false; actledstate = false;
-  interrupt = false; st = stUnterminated; nodecounter.Reset();
+  abort = false; isftdown = true; isprelim = false; isresolve = false; fastmp = false;
+  actledstate = false; st = stUnterminated; nodecounter.Reset();
   startmsec = checkusec = ElapsedMsec(); timeoutmsec = startmsec + (DefaultST * ((msType) 1000));
   usedmsec = 0; actleddisplayusec = boarddisplayusec = startmsec; rootml.ResetCount(); mgs.Reset();
+  rootdepth = 0; stopnodes = 0; pickmsec = 0; picknodes = 0;
+  movestackptr->ResetStats();
   for (plyType index = 0; index < MaxPlyLenP1; index++) pirstack[index].Reset();
-  for (plyType index = 0; index < MaxPlyLen; index++) killers[index].MakeVoid();
+  for (plyType index = 0; index < MaxPlyLen; index++) killers[index].Reset();
   pvtable.Reset();
+#if (IsDevHost)
+  tbprobecounter.Reset(); tbhitcounter.Reset(); multipvrank = 0;
+  for (ui index = 0; index < MultiPVLen; index++) multipvs[index][0].MakeVoid();
+#endif
 }
 
 void Search::LoadSearchFromFPos(const FPos& fpos)
 {
   // Load the search form an FEN position
 
-  ResetAux(); spos.LoadPosFromFPos(fpos);
+  ResetAux(); SPos().LoadPosFromFPos(fpos);
 }
 
 void Search::SetInitialArray(void)
 {
   // Set up the initial chess position; called only at ply zero
 
-  ResetAux(); spos.SetInitialArray();
+  ResetAux(); SPos().SetInitialArray();
 }
 
 void Search::UpdateActivityLED(void) const
@@ -129,16 +146,16 @@ void Search::DoExecuteAux(const Move& move)
 {
   // Update the history and the undo stack, then execute the move
 
-  historyptr->Push(spos.FetchPosHash());
-  undostackptr->Push(spos, move, spos.GetCaptTid());
-  spos.Execute(move);
+  historyptr->Push(SPos().FetchPosHash());
+  undostackptr->Push(SPos(), move, SPos().GetCaptTid());
+  SPos().Execute(move);
 }
 
 void Search::DoRetractAux(void)
 {
   // Retract the move, then downdate the history and the undo stack
 
-  spos.Retract(
+  SPos().Retract(
     undostackptr->FetchTopMove(),
     undostackptr->FetchTopFEnv(),
     undostackptr->GetTopCaptTid());
@@ -148,22 +165,45 @@ void Search::DoRetractAux(void)
 
 void Search::DoExecute(const Move& move)
 {
-  // Advance one ply into the future; not called when playing a move over the board
+  // Advance one ply into the future; not called when playing a move over the board.  With
+  // copy-make, the move is executed on a copy of the position in the next ply slot.
 
   if (ply == MaxPlyLen) DieFS(fsFeOverflowPS);
-  pirstack[ply].RefMGS() = mgs; pirstack[ply].RefPEnv() = *(PEnv *) &spos;
+  pirstack[ply].RefMGS() = mgs;
+#if (UseCopyMake)
+  posstack[ply + 1] = posstack[ply];
+#endif
+#if (!UseCopyMake)
+  pirstack[ply].RefPEnv() = *(PEnv *) &SPos();
+#if (IsDevHost)
+  if (SPos().UsesNNE()) pirstack[ply].RefNNAcc() = SPos().FetchNNAcc();
+#endif
+#endif
   ply++; --depth;
   DoExecuteAux(move);
 }
 
 void Search::DoRetract(void)
 {
-  // Retreat one ply into the past; not called when unplaying a move over the board
+  // Retreat one ply into the past; not called when unplaying a move over the board.  With
+  // copy-make, the prior ply slot still holds the position before the move.
 
   if (ply == 0) DieFS(fsFeUnderflowPS);
   --ply; depth++;
-  mgs = pirstack[ply].FetchMGS(); *(PEnv *) &spos = pirstack[ply].FetchPEnv();
+  mgs = pirstack[ply].FetchMGS();
+#if (UseCopyMake)
+  historyptr->PopDel(); undostackptr->PopDel();
+#endif
+#if (!UseCopyMake)
+  *(PEnv *) &SPos() = pirstack[ply].FetchPEnv();
+#if (IsDevHost)
+  if (SPos().UsesNNE()) SPos().HoldNNAcc();
+#endif
   DoRetractAux();
+#if (IsDevHost)
+  if (SPos().UsesNNE()) SPos().RestoreNNAcc(pirstack[ply].FetchNNAcc());
+#endif
+#endif
 }
 
 void Search::Play(const Move& move)
@@ -177,10 +217,44 @@ void Search::Unplay(void)
 {
   // Unplay a move as if over the board (i.e., on a physical chessboard)
 
-  DoRetractAux(); spos.Regen(); ResetAux();
+  DoRetractAux(); SPos().Regen(); ResetAux();
 }
 
-void Search::PrintPVAndScore(void) const {pvtable.PrintPVAndScore(spos);}
+void Search::PrintPVAndScore(void) const {pvtable.PrintPVAndScore(SPos());}
+
+void Search::PrintUCIInfo(void) const
+{
+  // Print a UCI information line for the prior PV; the score is the mover's point of view
+
+  const msType elapsedmsec = ElapsedMsec() - startmsec;
+  const svType sv = PVMove(0).GetSv();
+
+  PrintFS(fsUcInfoDepth); PrintUi16(rootdepth);
+#if (IsDevHost)
+  if (multipvcount > 1) {PrintFS(fsUcMultiPV); PrintUi16(multipvrank + 1);};
+#endif
+  if (IsSvMating(sv)) {PrintFS(fsUcScoreMate); PrintUi16(CalcMateDistance(sv));}
+  else
+  {
+    if (IsSvLosing(sv)) {PrintFS(fsUcScoreMate); PrintChar('-'); PrintUi16(CalcLoseDistance(sv));}
+    else
+    {
+      PrintFS(fsUcScoreCp); PrintSi16(sv);
+    };
+  };
+  PrintFS(fsUcNodes); PrintUi32(nodecounter.CalcUi32Value());
+  if (elapsedmsec)
+  {
+    PrintFS(fsUcNps); PrintUi32((ui32) ((nodecounter.CalcDoubleValue() * 1000.0) / elapsedmsec));
+  };
+  PrintFS(fsUcTime); PrintUi32(elapsedmsec);
+  PrintFS(fsUcPV);
+  for (plyType index = 0; (index < MaxPVLen) && PVMove(index).IsNotVoid(); index++)
+  {
+    PrintSpace(); PVMove(index).PrintUCI();
+  };
+  PrintNL();
+}
 
 void Search::Indent(void) const {PrintSpaces(ply * 2);}
 
@@ -204,7 +278,7 @@ void Search::MarkCV(const ML& priorml)
 
     // Then generate/apply any notation flags
 
-    move.Mark(spos, priorml);
+    move.Mark(SPos(), priorml);
 
     // Advance to the next ply restoring the MGS object
 
@@ -212,6 +286,19 @@ void Search::MarkCV(const ML& priorml)
   };
 }
 
+void Search::LoadPriorPV(const svType sv)
+{
+  // Decode the ply zero trace PV into the prior PV; must be called at ply zero
+
+  pvtable.ResetPrior();
+  while (pvtable.IsTraceMove(ply)) {pvtable.LoadPriorMove(ply, SPos()); DoExecute(PVMove(ply));};
+  while (ply) DoRetract();
+
+  // Add the score data to the first move to give the score result of the search
+
+  RefPVMove(0).PutSv(sv);
+}
+
 void Search::MarkPV(const ML& priorml)
 {
   // Apply marks to the PV; must be called at ply zero
@@ -220,7 +307,7 @@ void Search::MarkPV(const ML& priorml)
   {
     // Generate/apply any notation flags, then advance to the next ply
 
-    RefPVMove(ply).Mark(spos, priorml); DoExecute(PVMove(ply));
+    RefPVMove(ply).Mark(SPos(), priorml); DoExecute(PVMove(ply));
   };
 
   // Retract all the PV moves to return to ply zero
@@ -245,7 +332,24 @@ void Search::MatchMove(const char *str, Move& move)
 
   ML ml(rootml);
 
-  spos.MatchMove(str, move, ml);
+  SPos().MatchMove(str, move, ml);
+}
+
+void Search::MatchUCIMove(const char *str, Move& move)
+{
+  // Match the given UCI coordinate move string in the search position
+
+  ML ml(rootml);
+  miType index = 0;
+
+  move.MakeVoid(); Gen(ml);
+  while (move.IsVoid() && (index < ml.GetCount()))
+  {
+    char cv[ucimLen], *cptr = cv;
+
+    ml.FetchMove(index).EncodeUCI(&cptr); *cptr = '\0';
+    if (StrCmp(str, cv) == 0) move = ml.FetchMove(index); else index++;
+  };
 }
 
 void Search::Trace0(void)
@@ -273,5 +377,19 @@ void Search::Trace1(void)
       PrintFS(fsMsSfxHz);
     };
     PrintNL();
+
+    // Move stack usage statistics
+
+    PrintOptn(optnTS); movestackptr->PrintStats(); PrintNL();
+
+#if (IsDevHost)
+    // Tablebase probe statistics, if probing is enabled
+
+    if (TestOptionM(optnmTB))
+    {
+      PrintOptn(optnTS); PrintFSL(fsLbTBProbes); tbprobecounter.Print();
+      PrintISM(); PrintFSL(fsLbTBHits); tbhitcounter.Print(); PrintNL();
+    };
+#endif
   };
 }
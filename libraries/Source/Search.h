@@ -12,6 +12,9 @@
 
 // Forward class declaration(s)
 
+class MoveStack;
+class NNE;
+class TBP;
 class Window;
 
 // Search class
@@ -19,25 +22,57 @@ class Window;
 class Search
 {
   public:
-    Search(void) {options = 0;}
+    Search(void) {options = 0; restarttimeoutmsec = 0; ResetRequests();}
     ~Search(void) {}
 
-    void OneTimeSetup(const ML& priorml, History& history, UnDoStack& undostack);
+#if (IsDevHost)
+    // Not copyable: the evaluator and tablebase pointers are shared with the owning State
+
+    Search(const Search&) = delete;
+    Search& operator=(const Search&) = delete;
+#endif
+
+    void OneTimeSetup(MoveStack& movestack, History& history, UnDoStack& undostack);
+
+    // Requests from another thread (or a signal handler); a request stays pending until the
+    // search takes it or the owner of the input drops it with ResetRequests
 
     void Interrupt(void) {interrupt = true;}
 
+    void RestartTimeLimit(const msType limitmsec)
+    {
+      restarttimeoutmsec = ElapsedMsec() + limitmsec; restart = true;
+    }
+
+    void ResetRequests(void) {interrupt = false; restart = false;}
+
     void LoadSearchFromFPos(const FPos& fpos);
 
     void SetInitialArray(void);
 
     optnmType& RefOptions(void) {return options;}
 
-    const FEnv& FetchSearchFEnv(void) const {return spos;}
-    const FPos& FetchSearchFPos(void) const {return spos;}
+    EPV& RefEPV(void) {return epv;}
 
-    const Hash& FetchPosHash(void) const {return spos.FetchPosHash();}
+#if (IsDevHost)
+    void PutNNEPtr(const NNE *ptr) {nneptr = ptr; SyncNNE();}
 
-    void Flip(void) {ResetAux(); spos.Flip();}
+    // Attach the neural network evaluator to the search position if the "nn" option is
+    // set, else detach it; the position must never keep a pointer to a released evaluator
+
+    void SyncNNE(void) {SPos().AttachNNE(TestOptionM(optnmNN) ? nneptr : 0);}
+    void PutTBP(TBP *ptr, const ui limit) {tbpptr = ptr; tbplimit = limit;}
+
+    ui GetMultiPVCount(void) const {return multipvcount;}
+    void PutMultiPVCount(const ui value) {multipvcount = value;}
+#endif
+
+    const FEnv& FetchSearchFEnv(void) const {return SPos();}
+    const FPos& FetchSearchFPos(void) const {return SPos();}
+
+    const Hash& FetchPosHash(void) const {return SPos().FetchPosHash();}
+
+    void Flip(void) {ResetAux(); SPos().Flip();}
 
     void DoExecute(const Move& move);
     void DoRetract(void);
@@ -49,26 +84,50 @@ class Search
 
     void PrintPVAndScore(void) const;
 
-    bool IsOver(void) const {return spos.IsOver(*historyptr);}
+    bool IsOver(void) const {return SPos().IsOver(*historyptr);}
 
-    bool IsLoseIn1AfterMove(const Move& move) {return spos.IsLoseIn1AfterMove(move, rootml);}
+    bool IsLoseIn1AfterMove(const Move& move) {return SPos().IsLoseIn1AfterMove(move, rootml);}
 
-    ftType CalcFT(void) const {return spos.CalcFT(*historyptr);}
+    ftType CalcFT(void) const {return SPos().CalcFT(*historyptr);}
 
-    void PrintMoves(void) {spos.PrintMoves(rootml);}
-    void PrintBookMoveList(void) {spos.PrintBookMoveList(rootml);}
+    void PrintMoves(void) {SPos().PrintMoves(rootml);}
+    void PrintBookMoveList(void) {SPos().PrintBookMoveList(rootml);}
 
     void MatchMove(const char *str, Move& move);
+    void MatchUCIMove(const char *str, Move& move);
+
+    void RunABSearch(const ui32 limitmsec, const plyType limitply, const ui32 limitnodes);
+
+    const Counter& FetchNodeCounter(void) const {return nodecounter;}
+    ui32 GetNodeCount(void) const {return nodecounter.CalcUi32Value();}
+    msType GetUsedMsec(void) const {return usedmsec;}
 
-    void RunABSearch(const ui32 limitmsec, const plyType limitply);
+    msType GetPickMsec(void) const {return pickmsec;}
+    ui32 GetPickNodes(void) const {return picknodes;}
     void RunMP(const plyType limitply, const bool fast);
 
-    void RedrawBoardDisplay(void) const {spos.RedrawBoardDisplay();}
+#if (IsDevHost)
+    void ResolveQuiescence(FPos& fpos);
+#endif
+
+    void RedrawBoardDisplay(void) const {SPos().RedrawBoardDisplay();}
 
-    void PrintFEN(void) const {spos.PrintFEN();}
-    void PrintGraphic(void) const {spos.PrintGraphic(!TestOptionM(optnmRB));}
+    void PrintFEN(void) const {SPos().PrintFEN();}
+    void PrintGraphic(void) const {SPos().PrintGraphic(!TestOptionM(optnmRB));}
 
   private:
+    // The working position: the single search position (execute/retract) or the copy at the
+    // current ply (copy-make)
+
+#if (!UseCopyMake)
+    Pos& SPos(void) {return spos;}
+    const Pos& SPos(void) const {return spos;}
+#endif
+#if (UseCopyMake)
+    Pos& SPos(void) {return posstack[ply];}
+    const Pos& SPos(void) const {return posstack[ply];}
+#endif
+
     void ResetAux(void);
 
     bool TestOptionM(const optnmType optnm) const {return options & optnm;}
@@ -80,56 +139,123 @@ class Search
     void DoExecuteAux(const Move& move);
     void DoRetractAux(void);
 
-    const Move& RootMove(const miType index) const {return rootml.FetchMove(index);}
-    Move& RootMove(const miType index) {return rootml.RefMove(index);}
+    Move RootMove(const miType index) const {return rootml.FetchMove(index);}
 
     Move& RefPVMove(const plyType plyindex) {return pvtable.RefPVMove(plyindex);}
 
+    void FetchKiller(const plyType plyindex, Move& move) const
+    {
+      killers[plyindex].ConvertToMove(move, SPos());
+    }
+
     void ClearLocalPV(void) {pvtable.ClearAtPly(ply);}
     void ClearLowerPV(void) {pvtable.ClearAtPly(ply + 1);}
     void CopyUpLocalPV(const Move& move) {pvtable.CopyUpToPly(ply, move);}
 
+    void LoadPriorPV(const svType sv);
+
     void MarkCV(const ML& priorml);
     void MarkPV(const ML& priorml);
 
     void PrintCV(void) const;
+    void PrintUCIInfo(void) const;
 
     void Stop(const stType stvalue) {st = stvalue;}
     bool NotStopped(void) const {return st == stUnterminated;}
 
-    bool InCheck(void)      const {return spos.InCheck();}
-    bool IsCheckmate(void)  const {return spos.IsCheckmate();}
-    bool IsLikelyDraw(void) const {return spos.IsLikelyDraw(*historyptr);}
-    bool IsDraw(void)       const {return spos.IsDraw(*historyptr);}
+    bool InCheck(void)      const {return SPos().InCheck();}
+    bool IsCheckmate(void)  const {return SPos().IsCheckmate();}
+    bool IsLikelyDraw(void) const {return SPos().IsLikelyDraw(*historyptr);}
+    bool IsDraw(void)       const {return SPos().IsDraw(*historyptr);}
+
+    miType CountMoves(void) const {return SPos().CountMoves();}
+
+    // Take (test and clear) a pending request flag in one step so that a new request can't
+    // be lost between the test and the clear
 
-    miType CountMoves(void) const {return spos.CountMoves();}
+#if (IsDevHost)
+    static bool TakeRequest(std::atomic<bool>& flag) {return flag.exchange(false);}
+#endif
+#if (IsTarget)
+    static bool TakeRequest(volatile bool& flag)
+    {
+      const bool value = flag;
+
+      flag = false; return value;
+    }
+#endif
 
     bool CheckInterrupt(void)
     {
-      if (interrupt) {Stop(stInterrupt); interrupt = false; abort = true;};
+      if (TakeRequest(interrupt)) {Stop(stInterrupt); abort = true;};
       return abort;
     }
 
-    svType Evaluate(void) {return spos.Evaluate();}
+    svType Evaluate(void) const {return SPos().Evaluate(epv);}
+
+#if (IsDevHost)
+    bool IsTBProbeable(void) const
+    {
+      return
+        tbpptr && TestOptionM(optnmTB) && !SPos().GetCsab() &&
+        ((ui) (SPos().GetManCountByColor(colorWhite) + SPos().GetManCountByColor(colorBlack)) <=
+          tbplimit);
+    }
+
+    void ProbeRootTB(void);
+#endif
 
     void GenNonEvasion(const genmType genm, ML& ml) const
     {
-      spos.GenNonEvasion(genm, ml);
+      PRFHook(prfpGenerate);
+
+      SPos().GenNonEvasion(genm, ml);
+    }
+
+    void GenNonEvasionByPiece(const genmType genm, ML& ml) const
+    {
+      PRFHook(prfpGenerate);
+
+      SPos().GenNonEvasionByPiece(genm, ml);
+    }
+
+    void GenEvasion(ML& ml) const
+    {
+      PRFHook(prfpGenerate);
+
+      SPos().GenEvasion(ml);
     }
 
-    void GenEvasion(ML& ml)   const {spos.GenEvasion(ml);}
-    void Gen(ML& ml)          const {spos.Gen(ml);}
-    void GenMarked(ML& ml)          {spos.GenMarked(ml);}
-    void GenCanonical(ML& ml)       {spos.GenCanonical(ml);}
+    void Gen(ML& ml)          const {SPos().Gen(ml);}
+    void GenCanonical(ML& ml)       {SPos().GenCanonical(ml);}
 
     void ScoreAndSortRootML(void);
 
     miType Pick(ML& ml);
     miType PickBestUnsearched(const ML& ml);
+    bool IsTried(const ML& ml, const miType index) const;
+    miType PickBestUntried(const ML& ml);
 
     void UpdateCheckTime(void) {checkusec = ElapsedMsec();}
 
-    bool IsPastTime(void) const {return ElapsedMsec() >= timeoutmsec;}
+    bool IsPastTime(void)
+    {
+      if (TakeRequest(restart)) timeoutmsec = restarttimeoutmsec;
+      return ElapsedMsec() >= timeoutmsec;
+    }
+
+    void NotePick(const Move& move)
+    {
+      if (!Move::SameMove(move, PVMove(0)))
+      {
+        pickmsec = ElapsedMsec() - startmsec; picknodes = nodecounter.CalcUi32Value();
+      };
+    }
+
+    bool IsPastNodes(void) const
+    {
+      return stopnodes && PVMove(0).IsNotVoid() && (nodecounter.CalcUi32Value() >= stopnodes);
+    }
 
     bool IsTriggerAcitivityLEDUpdate(void);
     bool IsTriggerBoardDisplayUpdate(void);
@@ -138,6 +264,9 @@ class Search
     svType ABNode(const Window& window, const ML& priorml);
     svType ABRootNode(const Window& window, const ML& priorml);
 
+#if (IsDevHost)
+    void ABMultiPVIteration(const Window& window);
+#endif
     void ABIteration(const plyType iteration);
     void ABIterationSequence(const plyType limitply);
 
@@ -150,21 +279,53 @@ class Search
     void Trace1(void);
 
     optnmType options;
-    plyType ply;
+    plyType ply, rootdepth;
     depthType depth;
-    bool abort, isftdown, isprelim, fastmp, actledstate;
-    volatile bool interrupt;
+    bool abort, isftdown, isprelim, isresolve, fastmp, actledstate;
+#if (IsDevHost)
+    std::atomic<bool> interrupt, restart;
+#endif
+#if (IsTarget)
+    volatile bool interrupt, restart;
+#endif
     stType st;
     msType startmsec, timeoutmsec, usedmsec, checkusec, actleddisplayusec, boarddisplayusec;
+#if (IsDevHost)
+    std::atomic<msType> restarttimeoutmsec;
+#endif
+#if (IsTarget)
+    volatile msType restarttimeoutmsec;
+#endif
+    msType pickmsec;
+    ui32 stopnodes, picknodes;
     Counter nodecounter;
     MGS mgs;
     ML rootml;
+#if (!UseCopyMake)
     Pos spos;
+#endif
+#if (UseCopyMake)
+    Pos posstack[MaxPlyLenP1];
+#endif
     PIR pirstack[MaxPlyLenP1];
-    Move killers[MaxPlyLen];
+    TinyMove killers[MaxPlyLen];
     PVTable pvtable;
+    EPV epv;
+#if (IsDevHost)
+    const NNE *nneptr;
+    TBP *tbpptr;
+    ui tbplimit;
+    Counter tbprobecounter, tbhitcounter;
+    ui multipvcount, multipvrank;
+    Move multipvs[MultiPVLen][MaxPVLenP1];
+    SSB ssb;
+    SSB *ssbptr;
+    psType pickps;
+    ui32 stsid;
+#endif
     History *historyptr;
     UnDoStack *undostackptr;
+    MoveStack *movestackptr;
 };
 
 #endif
@@ -12,7 +12,9 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
+#include <vector>
 #endif
 
 #include "Counter.h"
@@ -22,21 +24,28 @@
 #include "Score.h"
 #include "Window.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
-#include "TinyMove.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
+#include "PRF.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
 #include "Search.h"
+#include "STS.h"
+#include "TBP.h"
 
 void Search::ScoreAndSortRootML(void)
 {
@@ -52,10 +61,10 @@ void Search::ScoreAndSortRootML(void)
   mywindow.SetFullWidth(); depth = 0;
   for (miType index = 0; index < rootml.GetCount(); index++)
   {
-    if (RootMove(index).IsNotCertain())
+    if (rootml.IsNotCertain(index))
     {
       DoExecute(RootMove(index));
-      RootMove(index).PutSv(ShiftUp(ABRootNode(mywindow, rootml)));
+      rootml.PutSv(index, ShiftUp(ABRootNode(mywindow, rootml)));
       DoRetract();
     };
   };
@@ -74,8 +83,11 @@ void Search::ScoreAndSortRootML(void)
   {
     for (miType index = 0; index < rootml.GetCount(); index++)
     {
-      PrintOptn(optnPS); RootMove(index).Print(); PrintISM();
-      PrintFSL(fsLbScore); Score::PrintSv(RootMove(index).GetSv()); PrintNL();
+      Move move = RootMove(index);
+
+      move.Mark(SPos(), rootml);
+      PrintOptn(optnPS); move.Print(); PrintISM();
+      PrintFSL(fsLbScore); Score::PrintSv(rootml.GetSv(index)); PrintNL();
     };
   };
 
@@ -87,14 +99,63 @@ void Search::ScoreAndSortRootML(void)
 
 miType Search::PickBestUnsearched(const ML& ml)
 {
-  miType pick = -1;
-  svType picksv = svBroken;
+  // Pick the best unsearched move of the current batch; the first few picks are made by
+  // selection as a cutoff is likely, then the rest of the batch is sorted once
 
-  for (miType index = 0; index < ml.GetCount(); index++)
-    if (!ml.FetchMove(index).IsSearched() && (ml.FetchMove(index).GetSv() > picksv))
-    {
-      picksv = ml.FetchMove(index).GetSv(); pick = index;
-    };
+  miType pick = -1, index = mgs.GetPickIndex();
+
+  if (!mgs.IsPickSorted() && (index >= PickSelectLen))
+  {
+    ml.SortUnsearchedBySv(index); mgs.SetPickSorted();
+  };
+
+  if (mgs.IsPickSorted())
+  {
+    // Sorted: the next unsearched move in sequence
+
+    while ((pick < 0) && (index < ml.GetCount()))
+      if (!ml.IsSearched(index)) pick = index; else index++;
+  }
+  else
+    pick = ml.SelectBestUnsearched(index);
+
+  if (pick >= 0) mgs.PutPickIndex(pick + 1);
+  return pick;
+}
+
+bool Search::IsTried(const ML& ml, const miType index) const
+{
+  // Return true if the indexed move was already tried at this node by one of the stages in
+  // the avoidance mask; the packed move codes are compared
+
+  const TinyMove& tinymove = ml.FetchTinyMove(index);
+  bool tried = false;
+
+  if (mgs.AvoidPV())
+  {
+    TinyMove pvtinymove;
+
+    pvtinymove.ConvertFromMove(PVMove(ply));
+    tried = TinyMove::SameTinyMove(tinymove, pvtinymove);
+  };
+  if (!tried && mgs.AvoidKiller()) tried = TinyMove::SameTinyMove(tinymove, killers[ply]);
+  if (!tried && mgs.AvoidKillerPM2())
+    tried = TinyMove::SameTinyMove(tinymove, killers[ply - 2]);
+  return tried;
+}
+
+miType Search::PickBestUntried(const ML& ml)
+{
+  // Pick as PickBestUnsearched(), but pass over any move already tried at this node by the
+  // PV or killer stages; such a move is marked as searched when it comes up, so there's no
+  // scan of the list for the tried moves
+
+  miType pick = PickBestUnsearched(ml);
+
+  while ((pick >= 0) && mgs.AvoidAny() && IsTried(ml, pick))
+  {
+    ml.SetFlagM(pick, mfmSrch); pick = PickBestUnsearched(ml);
+  };
   return pick;
 }
 
@@ -106,6 +167,12 @@ miType Search::Pick(ML& ml)
 
   while ((index < 0) && (mgs.GetPs() != psTerm))
   {
+#if (IsDevHost)
+    // Keep the pick state for the search statistics
+
+    pickps = mgs.GetPs();
+#endif
+
     switch (mgs.GetPs())
     {
       case psBaseInit:
@@ -126,7 +193,7 @@ miType Search::Pick(ML& ml)
       case psEvadInit:
         // All possible check evasion moves are generated
 
-        GenEvasion(ml); ml.AssignLikelyGain(spos); mgs.PutPs(psEvadPV);
+        GenEvasion(ml); ml.AssignLikelyGain(SPos()); mgs.PutPs(psEvadPV);
         break;
 
       case psEvadPV:
@@ -134,7 +201,7 @@ miType Search::Pick(ML& ml)
 
         if (isftdown && (ply < MaxPVLen) && PVMove(ply).IsNotVoid())
           index = ml.LocateNoFail(PVMove(ply));
-        mgs.PutPs(psEvadNext);
+        mgs.ResetPicker(); mgs.PutPs(psEvadNext);
         break;
 
       case psEvadNext:
@@ -164,26 +231,17 @@ miType Search::Pick(ML& ml)
       case psFullGainSeqInit:
         // Generate all of the gainer moves and assign likely gain preliminary scores
 
-        GenNonEvasion(genmGain, ml); ml.AssignLikelyGain(spos);
-
-        // If the PV move has been tried, mark it as searched if it was a gainer move
-
-        if (mgs.AvoidPV())
-        {
-          const miType pvindex = ml.Locate(PVMove(ply));
-
-          if (pvindex >=0) ml.RefMove(index).SetFlagM(mfmSrch);
-        };
+        GenNonEvasion(genmGain, ml); ml.AssignLikelyGain(SPos());
 
         // Now go scan the gainer list
 
-        mgs.PutPs(psFullGainSeqMove);
+        mgs.ResetPicker(); mgs.PutPs(psFullGainSeqMove);
         break;
 
       case psFullGainSeqMove:
-        // Pick the best unsearched move (here, a gainer)
+        // Pick the best untried move (here, a gainer)
 
-        index = PickBestUnsearched(ml); if (index < 0) mgs.PutPs(psFullKiller);
+        index = PickBestUntried(ml); if (index < 0) mgs.PutPs(psFullKiller);
         break;
 
       case psFullKiller:
@@ -191,20 +249,18 @@ miType Search::Pick(ML& ml)
 
         if (killers[ply].IsNotVoid())
         {
+          Move killer;
+
           // Avoid using the PV move if it's the same as the killer
 
-          if (!(mgs.AvoidPV() && Move::SameMove(killers[ply], PVMove(ply))))
+          FetchKiller(ply, killer);
+          if (!(mgs.AvoidPV() && Move::SameMove(killer, PVMove(ply))))
           {
-            const sqrType frsqr = killers[ply].GetFrSqr();
-            const manType frman = spos.GetMan(frsqr);
+            // The killer is tested directly as it might not be legal here
 
-            if (cvmantocolor[frman] == spos.GetGood())
+            if (SPos().IsHolderLegal(killer))
             {
-              // Generate moves by the killer (move might not be present)
-
-              ml.ResetCount(); spos.GenAddNonEvasionFromSquare(genmHold, frsqr, ml);
-              index = ml.Locate(killers[ply]);
-              if (index >= 0) mgs.SetAvoidKiller();
+              ml.ResetCount(); ml.Push(killer); mgs.SetAvoidKiller(); index = 0;
             };
           };
         };
@@ -218,22 +274,20 @@ miType Search::Pick(ML& ml)
         {
           const plyType pm2 = ply - 2;
 
-          if (killers[pm2].IsNotVoid() && !Move::SameMove(killers[ply], killers[pm2]))
+          if (killers[pm2].IsNotVoid() && !TinyMove::SameTinyMove(killers[ply], killers[pm2]))
           {
+            Move killer;
+
             // Avoid using the PV move if it's the same as the pm2 killer
 
-            if (!(mgs.AvoidPV() && Move::SameMove(killers[pm2], PVMove(ply))))
+            FetchKiller(pm2, killer);
+            if (!(mgs.AvoidPV() && Move::SameMove(killer, PVMove(ply))))
             {
-              const sqrType frsqr = killers[pm2].GetFrSqr();
-              const manType frman = spos.GetMan(frsqr);
+              // The pm2 killer is tested directly as it might not be legal here
 
-              if (cvmantocolor[frman] == spos.GetGood())
+              if (SPos().IsHolderLegal(killer))
               {
-                // Generate moves by the pm2 killer (move might not be present)
-
-                ml.ResetCount(); spos.GenAddNonEvasionFromSquare(genmHold, frsqr, ml);
-                index = ml.Locate(killers[pm2]);
-                if (index >= 0) mgs.SetAvoidKillerPM2();
+                ml.ResetCount(); ml.Push(killer); mgs.SetAvoidKillerPM2(); index = 0;
               };
             };
           };
@@ -242,88 +296,25 @@ miType Search::Pick(ML& ml)
         break;
 
       case psFullHoldSeqInit:
-        // Set up the full width holder outer loop: piece kind from pawn to king
-
-        mgs.PutPiece(piecePawn); mgs.PutPs(psFullHoldSeqPieceTBV);
-        break;
-
-      case psFullHoldSeqPieceTBV:
-        // Set up the target bit vector for the indicated piece kind; check for exit
-
-        if (mgs.GetPiece() > pieceKing) mgs.PutPs(psTerm);
-        else
-        {
-          // Assign the target bit vector for the indicated piece kind
-
-          mgs.RefGoodTBV() = spos.FetchTBVBCP(spos.GetGood(), mgs.GetPiece());
-          mgs.PutPs(psFullHoldSeqPieceTid);
-        };
-        break;
-
-      case psFullHoldSeqPieceTid:
-        {
-          // Get the next target ID for the current piece kind
-
-          const tidType goodtid = mgs.RefGoodTBV().NextTid();
-
-          // Check for no more targets for the current piece kind
-
-          if (IsTidNil(goodtid)) {mgs.IncPiece(); mgs.PutPs(psFullHoldSeqPieceTBV);}
-          else
-          {
-            // Generate the holder moves for the current target ID
-
-            const sqrType goodfrsqr = spos.GetTidToSqr(goodtid);
-
-            ml.ResetCount(); spos.GenAddNonEvasionFromSquare(genmHold, goodfrsqr, ml);
-
-            // Mark the PV move as being searched (may not be present)
-
-            if (mgs.AvoidPV() && (PVMove(ply).GetFrSqr() == goodfrsqr))
-            {
-              const miType avoidindex = ml.Locate(PVMove(ply));
-
-              if (avoidindex >= 0) ml.RefMove(avoidindex).SetFlagM(mfmSrch);
-              mgs.ResetAvoidPV();
-            };
-
-            // Mark the killer move as being searched (may not be present)
-
-            if (mgs.AvoidKiller() && (killers[ply].GetFrSqr() == goodfrsqr))
-            {
-              const miType avoidindex = ml.Locate(killers[ply]);
-
-              if (avoidindex >= 0) ml.RefMove(avoidindex).SetFlagM(mfmSrch);
-              mgs.ResetAvoidKiller();
-            };
-
-            // Mark the pm2 killer move as being searched (may not be present)
+        // Generate all of the holder moves (by piece kind) and assign center tropism scores
 
-            if (mgs.AvoidKillerPM2() && (killers[ply - 2].GetFrSqr() == goodfrsqr))
-            {
-              const miType avoidindex = ml.Locate(killers[ply - 2]);
-
-              if (avoidindex >= 0) ml.RefMove(avoidindex).SetFlagM(mfmSrch);
-              mgs.ResetAvoidKillerPM2();
-            };
+        GenNonEvasionByPiece(genmHold, ml); ml.AssignCenterTropismGain();
 
-            // Prepare the moves for a scan
+        // Now go scan the holder list
 
-            ml.AssignCenterTropismGain(); mgs.PutPs(psFullHoldSeqPieceMove);
-          };
-        };
+        mgs.ResetPicker(); mgs.PutPs(psFullHoldSeqMove);
         break;
 
-      case psFullHoldSeqPieceMove:
-        // Pick the best unsearched move for the current target
+      case psFullHoldSeqMove:
+        // Pick the best untried move (here, a holder)
 
-        index = PickBestUnsearched(ml); if (index < 0) mgs.PutPs(psFullHoldSeqPieceTid);
+        index = PickBestUntried(ml); if (index < 0) mgs.PutPs(psTerm);
         break;
 
       case psGainInit:
         // All possible gainer moves are generated
 
-        GenNonEvasion(genmGain, ml); ml.AssignLikelyGain(spos); mgs.PutPs(psGainPV);
+        GenNonEvasion(genmGain, ml); ml.AssignLikelyGain(SPos()); mgs.PutPs(psGainPV);
         break;
 
       case psGainPV:
@@ -331,7 +322,7 @@ miType Search::Pick(ML& ml)
 
         if (isftdown && (ply < MaxPVLen) && PVMove(ply).IsNotVoid())
           index = ml.LocateNoFail(PVMove(ply));
-        mgs.PutPs(psGainNext);
+        mgs.ResetPicker(); mgs.PutPs(psGainNext);
         break;
 
       case psGainNext:
@@ -350,9 +341,10 @@ miType Search::Pick(ML& ml)
     };
   };
 
-  // Mark the picked move, if any, as being searched
+  // Mark the picked move, if any, as being searched; record the move stack usage
 
-  if (index >= 0) ml.RefMove(index).SetFlagM(mfmSrch);
+  if (index >= 0) ml.SetFlagM(index, mfmSrch);
+  movestackptr->Mark(ply, ml);
   return index;
 }
 
@@ -374,6 +366,12 @@ svType Search::ABNode(const Window& window, const ML& priorml)
 
   nodecounter.Increment();
 
+#if (IsDevHost)
+  // Search statistics: all nodes and quiescence nodes
+
+  if (ssbptr) ssbptr->NoteNode(depth <= 0);
+#endif
+
   // Current variation trace
 
   if (TestOptionM(optnmCV)) {MarkCV(priorml); PrintOptn(optnCV); PrintCV(); PrintNL();};
@@ -390,21 +388,48 @@ svType Search::ABNode(const Window& window, const ML& priorml)
 
   if (IsTriggerBoardDisplayUpdate()) RedrawBoardDisplay();
 
-  // Elapsed wall time check for search termination; skipped for preliminary scoring
+  // Elapsed wall time check for search termination; skipped for preliminary scoring/resolution
 
-  if (IsTriggerTimeCheck() && IsPastTime() && !isprelim)
+  if (IsTriggerTimeCheck() && IsPastTime() && !isprelim && !isresolve)
   {
     Stop(stLimitTime); abort = done = true;
   };
 
-  // User interrupt check; skipped for preliminary scoring
+  // Node count check for search termination; the limit applies once there is a PV
 
-  if (!done && !isprelim && CheckInterrupt()) done = true;
+  if (!done && !isprelim && !isresolve && IsPastNodes()) {Stop(stLimitNodes); abort = done = true;};
+
+  // User interrupt check; skipped for preliminary scoring/resolution
+
+  if (!done && !isprelim && !isresolve && CheckInterrupt()) done = true;
 
   // Check for a likely draw at all nodes that are at least one ply away from the root
 
   if (!done && (ply > 0) && IsLikelyDraw()) {mywindow.PutAlfa(svEven); done = true;};
 
+#if (IsDevHost)
+  // Tablebase probe at full width nodes following a zeroing move (capture or pawn move)
+
+  if (!done && (ply > 0) && (depth > 0) && !SPos().GetHmvc() && IsTBProbeable())
+  {
+    si wdl;
+
+    tbprobecounter.Increment();
+    if (tbpptr->ProbeWDL(SPos(), wdl))
+    {
+      // Wins (and losses) sooner in the tree are preferred; fifty move rule results draw
+
+      tbhitcounter.Increment();
+      if (wdl == tbpwdlWin) mywindow.PutAlfa(svTBWin - ply);
+      else
+      {
+        if (wdl == tbpwdlLoss) mywindow.PutAlfa(-svTBWin + ply); else mywindow.PutAlfa(svEven);
+      };
+      done = true;
+    };
+  };
+#endif
+
   // Check for ply limit encounter; return evaluation if no further analysis is possible
 
   if (!done && (ply == MaxPlyLen)) {mywindow.PutAlfa(Evaluate()); done = true;};
@@ -435,7 +460,7 @@ svType Search::ABNode(const Window& window, const ML& priorml)
 
     abnType abn;
 
-    if ((ply == 0) && !isprelim) abn = abnBase;
+    if ((ply == 0) && !isprelim && !isresolve) abn = abnBase;
     else
     {
       if (InCheck()) abn = abnEvad;
@@ -445,10 +470,19 @@ svType Search::ABNode(const Window& window, const ML& priorml)
       };
     };
 
-    // Establish the local move list; moves already generated for the base node
+#if (IsDevHost)
+    // Search statistics: nodes by type
+
+    if (ssbptr) ssbptr->NoteABNode(abn);
+#endif
+
+    // Establish the local move list bound to the working position; moves already generated
+    // for the base node
 
     ML ml(priorml);
 
+    ml.BindBoard(SPos());
+
     // Special case move list for base node; moves are already generated and ordered
 
     if (abn == abnBase) ml.JamAssign(priorml);
@@ -486,22 +520,31 @@ svType Search::ABNode(const Window& window, const ML& priorml)
       !mywindow.IsCutOff() &&
       ((index = Pick(ml)) >= 0) &&
       !((abn == abnGain) &&
-        (spscore + ml.FetchMove(index).GetSv() + svMaxPos) <= mywindow.GetAlfa()) &&
+        (spscore + ml.GetSv(index) + svMaxPos) <= mywindow.GetAlfa()) &&
       !((abn == abnGain) && isprelim && alo))
     {
       svType tryscore;
 
+#if (IsDevHost)
+      // Search statistics: the pick state of the move and whether it's the first move
+
+      const psType ps = pickps;
+      const bool isfirst = !alo;
+
+      if (ssbptr) ssbptr->NotePick(ps);
+#endif
+
       // At this point at least one move is available, so neither checkmate nor stalemate
 
       alo = true;
 
       // Special handling for ply zero moves with certain scores
 
-      if ((ply == 0) && ml.FetchMove(index).IsCertain())
+      if ((ply == 0) && ml.IsCertain(index))
       {
         // Instead of searching this move, just retrieve its certain score
 
-        tryscore = ml.FetchMove(index).GetSv(); ClearLowerPV();
+        tryscore = ml.GetSv(index); ClearLowerPV();
       }
       else
       {
@@ -538,6 +581,12 @@ svType Search::ABNode(const Window& window, const ML& priorml)
 
         mywindow.PutAlfa(tryscore);
 
+#if (IsDevHost)
+        // Search statistics: beta cutoff
+
+        if (ssbptr && mywindow.IsCutOff()) ssbptr->NoteCutOff(ps, isfirst);
+#endif
+
         // If the new score in within the window then a new PV has been found
 
         if (tryscore < mywindow.GetBeta())
@@ -548,16 +597,28 @@ svType Search::ABNode(const Window& window, const ML& priorml)
 
           // Special extra handling for a new PV at the root
 
-          if ((ply == 0) && !isprelim)
+          if ((ply == 0) && !isprelim && !isresolve)
           {
-            // Record the new PV as the prior PV and apply marking to the prior PV
+            // Note a change of the best move, then record the new PV as the prior PV and
+            // apply marking to the prior PV
 
-            pvtable.CopyToPrior(tryscore); MarkPV(ml);
+            NotePick(ml.FetchMove(index)); LoadPriorPV(tryscore); MarkPV(ml);
 
             // Trace: Predicted variation
 
             if (TestOptionM(optnmPV)) {PrintOptn(optnPV); PrintPVAndScore(); PrintNL();};
 
+#if (IsDevHost)
+            // Trace stream: Predicted variation
+
+            if (stsid)
+              STS::NotePV(stsid, rootdepth, &PVMove(0), nodecounter, ElapsedMsec() - startmsec);
+#endif
+
+            // UCI protocol search information
+
+            if (TestOptionM(optnmUI)) PrintUCIInfo();
+
             // Move the new ply zero PV move to the front of the root move list
 
             ml.ShiftIndexedMoveToFront(index);
@@ -574,7 +635,7 @@ svType Search::ABNode(const Window& window, const ML& priorml)
     {
       // Handle the best move, if any
 
-      if (bestmove.IsNotVoid() && bestmove.IsHolder()) killers[ply] = bestmove;
+      if (bestmove.IsNotVoid() && bestmove.IsHolder()) killers[ply].ConvertFromMove(bestmove);
 
       // Checkmate/stalemate detection
 
@@ -586,6 +647,14 @@ svType Search::ABNode(const Window& window, const ML& priorml)
     depth = savedepth;
   };
 
+  // Move stack overflow check; the search stops as for a time limit, except for preliminary
+  // scoring/resolution where the truncated move list is accepted
+
+  if (movestackptr->IsOverflow() && NotStopped() && !isprelim && !isresolve)
+  {
+    Stop(stLimitMoves); abort = true;
+  };
+
   // Clear first time down status and return alpha as this node's value
 
   isftdown = false; if (abort) mywindow.PutAlfa(svBroken);
@@ -603,6 +672,47 @@ svType Search::ABRootNode(const Window& window, const ML& priorml)
   return ABNode(window, priorml);
 }
 
+#if (IsDevHost)
+void Search::ABMultiPVIteration(const Window& window)
+{
+  // Search the root moves once per rank, each time without the best moves of the prior
+  // ranks.  A rank's best move is shifted to the rank's place in the root move list, so
+  // the list order is the ranking and it orders the moves for the next iteration; the
+  // killers and the history are shared by all the ranks.
+
+  const miType rankcount =
+    (multipvcount < (ui) rootml.GetCount()) ? (miType) multipvcount : rootml.GetCount();
+  Move pvs[MultiPVLen][MaxPVLenP1];
+
+  multipvrank = 0;
+  while (NotStopped() && (multipvrank < (ui) rankcount))
+  {
+    ML tailml;
+    ui index = 0;
+
+    // The first time down path follows the prior iteration PV of the first move, if any
+
+    tailml.JamAssignTail(rootml, (miType) multipvrank);
+    while ((index < multipvcount) && !Move::SameMove(multipvs[index][0], tailml.FetchMove(0)))
+      index++;
+    if (index < multipvcount) pvtable.RestorePrior(multipvs[index]); else pvtable.ResetPrior();
+    ABRootNode(window, tailml); pvtable.SavePrior(pvs[multipvrank]);
+    multipvrank++;
+  };
+
+  // Keep the rank PVs for the next iteration; the first rank PV is the search result
+
+  for (ui rank = 0; rank < multipvcount; rank++)
+  {
+    if (rank < multipvrank)
+      for (plyType index = 0; index < MaxPVLenP1; index++) multipvs[rank][index] = pvs[rank][index];
+    else
+      multipvs[rank][0].MakeVoid();
+  };
+  pvtable.RestorePrior(pvs[0]); multipvrank = 0;
+}
+#endif
+
 void Search::ABIteration(const plyType iteration)
 {
   Window mywindow;
@@ -616,7 +726,15 @@ void Search::ABIteration(const plyType iteration)
 
   // Perform a full width window search iteration
 
-  mywindow.SetFullWidth(); depth = iteration + 1; ABRootNode(mywindow, rootml);
+  mywindow.SetFullWidth(); rootdepth = depth = iteration + 1;
+#if (IsDevHost)
+  if (multipvcount > 1) ABMultiPVIteration(mywindow); else ABRootNode(mywindow, rootml);
+  if (ssbptr) ssbptr->NoteIteration(nodecounter);
+  if (stsid) STS::NoteIteration(stsid, rootdepth, nodecounter, ElapsedMsec() - startmsec);
+#endif
+#if (IsTarget)
+  ABRootNode(mywindow, rootml);
+#endif
 }
 
 void Search::ABIterationSequence(const plyType limitply)
@@ -646,11 +764,51 @@ void Search::ABIterationSequence(const plyType limitply)
   };
 }
 
+#if (IsDevHost)
+void Search::ProbeRootTB(void)
+{
+  // Score each uncertain root move by its tablebase distance to a zeroing move; all
+  // scores are set only if all probes succeed so that the best move is then picked
+
+  const hmvcType hmvc = SPos().GetHmvc();
+  std::vector<si> dtzvec(rootml.GetCount(), 0);
+  bool okay = true;
+  miType index = 0;
+
+  tbprobecounter.Increment();
+  while (okay && (index < rootml.GetCount()))
+  {
+    if (rootml.IsNotCertain(index))
+      okay = tbpptr->ProbeRootMove(SPos(), RootMove(index), dtzvec[index]);
+    index++;
+  };
+
+  if (okay)
+  {
+    tbhitcounter.Increment();
+    for (index = 0; index < rootml.GetCount(); index++)
+    {
+      if (rootml.IsNotCertain(index))
+      {
+        const si dtz = dtzvec[index];
+        svType sv = svEven;
+
+        // Results beyond the reach of the fifty move rule are draws
+
+        if ((dtz > 0) && ((dtz + hmvc) < (Fifty * colorRLen))) sv = svTBWin - dtz;
+        if ((dtz < 0) && ((hmvc - dtz) < (Fifty * colorRLen))) sv = -svTBWin - dtz;
+        rootml.SetCertain(index, sv);
+      };
+    };
+  };
+}
+#endif
+
 void Search::ABSearch(const plyType limitply)
 {
-  // Generate the root move list
+  // Generate the root move list; notation marking is applied only to moves that get printed
 
-  GenCanonical(rootml);
+  Gen(rootml);
 
   // If not yet finished: Check for a no moves condition termination
 
@@ -665,10 +823,11 @@ void Search::ABSearch(const plyType limitply)
 
   if (NotStopped())
   {
-    // The root move list already has notiaton markings including mate markings
+    // Only check and checkmate markings are needed here
 
+    rootml.MarkChecksAndCheckmates(SPos());
     for (miType index = 0; index < rootml.GetCount(); index++)
-      if (RootMove(index).IsMate()) RootMove(index).SetCertain(svMateIn1);
+      if (rootml.IsMate(index)) rootml.SetCertain(index, svMateIn1);
   };
 
   // If not yet finished: Check for a mate in one termination
@@ -677,7 +836,7 @@ void Search::ABSearch(const plyType limitply)
   {
     const miType index = rootml.FindBestCertainIndex();
 
-    if ((index >= 0) && (RootMove(index).GetSv() == svMateIn1))
+    if ((index >= 0) && (rootml.GetSv(index) == svMateIn1))
     {
       pvtable.SetSingleMovePV(RootMove(index)); Stop(stMateIn1);
     };
@@ -689,15 +848,21 @@ void Search::ABSearch(const plyType limitply)
   {
     for (miType index = 0; index < rootml.GetCount(); index++)
     {
-      if (RootMove(index).IsNotCertain())
+      if (rootml.IsNotCertain(index))
       {
         DoExecute(RootMove(index));
-        if (IsDraw()) RootMove(index).SetCertain(svEven);
+        if (IsDraw()) rootml.SetCertain(index, svEven);
         DoRetract();
       };
     };
   };
 
+#if (IsDevHost)
+  // If not yet finished: Set certain scores (tablebase results)
+
+  if (NotStopped() && IsTBProbeable()) ProbeRootTB();
+#endif
+
   // If not yet finished: Check for an all moves certain scores termination
 
   if (NotStopped())
@@ -720,7 +885,7 @@ void Search::ABSearch(const plyType limitply)
 
     if (rootml.GetCount() == 1)
     {
-      RootMove(0).PutSv(svEven);
+      rootml.PutSv(0, svEven);
       pvtable.SetSingleMovePV(RootMove(0)); Stop(stSingleton);
     };
   };
@@ -735,13 +900,13 @@ void Search::ABSearch(const plyType limitply)
     {
       // Pick a book move (if any)
 
-      const miType index = Book::PickBookMove(rootml, spos);
+      const miType index = Book::PickBookMove(rootml, SPos());
 
       if (index >= 0)
       {
         // Opening book move was selected; handle as search result
 
-        RootMove(index).PutSv(svEven);
+        rootml.PutSv(index, svEven);
         pvtable.SetSingleMovePV(RootMove(index)); Stop(stBook);
       };
     };
@@ -759,14 +924,37 @@ void Search::ABSearch(const plyType limitply)
 
     if (IsPastTime())
     {
-      RootMove(0).PutSv(svEven); pvtable.SetSingleMovePV(RootMove(0)); Stop(stLimitTime);
+      rootml.PutSv(0, svEven); pvtable.SetSingleMovePV(RootMove(0)); Stop(stLimitTime);
     }
     else
       ABIterationSequence(limitply);
   };
 }
 
-void Search::RunABSearch(const ui32 limitmsec, const plyType limitply)
+#if (IsDevHost)
+void Search::ResolveQuiescence(FPos& fpos)
+{
+  // Locate the quiescent position at the end of the gainer search PV; used for tuning
+
+  Window mywindow;
+
+  isresolve = true; mywindow.SetFullWidth(); depth = 0;
+  LoadPriorPV(ABRootNode(mywindow, rootml));
+  isresolve = false;
+
+  // Advance along the PV to its leaf, copy the leaf position, and then return to ply zero
+
+  while (PVMove(ply).IsNotVoid()) DoExecute(PVMove(ply));
+  fpos = SPos();
+  while (ply) DoRetract();
+
+  // Leave the search as it would be after a position load
+
+  ResetAux();
+}
+#endif
+
+void Search::RunABSearch(const ui32 limitmsec, const plyType limitply, const ui32 limitnodes)
 {
   // Initial activity LED update
 
@@ -785,9 +973,24 @@ void Search::RunABSearch(const ui32 limitmsec, const plyType limitply)
     PrintFSL(fsLbDepthLimit); PrintUi16(limitply); PrintNL();
   };
 
-  // Perform the pre-search initialization
+  // Perform the pre-search initialization; this leaves any pending interrupt or time limit
+  // restart request in place as it may have been made by another thread just before the start
+
+  ResetAux(); timeoutmsec = startmsec + limitmsec; stopnodes = limitnodes;
+
+#if (IsDevHost)
+  // Select the evaluator: the neural network if requested and loaded, else the classic
 
-  ResetAux(); timeoutmsec = startmsec + limitmsec;
+  SPos().AttachNNE(TestOptionM(optnmNN) ? nneptr : 0);
+
+  // Attach the statistics block if requested
+
+  ssbptr = TestOptionM(optnmSS) ? &ssb : 0; ssb.Reset(); PRF::AttachSSB(ssbptr);
+
+  // Start the trace stream events if the stream is open
+
+  stsid = STS::NoteStart(SPos(), false, limitply, limitmsec, limitnodes);
+#endif
 
   // Run the search and get the timing
 
@@ -811,6 +1014,17 @@ void Search::RunABSearch(const ui32 limitmsec, const plyType limitply)
 
   Trace1();
 
+#if (IsDevHost)
+  // Search statistics trace; the block is detached until the next search
+
+  if (ssbptr) {PrintOptn(optnSS); ssb.PrintJSON(); PrintNL();};
+  ssbptr = 0; PRF::AttachSSB(0);
+
+  // Trace stream: Search termination and result
+
+  if (stsid) {STS::NoteEnd(stsid, st, &PVMove(0), nodecounter, usedmsec); stsid = 0;};
+#endif
+
   // Final activity LED update
 
   actledstate = false; UpdateActivityLED();
@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -20,22 +21,35 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
 #include "Search.h"
+#include "STS.h"
 
 void Search::MPAuxML(const ML& ml)
 {
   // Enumerate movepaths for a move list
 
+  movestackptr->Mark(ply, ml);
+
+  // A move stack overflow means the list is incomplete; the enumeration stops
+
+  if (movestackptr->IsOverflow() && NotStopped()) {Stop(stLimitMoves); abort = true;};
+
   if (NotStopped() && !CheckInterrupt())
   {
     for (miType index = 0; NotStopped() && (index < ml.GetCount()); index++)
@@ -72,9 +86,17 @@ void Search::MPAuxML(const ML& ml)
 
         if (TestOptionM(optnmPZ))
         {
-          PrintOptn(optnPZ); ml.FetchMove(index).Print();
+          Move move = ml.FetchMove(index);
+
+          move.Mark(SPos(), ml); PrintOptn(optnPZ); move.Print();
           PrintISM(); counter1.Print(); PrintNL();
         };
+
+#if (IsDevHost)
+        // Trace stream: ply zero movepath count
+
+        if (stsid) STS::NotePerft(stsid, ml.FetchMove(index), counter1);
+#endif
       };
     };
   };
@@ -93,7 +115,7 @@ void Search::MPAux(const ML& priorml)
       {
         ML ml(priorml);
 
-        GenCanonical(ml); MPAuxML(ml);
+        Gen(ml); MPAuxML(ml);
       }
       else
       {
@@ -110,14 +132,15 @@ void Search::MPAux(const ML& priorml)
           {
             for (pieceType piece = piecePawn; NotStopped() && (piece <= pieceKing); piece++)
             {
-              TBV tbv = spos.FetchTBVBCP(spos.GetGood(), piece);
+              TBV tbv = SPos().FetchTBVBCP(SPos().GetGood(), piece);
               tidType tid;
               ML ml(priorml);
 
+              ml.BindBoard(SPos());
               while (NotStopped() && IsTidNotNil(tid = tbv.NextTid()))
               {
                 ml.ResetCount();
-                spos.GenAddNonEvasionFromSquare(genmAll, spos.GetTidToSqr(tid), ml);
+                SPos().GenAddNonEvasionFromSquare(genmAll, SPos().GetTidToSqr(tid), ml);
                 MPAuxML(ml);
               };
             };
@@ -148,6 +171,9 @@ void Search::RunMP(const plyType limitply, const bool fast)
   // Perform the pre-enumeration initialization
 
   ResetAux(); depth = (depthType) limitply; fastmp = fast;
+#if (IsDevHost)
+  stsid = STS::NoteStart(SPos(), true, limitply, 0, 0);
+#endif
 
   // Perform the enumeration with timing
 
@@ -159,11 +185,13 @@ void Search::RunMP(const plyType limitply, const bool fast)
 
   Trace1();
 
-  // Final activity LED update
+#if (IsDevHost)
+  // Trace stream: Enumeration termination
 
-  actledstate = false; UpdateActivityLED();
+  if (stsid) {STS::NoteEnd(stsid, st, 0, nodecounter, usedmsec); stsid = 0;};
+#endif
 
-  // Output final sum
+  // Final activity LED update
 
-  PrintFSL(fsLbNodes); nodecounter.Print(); PrintNL();
+  actledstate = false; UpdateActivityLED();
 }
@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #endif
 
@@ -20,27 +21,46 @@
 #include "FEnv.h"
 #include "FPos.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "NNE.h"
+#include "MT.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
 #include "Search.h"
 #include "State.h"
+#include "TBP.h"
+
+#if (IsDevHost)
+State::~State(void)
+{
+  // Release the neural network evaluator and the tablebases, if any
+
+  delete nneptr; delete tbpptr;
+}
+#endif
 
 void State::OneTimeSetup(void)
 {
   // Perform a one-time setup of the State single-instance object
 
-  isdone = false; interrupt = false; loopcount = 0; options = 0;
-  SetDefaultLimits(); movelist.Preset(movestack, MoveStackLen); ResetStacks();
-  search.OneTimeSetup(movelist, history, undostack); search.RedrawBoardDisplay();
+  MT::OneTimeSetup();
+  isdone = false; interrupt = false; loopcount = 0; options = 0; pondermove.MakeVoid();
+  SetDefaultLimits(); ResetStacks();
+  search.OneTimeSetup(movestack, history, undostack); search.RedrawBoardDisplay();
 }
 
 void State::Interrupt(void)
@@ -54,7 +74,7 @@ void State::SetDefaultLimits(void)
 {
   // Set the search limits to their default values
 
-  limitmsec = DefaultST * 1000ul; limitply = DefaultSD;
+  limitmsec = DefaultST * 1000ul; limitply = DefaultSD; limitnodes = 0;
 }
 
 void State::NewGame(void)
@@ -87,6 +107,41 @@ void State::Flip(void)
   ResetStacks(); search.Flip(); search.RedrawBoardDisplay();
 }
 
+#if (IsDevHost)
+bool State::LoadNetwork(const char *fn)
+{
+  // Load a neural network evaluator; it is used by searches when the "nn" option is set
+
+  NNE *ptr = new NNE;
+  const bool okay = ptr->LoadFromFile(fn);
+
+  if (!okay) delete ptr;
+  else
+  {
+    // The search position switches to the new evaluator before the old one is released
+
+    search.PutNNEPtr(ptr); delete nneptr; nneptr = ptr;
+  };
+  return okay;
+}
+
+bool State::LoadTablebases(const char *dirname, const ui limit)
+{
+  // Load the tablebases in a directory; they are probed by searches when the "tb" option is set
+
+  TBP *ptr = new TBP;
+  const bool okay = ptr->LoadFromDir(dirname);
+
+  if (!okay) delete ptr;
+  else
+  {
+    delete tbpptr; tbpptr = ptr;
+    search.PutTBP(tbpptr, (limit < tbpptr->GetMaxMen()) ? limit : tbpptr->GetMaxMen());
+  };
+  return okay;
+}
+#endif
+
 void State::LoadStateFromFPos(const FPos& fpos)
 {
   // Load a new position into the search state
@@ -13,6 +13,16 @@
 class State
 {
   public:
+#if (IsDevHost)
+    State(void) {nneptr = 0; tbpptr = 0;}
+    ~State(void);
+
+    // Not copyable: the evaluator and the tablebases are owned
+
+    State(const State&) = delete;
+    State& operator=(const State&) = delete;
+#endif
+
     void OneTimeSetup(void);
 
     bool IsDone(void) const {return isdone;}
@@ -24,22 +34,37 @@ class State
     void IncLoopCount(void) {loopcount++;}
 
     bool TestInterrupt(void) {return interrupt;}
-    void ResetInterrupt(void) {interrupt = false;}
+    void ResetInterrupt(void) {interrupt = false; search.ResetRequests();}
+
+    void RestartTimeLimit(const msType value) {search.RestartTimeLimit(value);}
 
     miType GetUnDoCount(void) const {return undostack.GetCount();}
 
-    void SetOption(const optnType optn) {options |= BX(optn); SendOptions();}
-    void ResetOption(const optnType optn) {options &= ~BX(optn); SendOptions();}
-    bool TestOption(const optnType optn) const {return options & BX(optn);}
+    void SetOption(const optnType optn) {options |= BXL(optn); SendOptions();}
+    void ResetOption(const optnType optn) {options &= ~BXL(optn); SendOptions();}
+    bool TestOption(const optnType optn) const {return options & BXL(optn);}
 
     void ResetOptions(void) {options = 0; SendOptions();}
 
+    EPV& RefEPV(void) {return search.RefEPV();}
+
+#if (IsDevHost)
+    bool LoadNetwork(const char *fn);
+    bool LoadTablebases(const char *dirname, const ui limit);
+
+    ui GetMultiPVCount(void) const {return search.GetMultiPVCount();}
+    void PutMultiPVCount(const ui value) {search.PutMultiPVCount(value);}
+#endif
+
     msType GetLimitMsec(void) const {return limitmsec;}
     void PutLimitMsec(const msType value) {limitmsec = value;}
 
     plyType GetLimitPly(void) const {return limitply;}
     void PutLimitPly(const plyType value) {limitply = value;}
 
+    ui32 GetLimitNodes(void) const {return limitnodes;}
+    void PutLimitNodes(const ui32 value) {limitnodes = value;}
+
     const FEnv& FetchSearchFEnv(void) const {return search.FetchSearchFEnv();}
     const FPos& FetchSearchFPos(void) const {return search.FetchSearchFPos();}
     const Hash& FetchPosHash(void) const {return search.FetchPosHash();}
@@ -57,7 +82,12 @@ class State
     void Play(const Move& move);
     void Unplay(void);
 
-    const Move& FetchLastMove(void) const {return undostack.FetchTopMove();}
+    Move FetchLastMove(void) const {return undostack.FetchTopMove();}
+    const FEnv& FetchLastFEnv(void) const {return undostack.FetchTopFEnv();}
+
+    const Move& FetchPonderMove(void) const {return pondermove;}
+    void PutPonderMove(const Move& move) {pondermove = move;}
+    void ResetPonderMove(void) {pondermove.MakeVoid();}
 
     void Flip(void);
 
@@ -67,29 +97,58 @@ class State
     void PrintBookMoveList(void) {search.PrintBookMoveList();}
 
     void MatchMove(const char *str, Move& move) {search.MatchMove(str, move);}
+    void MatchUCIMove(const char *str, Move& move) {search.MatchUCIMove(str, move);}
 
     void LoadStateFromFPos(const FPos& fpos);
 
     const Move& PVMove(const plyType ply) const {return search.PVMove(ply);}
 
     void RunMP(const plyType emplimitply, const bool fast) {search.RunMP(emplimitply, fast);}
-    void RunABSearch(void) {search.RunABSearch(limitmsec, limitply);}
+    void RunABSearch(void) {search.RunABSearch(limitmsec, limitply, limitnodes);}
+    void RunPonderSearch(void) {search.RunABSearch(msInfinite, limitply, limitnodes);}
+
+    const Counter& FetchNodeCounter(void) const {return search.FetchNodeCounter();}
+    ui32 GetNodeCount(void) const {return search.GetNodeCount();}
+    msType GetUsedMsec(void) const {return search.GetUsedMsec();}
+
+    msType GetPickMsec(void) const {return search.GetPickMsec();}
+    ui32 GetPickNodes(void) const {return search.GetPickNodes();}
+
+#if (IsDevHost)
+    void ResolveQuiescence(FPos& fpos) {search.ResolveQuiescence(fpos);}
+#endif
 
   private:
-    void SendOptions(void) {search.RefOptions() = options;}
+    void SendOptions(void)
+    {
+      search.RefOptions() = options;
+#if (IsDevHost)
+      search.SyncNNE();
+#endif
+    }
     void ResetStacks(void) {history.Reset(); undostack.Reset();}
 
     bool isdone;
+#if (IsDevHost)
+    std::atomic<bool> interrupt;
+#endif
+#if (IsTarget)
     volatile bool interrupt;
+#endif
     ui16 loopcount;
     optnmType options;
     msType limitmsec;
     plyType limitply;
-    Move movestack[MoveStackLen];
-    ML movelist;
+    ui32 limitnodes;
+    Move pondermove;
+    MoveStack movestack;
     History history;
     Search search;
     UnDoStack undostack;
+#if (IsDevHost)
+    NNE *nneptr;
+    TBP *tbpptr;
+#endif
 };
 
 #endif
@@ -0,0 +1,1277 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if (IsDevHost)
+
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "ML.h"
+#include "Hash.h"
+#include "TBV.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "Pos.h"
+#include "TBP.h"
+
+// Table file kinds
+
+#define tbpkWDL 0 // Win/draw/loss
+#define tbpkDTZ 1 // Distance to zeroing move
+#define tbpkLen 2
+
+// Value stream flag masks (from the stream header byte)
+
+#define tbpfmDTZBlack    0x01 // DTZ: the stored side to move is Black
+#define tbpfmDTZMapped   0x02 // DTZ: stored values index a value map
+#define tbpfmDTZWinPlies 0x04 // DTZ: win distances are in plies, not moves
+#define tbpfmDTZLosePlies 0x08 // DTZ: loss distances are in plies, not moves
+#define tbpfmDTZWideMap  0x10 // DTZ: value map entries are 16 bits
+#define tbpfmConstant    0x80 // Every position has the same value
+
+// Probe status
+
+typedef enum
+{
+  tbpsNil = -1,
+  tbpsFail,       // Missing or unusable table
+  tbpsOkay,       // Value found
+  tbpsOtherSide,  // The DTZ table has only the other side to move
+  tbpsZeroingBest // A zeroing move (capture or pawn move) is best
+} tbpsType;
+
+// Pawn table lead file count (files a-d; the others are mirrored)
+
+#define tbpLeadFileLen 4
+
+// Pawn squares (ranks two through seven) and the pair symbol leaf marker
+
+#define tbpPawnSqrLen 48
+#define tbpLeafSym    0x0fff
+
+// File name suffixes and leading magic words (little endian) by table kind
+
+static const char * const tbpsuffixes[tbpkLen] = {".rtbw", ".rtbz"};
+
+static const ui32 tbpmagics[tbpkLen] = {0x5d23e871, 0xa50c66d7};
+
+// One compressed value stream (one side to move and lead file of a table file) along
+// with its index layout
+
+struct TBPStream
+{
+  // Index layout
+
+  ui8 codes[tbpMenLen];        // Man codes in encoding order
+  ui groupcount;               // Count of man groups
+  ui grouplens[tbpMenLen];     // Man count of each group; the lead group is first
+  ui64 groupfactors[tbpMenLen]; // Index multiplier of each group
+  ui64 indexlen;               // Index range
+
+  // Value decoding
+
+  ui8 flags;                   // Stream flags
+  ui8 constvalue;              // Value of every position (constant stream only)
+  ui blockshift;               // Log2 of the block byte length
+  ui spanshift;                // Log2 of the positions covered by a sparse index entry
+  ui32 blockcount;             // Count of compressed blocks
+  ui minbits;                  // Shortest code length
+  std::vector<ui64> firstcodes; // Smallest code value of each code length
+  std::vector<ui32> firstsyms; // Symbol of the smallest code of each code length
+  std::vector<ui32> spreads;   // Count of values each symbol expands to
+  ui64 pairsat;                // File offset: symbol pair table
+  ui64 sparseat;               // File offset: sparse index (six bytes per entry)
+  ui64 blocklensat;            // File offset: block value counts less one (16 bits each)
+  ui64 blocksat;               // File offset: compressed blocks
+  ui64 sparselen;              // Count of sparse index entries
+  ui64 blocklenslen;           // Count of block value count entries (including padding)
+  ui64 mapsat[4];              // File offsets: DTZ value maps by result class
+};
+
+// One table file, memory mapped on first use
+
+struct TBPFile
+{
+  bool tried;                  // Mapping has been attempted
+  bool ready;                  // Mapping and parsing succeeded
+  const ui8 *image;            // Mapped file image
+  ui64 imagelen;               // Mapped file length
+  TBPStream streams[colorRLen][tbpLeadFileLen]; // By stored side and lead pawn file
+};
+
+// One table: a material balance with its WDL and DTZ files
+
+struct TBPTable
+{
+  std::string name;            // File name stem; e.g., KRPvKR
+  ui64 whitekey;               // Material key with the first listed side as White
+  ui64 blackkey;               // Material key with the first listed side as Black
+  ui mencount;                 // Count of all men
+  bool haspawns;               // Some pawns
+  bool hassingles;             // Some side has a single non-king man of some piece
+  ui leadpawncount;            // Pawn count of the lead pawn color
+  ui otherpawncount;           // Pawn count of the other color
+  TBPFile files[tbpkLen];      // WDL and DTZ files
+};
+
+// All registered tables
+
+struct TBPData
+{
+  std::string dirname;
+  std::vector<TBPTable *> tables;
+  std::map<ui64, TBPTable *> tablemap;
+};
+
+// Index encoding tables; built once by the first instance
+
+static bool tbpbuilt = false;
+
+static si tbptriangle[sqrLen];                    // a1-d1-d4 code: below diagonal first
+static si tbpbelow[sqrLen];                       // Below diagonal square code (b1-h7)
+static ui tbpkingpair[10][sqrLen];                // King pair code by first king triangle
+static ui64 tbpchoose[tbpMenLen][sqrLen + 1];     // Binomial coefficients by k and n
+static ui tbppawnorder[sqrLen];                   // Pawn squares ordered below a pawn square
+static ui64 tbpleadbase[tbpMenLen][sqrLen];       // Lead pawn group base by count and square
+static ui64 tbpleadlen[tbpMenLen][tbpLeadFileLen]; // Lead pawn group range by count and file
+static ui64 tbptriplebase[4];                     // Three single men code base by case
+static ui64 tbptriplelen;                         // Three single men code range
+static ui64 tbpkingpairlen;                       // King pair code range
+
+// Little endian file fields
+
+static ui ReadLE16(const ui8 *ptr) {return ptr[0] | (ptr[1] << 8);}
+
+static ui32 ReadLE32(const ui8 *ptr)
+{
+  return ((ui32) ReadLE16(ptr)) | (((ui32) ReadLE16(ptr + 2)) << 16);
+}
+
+// Square geometry
+
+static si Diagonality(const si sqr) {return MapSqrToRank(sqr) - MapSqrToFile(sqr);}
+
+static bool IsKingStep(const si sqr0, const si sqr1)
+{
+  // Are the squares the same or a king step apart?
+
+  const si filedelta = MapSqrToFile(sqr0) - MapSqrToFile(sqr1);
+  const si rankdelta = MapSqrToRank(sqr0) - MapSqrToRank(sqr1);
+
+  return (filedelta * filedelta <= 1) && (rankdelta * rankdelta <= 1);
+}
+
+// Square transforms; applied as a set to all of the men of a position
+
+#define tbptMirror    0x01 // Files a-h become h-a
+#define tbptFlip      0x02 // Ranks 1-8 become 8-1
+#define tbptTranspose 0x04 // Reflect about the a1-h8 diagonal
+
+static si Transform(const si sqr, const ui tbpt)
+{
+  si result = sqr;
+
+  if (tbpt & tbptMirror) result ^= 0x07;
+  if (tbpt & tbptFlip) result ^= 0x38;
+  if (tbpt & tbptTranspose) result = ((result & 0x07) << 3) | (result >> 3);
+  return result;
+}
+
+static void BuildEncoding(void)
+{
+  // Build the index encoding tables
+
+  // Binomial coefficients, row by row
+
+  for (ui n = 0; n <= sqrLen; n++)
+  {
+    tbpchoose[0][n] = 1;
+    for (ui k = 1; k < tbpMenLen; k++)
+      tbpchoose[k][n] = (n == 0) ? 0 : (tbpchoose[k - 1][n - 1] + tbpchoose[k][n - 1]);
+  };
+
+  // The ten a1-d1-d4 triangle squares: the six below the diagonal, then the four on it
+
+  si code = 0;
+
+  for (si sqr = 0; sqr < sqrLen; sqr++) tbptriangle[sqr] = tbpbelow[sqr] = -1;
+  for (ui pass = 0; pass < 2; pass++)
+    for (si sqr = 0; sqr < sqrLen; sqr++)
+      if ((MapSqrToFile(sqr) <= fileD) && (MapSqrToRank(sqr) <= rank4))
+        if ((pass == 0) ? (Diagonality(sqr) < 0) : (Diagonality(sqr) == 0))
+          tbptriangle[sqr] = code++;
+
+  // The 28 squares below the diagonal
+
+  code = 0;
+  for (si sqr = 0; sqr < sqrLen; sqr++) if (Diagonality(sqr) < 0) tbpbelow[sqr] = code++;
+
+  // King pairs with the first king on the triangle, by triangle code and second king square:
+  // a king on the diagonal has its partner not above the diagonal, and the pairs with both
+  // kings on the diagonal are coded last
+
+  code = 0;
+  for (ui pass = 0; pass < 2; pass++)
+    for (si tri = 0; tri < 10; tri++)
+    {
+      si sqr0 = 0;
+
+      while (tbptriangle[sqr0] != tri) sqr0++;
+      for (si sqr1 = 0; sqr1 < sqrLen; sqr1++)
+      {
+        const bool bothon = !Diagonality(sqr0) && !Diagonality(sqr1);
+
+        if (
+            !IsKingStep(sqr0, sqr1) && (Diagonality(sqr0) || (Diagonality(sqr1) <= 0)) &&
+            (bothon == (pass == 1)))
+          tbpkingpair[tri][sqr1] = code++;
+      };
+    };
+  tbpkingpairlen = code;
+
+  // Three single men cases by the count of leading men on the diagonal: zero (6 * 63 * 62),
+  // one (4 * 28 * 62), two (4 * 7 * 28), or three (4 * 7 * 6)
+
+  const ui64 triplelens[4] = {6 * 63 * 62, 4 * 28 * 62, 4 * 7 * 28, 4 * 7 * 6};
+
+  tbptriplelen = 0;
+  for (ui index = 0; index < 4; index++)
+  {
+    tbptriplebase[index] = tbptriplelen; tbptriplelen += triplelens[index];
+  };
+
+  // Pawn square order: outer file pairs first, lower ranks first, the queen side first
+
+  for (si sqr = 0; sqr < sqrLen; sqr++)
+  {
+    const si file = MapSqrToFile(sqr), rank = MapSqrToRank(sqr);
+    const si filepair = (file <= fileD) ? file : (fileH - file);
+
+    tbppawnorder[sqr] =
+      ((rank < rank2) || (rank > rank7)) ? 0 :
+        (tbpPawnSqrLen - 1) - ((filepair * 12) + ((rank - rank2) * 2) + ((file > fileD) ? 1 : 0));
+  };
+
+  // Lead pawn group bases: the lead pawn square's rank, up the file, with the other lead
+  // pawns on any squares ordered below it
+
+  for (ui count = 1; count < tbpMenLen; count++)
+    for (si file = fileA; file <= fileD; file++)
+    {
+      ui64 base = 0;
+
+      for (si rank = rank2; rank <= rank7; rank++)
+      {
+        const si sqr = MapFileRankToSqr((fileType) file, (rankType) rank);
+
+        tbpleadbase[count][sqr] = base; base += tbpchoose[count - 1][tbppawnorder[sqr]];
+      };
+      tbpleadlen[count][file] = base;
+    };
+}
+
+static ui64 CalcKey(const ui counts[colorRLen][pieceRLen])
+{
+  // Material key: a four bit count for each color and non-king piece
+
+  ui64 key = 0;
+
+  for (ui color = 0; color < colorRLen; color++)
+    for (ui piece = piecePawn; piece < pieceKing; piece++)
+      key |= ((ui64) counts[color][piece]) << (((color * pieceKing) + piece) * 4);
+  return key;
+}
+
+static ui8 CalcManCode(const manType man)
+{
+  // Table man code: the piece plus one, plus eight for Black
+
+  return (ui8) ((IsColorBlack(cvmantocolor[man]) ? 8 : 0) + cvmantopiece[man] + 1);
+}
+
+static void SetLayout(
+  const TBPTable& table, TBPStream& stream,
+  const ui leadslot, const ui pawnslot, const ui file)
+{
+  // Group the men and calculate the index multiplier of each group
+
+  const ui leadlen = table.haspawns ? table.leadpawncount : (table.hassingles ? 3 : 2);
+
+  stream.groupcount = 1; stream.grouplens[0] = leadlen;
+  for (ui index = leadlen; index < table.mencount; index++)
+  {
+    if ((index > leadlen) && (stream.codes[index] == stream.codes[index - 1]))
+      stream.grouplens[stream.groupcount - 1]++;
+    else
+      stream.grouplens[stream.groupcount++] = 1;
+  };
+
+  // The lead group and any second pawn group have their own multiplier slots; the other
+  // groups fill the remaining slots in order
+
+  const bool twopawngroups = table.haspawns && table.otherpawncount;
+  ui freesqrs = sqrLen - leadlen - (twopawngroups ? stream.grouplens[1] : 0);
+  ui nextgroup = twopawngroups ? 2 : 1, placed = 0, slot = 0;
+  ui64 factor = 1;
+
+  while (placed < stream.groupcount)
+  {
+    if (slot == leadslot)
+    {
+      stream.groupfactors[0] = factor;
+      factor *=
+        table.haspawns ? tbpleadlen[leadlen][file] :
+          (table.hassingles ? tbptriplelen : tbpkingpairlen);
+    }
+    else
+    {
+      if (twopawngroups && (slot == pawnslot))
+      {
+        stream.groupfactors[1] = factor;
+        factor *= tbpchoose[stream.grouplens[1]][tbpPawnSqrLen - leadlen];
+      }
+      else
+      {
+        stream.groupfactors[nextgroup] = factor;
+        factor *= tbpchoose[stream.grouplens[nextgroup]][freesqrs];
+        freesqrs -= stream.grouplens[nextgroup++];
+      };
+    };
+    placed++; slot++;
+  };
+  stream.indexlen = factor;
+}
+
+static void ReadPair(const ui8 *pairsptr, const ui sym, ui& left, ui& right)
+{
+  // A pair table entry: two 12 bit symbols; a leaf has its value on the left
+
+  const ui8 *ptr = pairsptr + (sym * 3);
+
+  left = ptr[0] | ((ptr[1] & 0x0f) << 8); right = (ptr[1] >> 4) | (ptr[2] << 4);
+}
+
+static ui64 ParseStream(const ui8 *image, ui64 at, TBPStream& stream)
+{
+  // Read the header of a value stream; return the offset that follows it
+
+  stream.flags = image[at++];
+  stream.blockcount = 0; stream.sparselen = stream.blocklenslen = 0;
+  if (stream.flags & tbpfmConstant) stream.constvalue = image[at++];
+  else
+  {
+    stream.blockshift = image[at++]; stream.spanshift = image[at++];
+    stream.sparselen = (stream.indexlen + (((ui64) 1) << stream.spanshift) - 1) >> stream.spanshift;
+
+    const ui padding = image[at++];
+
+    stream.blockcount = ReadLE32(image + at); at += 4;
+    stream.blocklenslen = stream.blockcount + padding;
+
+    const ui maxbits = image[at++];
+
+    stream.minbits = image[at++];
+
+    // Canonical code: each code length's symbols are numbered upward from the symbol of its
+    // smallest code, and a shorter code's smallest value follows from the next longer one
+
+    const ui lengthcount = maxbits - stream.minbits + 1;
+
+    stream.firstsyms.resize(lengthcount); stream.firstcodes.resize(lengthcount);
+    for (ui index = 0; index < lengthcount; index++)
+      stream.firstsyms[index] = ReadLE16(image + at + (index * 2));
+    at += lengthcount * 2;
+    stream.firstcodes[lengthcount - 1] = 0;
+    for (si index = (si) lengthcount - 2; index >= 0; index--)
+      stream.firstcodes[index] =
+        (stream.firstcodes[index + 1] + stream.firstsyms[index] - stream.firstsyms[index + 1]) / 2;
+
+    // Symbol pairs: each symbol is a leaf value or a pair of other symbols
+
+    const ui symcount = ReadLE16(image + at);
+
+    at += 2; stream.pairsat = at; at += (symcount * 3) + (symcount & 1);
+
+    // Count the values of each symbol; unresolved pairs are pushed down to their members
+
+    std::vector<ui32> pending;
+
+    stream.spreads.assign(symcount, 0);
+    for (ui sym = 0; sym < symcount; sym++)
+    {
+      pending.push_back(sym);
+      while (!pending.empty())
+      {
+        const ui top = pending.back();
+        ui left, right;
+
+        ReadPair(image + stream.pairsat, top, left, right);
+
+        if (stream.spreads[top]) pending.pop_back();
+        else
+        {
+          if (right == tbpLeafSym) {stream.spreads[top] = 1; pending.pop_back();}
+          else
+          {
+            if (stream.spreads[left] && stream.spreads[right])
+            {
+              stream.spreads[top] = stream.spreads[left] + stream.spreads[right];
+              pending.pop_back();
+            }
+            else
+            {
+              if (!stream.spreads[left]) pending.push_back(left);
+              if (!stream.spreads[right]) pending.push_back(right);
+            };
+          };
+        };
+      };
+    };
+  };
+  return at;
+}
+
+static bool ParseFile(TBPTable& table, const ui kind)
+{
+  // Locate the streams of a freshly mapped file; return false if it is malformed
+
+  TBPFile& tbpfile = table.files[kind];
+  const ui8 *image = tbpfile.image;
+  const bool twosides = (kind == tbpkWDL) && (image[4] & 0x01);
+  const ui sidecount = twosides ? 2 : 1, filecount = table.haspawns ? tbpLeadFileLen : 1;
+  const bool twopawngroups = table.haspawns && table.otherpawncount;
+  ui64 at = 5;
+
+  // For each lead file: the multiplier slots of the lead and second pawn groups, then the man
+  // codes in encoding order; each byte has the first side in its low nibble
+
+  for (ui file = 0; file < filecount; file++)
+  {
+    const ui8 slotbyte = image[at], pawnslotbyte = twopawngroups ? image[at + 1] : 0xff;
+
+    at += twopawngroups ? 2 : 1;
+    for (ui side = 0; side < sidecount; side++)
+    {
+      TBPStream& stream = tbpfile.streams[side][file];
+      const ui shift = side ? 4 : 0;
+
+      for (ui index = 0; index < table.mencount; index++)
+        stream.codes[index] = (image[at + index] >> shift) & 0x0f;
+      SetLayout(
+        table, stream, (slotbyte >> shift) & 0x0f,
+        twopawngroups ? ((pawnslotbyte >> shift) & 0x0f) : tbpMenLen, file);
+    };
+    at += table.mencount;
+  };
+  at += at & 1;
+
+  // Stream headers
+
+  for (ui file = 0; file < filecount; file++)
+    for (ui side = 0; side < sidecount; side++)
+      at = ParseStream(image, at, tbpfile.streams[side][file]);
+
+  // DTZ value maps: four per mapped stream (win, loss, cursed win, and blessed loss)
+
+  if (kind == tbpkDTZ)
+  {
+    for (ui file = 0; file < filecount; file++)
+    {
+      TBPStream& stream = tbpfile.streams[0][file];
+
+      if (stream.flags & tbpfmDTZMapped)
+      {
+        const bool wide = stream.flags & tbpfmDTZWideMap;
+
+        if (wide) at += at & 1;
+        for (ui index = 0; index < 4; index++)
+        {
+          const ui count = wide ? ReadLE16(image + at) : image[at];
+
+          stream.mapsat[index] = at + (wide ? 2 : 1);
+          at = stream.mapsat[index] + (count * (wide ? 2 : 1));
+        };
+      };
+    };
+    at += at & 1;
+  };
+
+  // Sparse indexes, block value counts, and the 64 byte aligned compressed blocks
+
+  for (ui file = 0; file < filecount; file++)
+    for (ui side = 0; side < sidecount; side++)
+    {
+      TBPStream& stream = tbpfile.streams[side][file];
+
+      stream.sparseat = at; at += stream.sparselen * 6;
+    };
+  for (ui file = 0; file < filecount; file++)
+    for (ui side = 0; side < sidecount; side++)
+    {
+      TBPStream& stream = tbpfile.streams[side][file];
+
+      stream.blocklensat = at; at += stream.blocklenslen * 2;
+    };
+  for (ui file = 0; file < filecount; file++)
+    for (ui side = 0; side < sidecount; side++)
+    {
+      TBPStream& stream = tbpfile.streams[side][file];
+
+      at = (at + 63) & ~((ui64) 63);
+      stream.blocksat = at; at += ((ui64) stream.blockcount) << stream.blockshift;
+    };
+
+  // A one sided WDL file serves both sides to move
+
+  if (!twosides)
+    for (ui file = 0; file < filecount; file++) tbpfile.streams[1][file] = tbpfile.streams[0][file];
+
+  return at <= tbpfile.imagelen;
+}
+
+static bool MapFile(const std::string& dirname, TBPTable& table, const ui kind)
+{
+  // Map and parse a table file on its first use; return readiness
+
+  TBPFile& tbpfile = table.files[kind];
+
+  if (!tbpfile.tried)
+  {
+    const std::string fn = dirname + "/" + table.name + tbpsuffixes[kind];
+    const int fd = open(fn.c_str(), O_RDONLY);
+
+    tbpfile.tried = true;
+    if (fd >= 0)
+    {
+      struct stat statbuf;
+
+      if ((fstat(fd, &statbuf) == 0) && (statbuf.st_size > 16) && ((statbuf.st_size % 64) == 16))
+      {
+        void *ptr = mmap(0, statbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (ptr != MAP_FAILED)
+        {
+          tbpfile.image = (const ui8 *) ptr; tbpfile.imagelen = statbuf.st_size;
+          tbpfile.ready = (ReadLE32(tbpfile.image) == tbpmagics[kind]) && ParseFile(table, kind);
+        };
+      };
+      close(fd);
+    };
+  };
+  return tbpfile.ready;
+}
+
+// Big endian bit window over one compressed block; bytes past the block read as zero
+
+typedef struct
+{
+  const ui8 *ptr;  // Next byte to load
+  const ui8 *end;  // Block end
+  ui64 window;     // Unconsumed bits, most significant first
+  ui count;        // Count of unconsumed bits in the window
+} TBPBits;
+
+static void FillBits(TBPBits& bits)
+{
+  while (bits.count <= 56)
+  {
+    const ui64 byte = (bits.ptr < bits.end) ? *bits.ptr++ : 0;
+
+    bits.window |= byte << (56 - bits.count); bits.count += 8;
+  };
+}
+
+static ui DecodeSymbol(const TBPStream& stream, TBPBits& bits)
+{
+  // Decode one canonical code: a code of some length is complete once its value is at
+  // least the smallest code of that length
+
+  ui index = 0;
+  ui64 code = bits.window >> (64 - stream.minbits);
+
+  while (code < stream.firstcodes[index])
+  {
+    index++; code = bits.window >> (64 - stream.minbits - index);
+  };
+
+  const ui length = stream.minbits + index;
+
+  bits.window <<= length; bits.count -= length; FillBits(bits);
+  return (ui) (stream.firstsyms[index] + (code - stream.firstcodes[index]));
+}
+
+static ui FetchValue(const TBPFile& tbpfile, const TBPStream& stream, const ui64 index)
+{
+  // Fetch the stored value at an index
+
+  ui value;
+
+  if (stream.flags & tbpfmConstant) value = stream.constvalue;
+  else
+  {
+    const ui8 *image = tbpfile.image;
+
+    // A sparse index entry gives the block and offset of the middle position of its span
+
+    const ui8 *entryptr = image + stream.sparseat + ((index >> stream.spanshift) * 6);
+    const ui64 span = ((ui64) 1) << stream.spanshift;
+    ui32 block = ReadLE32(entryptr);
+    si64 offset = (si64) ReadLE16(entryptr + 4) + (si64) (index & (span - 1)) - (si64) (span / 2);
+
+    // Step to the block holding the position
+
+    while (offset < 0)
+    {
+      block--; offset += ReadLE16(image + stream.blocklensat + (block * 2)) + 1;
+    };
+    while (offset > (si64) ReadLE16(image + stream.blocklensat + (block * 2)))
+    {
+      offset -= ReadLE16(image + stream.blocklensat + (block * 2)) + 1; block++;
+    };
+
+    // Skip whole symbols until one covers the offset
+
+    TBPBits bits;
+
+    bits.ptr = image + stream.blocksat + (((ui64) block) << stream.blockshift);
+    bits.end = bits.ptr + (((ui64) 1) << stream.blockshift);
+    bits.window = 0; bits.count = 0; FillBits(bits);
+
+    ui sym = DecodeSymbol(stream, bits);
+
+    while (offset >= (si64) stream.spreads[sym])
+    {
+      offset -= stream.spreads[sym]; sym = DecodeSymbol(stream, bits);
+    };
+
+    // Descend the pairs to the leaf holding the offset
+
+    ui left, right;
+
+    ReadPair(image + stream.pairsat, sym, left, right);
+    while (right != tbpLeafSym)
+    {
+      if (offset < (si64) stream.spreads[left]) sym = left;
+      else
+      {
+        offset -= stream.spreads[left]; sym = right;
+      };
+      ReadPair(image + stream.pairsat, sym, left, right);
+    };
+    value = left;
+  };
+  return value;
+}
+
+static si CalcDTZPlies(const TBPFile& tbpfile, const TBPStream& stream, ui value, const si wdl)
+{
+  // Convert a stored DTZ value to plies; the map classes are win, loss, cursed win, and
+  // blessed loss
+
+  const bool iswin = (wdl == tbpwdlWin), islose = (wdl == tbpwdlLoss);
+
+  if (stream.flags & tbpfmDTZMapped)
+  {
+    const ui mapindex = iswin ? 0 : (islose ? 1 : ((wdl == tbpwdlCursedWin) ? 2 : 3));
+    const ui8 *mapptr = tbpfile.image + stream.mapsat[mapindex];
+
+    value = (stream.flags & tbpfmDTZWideMap) ? ReadLE16(mapptr + (value * 2)) : mapptr[value];
+  };
+
+  const bool inmoves =
+    (iswin && !(stream.flags & tbpfmDTZWinPlies)) ||
+    (islose && !(stream.flags & tbpfmDTZLosePlies)) || (!iswin && !islose);
+
+  return (si) (inmoves ? (value * 2) : value) + 1;
+}
+
+static ui64 CalcLeadIndex(const TBPTable& table, const si sqrs[])
+{
+  // Code the lead group of a pawnless table; the squares are in canonical orientation
+
+  ui64 index;
+
+  if (!table.hassingles) index = tbpkingpair[tbptriangle[sqrs[0]]][sqrs[1]];
+  else
+  {
+    // Three single men; the case is set by the first man off the diagonal, and a man
+    // skips the squares of the men before it
+
+    const si sqr0 = sqrs[0], sqr1 = sqrs[1], sqr2 = sqrs[2];
+    const si skip1 = (sqr1 > sqr0) ? 1 : 0;
+    const si skip2 = ((sqr2 > sqr0) ? 1 : 0) + ((sqr2 > sqr1) ? 1 : 0);
+    const ui64 sqr0rank = MapSqrToRank(sqr0), sqr1rank = MapSqrToRank(sqr1) - skip1;
+    ui tcase;
+
+    if (Diagonality(sqr0))
+    {
+      tcase = 0; index = ((((ui64) tbptriangle[sqr0] * 63) + (sqr1 - skip1)) * 62) + (sqr2 - skip2);
+    }
+    else
+    {
+      if (Diagonality(sqr1))
+      {
+        tcase = 1; index = (((sqr0rank * 28) + tbpbelow[sqr1]) * 62) + (sqr2 - skip2);
+      }
+      else
+      {
+        if (Diagonality(sqr2))
+        {
+          tcase = 2; index = (((sqr0rank * 7) + sqr1rank) * 28) + tbpbelow[sqr2];
+        }
+        else
+        {
+          tcase = 3; index = (((sqr0rank * 7) + sqr1rank) * 6) + (MapSqrToRank(sqr2) - skip2);
+        };
+      };
+    };
+    index += tbptriplebase[tcase];
+  };
+  return index;
+}
+
+static void SortSqrs(si sqrs[], const ui count, const bool bypawnorder)
+{
+  // Insertion sort, ascending by square or by pawn order
+
+  for (ui index = 1; index < count; index++)
+  {
+    const si sqr = sqrs[index];
+    const ui sqrkey = bypawnorder ? tbppawnorder[sqr] : (ui) sqr;
+    ui slot = index;
+
+    while (
+        (slot > 0) && ((bypawnorder ? tbppawnorder[sqrs[slot - 1]] : (ui) sqrs[slot - 1]) > sqrkey))
+    {
+      sqrs[slot] = sqrs[slot - 1]; slot--;
+    };
+    sqrs[slot] = sqr;
+  };
+}
+
+static si ProbeTable(TBPData& tbpdata, const Pos& pos, const ui kind, const si wdl, tbpsType& tbps)
+{
+  // Probe a single table; no captures are resolved here
+
+  ui counts[colorRLen][pieceRLen];
+  si value = 0;
+
+  for (ui color = 0; color < colorRLen; color++)
+    for (ui piece = 0; piece < pieceRLen; piece++)
+      counts[color][piece] = pos.GetManCountByColorPiece((colorType) color, (pieceType) piece);
+
+  const ui64 key = CalcKey(counts);
+
+  if ((pos.GetManCountByColor(colorWhite) + pos.GetManCountByColor(colorBlack)) == 2)
+    value = (kind == tbpkWDL) ? tbpwdlDraw : 0;
+  else
+  {
+    const std::map<ui64, TBPTable *>::const_iterator iter = tbpdata.tablemap.find(key);
+
+    if ((iter == tbpdata.tablemap.end()) || !MapFile(tbpdata.dirname, *iter->second, kind))
+      tbps = tbpsFail;
+    else
+    {
+      TBPTable& table = *iter->second;
+      const TBPFile& tbpfile = table.files[kind];
+      const bool isblack = IsColorBlack(pos.GetGood());
+
+      // The table's first side plays White; with the colors exchanged, the men change
+      // colors and the board turns over.  A symmetric table has White to move only.
+
+      const bool exchange =
+        (key != table.whitekey) || ((table.whitekey == table.blackkey) && isblack);
+      const ui8 codeflip = exchange ? 8 : 0;
+      const si sqrflip = exchange ? 0x38 : 0;
+      const ui side = (exchange != isblack) ? 1 : 0;
+      si sqrs[tbpMenLen];
+      ui8 codes[tbpMenLen];
+      ui mencount = 0, leadcount = 0, file = 0;
+
+      // List the men in table colors and orientation
+
+      for (si sqr = 0; sqr < sqrLen; sqr++)
+      {
+        const manType man = pos.GetMan((sqrType) sqr);
+
+        if (IsManNotVacant(man))
+        {
+          codes[mencount] = CalcManCode(man) ^ codeflip; sqrs[mencount++] = sqr ^ sqrflip;
+        };
+      };
+
+      // Pawn tables: the pawns of the first encoded man's color lead; the leader is the one
+      // latest in pawn order and its file (folded to a-d) selects the stream
+
+      if (table.haspawns)
+      {
+        const ui8 leadcode = tbpfile.streams[0][0].codes[0];
+
+        for (ui index = 0; index < mencount; index++)
+          if (codes[index] == leadcode)
+          {
+            const si sqr = sqrs[index];
+            const ui8 code = codes[index];
+
+            sqrs[index] = sqrs[leadcount]; codes[index] = codes[leadcount];
+            sqrs[leadcount] = sqr; codes[leadcount++] = code;
+          };
+        for (ui index = 1; index < leadcount; index++)
+          if (tbppawnorder[sqrs[index]] > tbppawnorder[sqrs[0]])
+          {
+            const si sqr = sqrs[0];
+
+            sqrs[0] = sqrs[index]; sqrs[index] = sqr;
+          };
+        file = MapSqrToFile(sqrs[0]);
+        if (file > fileD) file = fileH - file;
+      };
+
+      const TBPStream& stream = tbpfile.streams[(kind == tbpkWDL) ? side : 0][file];
+
+      if (
+          (kind == tbpkDTZ) && (((stream.flags & tbpfmDTZBlack) ? 1 : 0) != side) &&
+          !((table.whitekey == table.blackkey) && !table.haspawns))
+        tbps = tbpsOtherSide;
+      else
+      {
+        // Put the other men in encoding order: each slot takes the next unused man with its code
+
+        for (ui slot = leadcount; slot < mencount; slot++)
+        {
+          ui index = slot;
+
+          while (codes[index] != stream.codes[slot]) index++;
+
+          const si sqr = sqrs[index];
+          const ui8 code = codes[index];
+
+          sqrs[index] = sqrs[slot]; codes[index] = codes[slot];
+          sqrs[slot] = sqr; codes[slot] = code;
+        };
+
+        // Canonical orientation: the leader on files a-d; pawnless tables also put it on ranks
+        // 1-4 and put the first lead group man off the diagonal below it
+
+        ui tbpt = (MapSqrToFile(sqrs[0]) > fileD) ? tbptMirror : 0;
+
+        if (!table.haspawns)
+        {
+          if (MapSqrToRank(Transform(sqrs[0], tbpt)) > rank4) tbpt |= tbptFlip;
+
+          ui index = 0;
+
+          while ((index < stream.grouplens[0]) && !Diagonality(Transform(sqrs[index], tbpt)))
+            index++;
+          if ((index < stream.grouplens[0]) && (Diagonality(Transform(sqrs[index], tbpt)) > 0))
+            tbpt |= tbptTranspose;
+        };
+        for (ui index = 0; index < mencount; index++) sqrs[index] = Transform(sqrs[index], tbpt);
+
+        // Code the lead group
+
+        ui64 index;
+
+        if (table.haspawns)
+        {
+          SortSqrs(sqrs + 1, leadcount - 1, true);
+          index = tbpleadbase[leadcount][sqrs[0]];
+          for (ui slot = 1; slot < leadcount; slot++)
+            index += tbpchoose[slot][tbppawnorder[sqrs[slot]]];
+        }
+        else
+          index = CalcLeadIndex(table, sqrs);
+        index *= stream.groupfactors[0];
+
+        // Code each later group as a combination of the squares not used by earlier groups;
+        // a second pawn group also can't use the first rank
+
+        ui first = stream.grouplens[0];
+
+        for (ui group = 1; group < stream.groupcount; group++)
+        {
+          const ui len = stream.grouplens[group];
+          const si skip = ((group == 1) && table.haspawns && table.otherpawncount) ? 8 : 0;
+          ui64 combination = 0;
+
+          SortSqrs(sqrs + first, len, false);
+          for (ui slot = 0; slot < len; slot++)
+          {
+            const si sqr = sqrs[first + slot];
+            si below = 0;
+
+            for (ui prior = 0; prior < first; prior++) if (sqrs[prior] < sqr) below++;
+            combination += tbpchoose[slot + 1][sqr - below - skip];
+          };
+          index += combination * stream.groupfactors[group];
+          first += len;
+        };
+
+        const ui stored = FetchValue(tbpfile, stream, index);
+
+        value = (kind == tbpkWDL) ? ((si) stored - 2) : CalcDTZPlies(tbpfile, stream, stored, wdl);
+      };
+    };
+  };
+  return value;
+}
+
+static si ResolveWDL(TBPData& tbpdata, Pos& pos, const bool pawnmoves, tbpsType& tbps)
+{
+  // The tables hold no reliable value where a capture (or, as requested, a pawn move) is
+  // best, so these moves are searched first; the table value applies otherwise
+
+  MLStore mlstore;
+  ML ml(mlstore, pos);
+  si bestwdl = tbpwdlLoss, wdl = tbpwdlDraw;
+  miType tried = 0, index = 0;
+  bool stop = false;
+
+  pos.Gen(ml);
+  while (!stop && (index < ml.GetCount()))
+  {
+    const Move move = ml.FetchMove(index++);
+
+    if (move.IsCapture() || (pawnmoves && IsManPawn(move.GetFrMan())))
+    {
+      FEnv fenv;
+      tidType capttid;
+      PEnv penv;
+
+      tried++;
+      pos.Execute(move, fenv, capttid, penv);
+
+      const si movewdl = -ResolveWDL(tbpdata, pos, false, tbps);
+
+      pos.Retract(move, fenv, capttid, penv);
+      if (tbps == tbpsFail) stop = true;
+      else
+      {
+        if (movewdl > bestwdl) bestwdl = movewdl;
+        if (bestwdl == tbpwdlWin) {tbps = tbpsZeroingBest; stop = true;};
+      };
+    };
+  };
+
+  if (stop) wdl = (tbps == tbpsFail) ? tbpwdlDraw : bestwdl;
+  else
+  {
+    // With every move tried there is nothing to look up; an en passant position's stored
+    // value might be wrong anyway
+
+    const bool alltried = tried && (tried == ml.GetCount());
+
+    tbps = tbpsOkay;
+    wdl = alltried ? bestwdl : ProbeTable(tbpdata, pos, tbpkWDL, tbpwdlDraw, tbps);
+    if (tbps == tbpsFail) wdl = tbpwdlDraw;
+    else
+    {
+      if (tried && (bestwdl >= wdl))
+      {
+        tbps = ((bestwdl > tbpwdlDraw) || alltried) ? tbpsZeroingBest : tbpsOkay; wdl = bestwdl;
+      };
+    };
+  };
+  return wdl;
+}
+
+static si CalcZeroingDTZ(const si wdl)
+{
+  // The distance of a position whose best move zeroes, by its result
+
+  si dtz = 0;
+
+  switch (wdl)
+  {
+    case tbpwdlLoss:        dtz = -1;   break;
+    case tbpwdlBlessedLoss: dtz = -101; break;
+    case tbpwdlCursedWin:   dtz = 101;  break;
+    case tbpwdlWin:         dtz = 1;    break;
+    default:                            break;
+  };
+  return dtz;
+}
+
+static si ResolveDTZ(TBPData& tbpdata, Pos& pos, tbpsType& tbps)
+{
+  // Distance (in plies, signed by the result) to a zeroing move; a table holding only the
+  // other side to move is read one ply ahead
+
+  si dtz = 0;
+
+  tbps = tbpsOkay;
+
+  const si wdl = ResolveWDL(tbpdata, pos, true, tbps);
+
+  if ((tbps != tbpsFail) && (wdl != tbpwdlDraw))
+  {
+    if (tbps == tbpsZeroingBest) dtz = CalcZeroingDTZ(wdl);
+    else
+    {
+      const si plies = ProbeTable(tbpdata, pos, tbpkDTZ, wdl, tbps);
+      const si sign = (wdl > 0) ? 1 : -1;
+
+      if (tbps == tbpsOkay)
+        dtz = (plies + (((wdl == tbpwdlCursedWin) || (wdl == tbpwdlBlessedLoss)) ? 100 : 0)) * sign;
+      else
+      {
+        if (tbps == tbpsOtherSide)
+        {
+          // Keep the shortest distance among the moves that keep the result's sign
+
+          MLStore mlstore;
+          ML ml(mlstore, pos);
+          si best = 0;
+          miType index = 0;
+
+          tbps = tbpsOkay; pos.Gen(ml);
+          while ((tbps != tbpsFail) && (index < ml.GetCount()))
+          {
+            const Move move = ml.FetchMove(index++);
+            const bool zeroing = move.IsCapture() || IsManPawn(move.GetFrMan());
+            FEnv fenv;
+            tidType capttid;
+            PEnv penv;
+            si movedtz;
+
+            pos.Execute(move, fenv, capttid, penv);
+            if (zeroing) movedtz = -CalcZeroingDTZ(ResolveWDL(tbpdata, pos, false, tbps));
+            else movedtz = -ResolveDTZ(tbpdata, pos, tbps);
+
+            // A mating move has a distance of one
+
+            if ((movedtz == 1) && pos.IsCheckmate()) best = 1;
+            if (!zeroing) movedtz += (movedtz > 0) ? 1 : ((movedtz < 0) ? -1 : 0);
+            pos.Retract(move, fenv, capttid, penv);
+
+            if ((movedtz * sign > 0) && (!best || (movedtz < best))) best = movedtz;
+          };
+          dtz = (tbps == tbpsFail) ? 0 : (best ? best : -1);
+        };
+      };
+    };
+  };
+  return dtz;
+}
+
+TBP::TBP(void)
+{
+  dataptr = 0; maxmen = 0;
+  if (!tbpbuilt) {BuildEncoding(); tbpbuilt = true;};
+}
+
+TBP::~TBP(void)
+{
+  Release();
+}
+
+void TBP::Release(void)
+{
+  // Unmap all files and release all tables
+
+  if (dataptr)
+  {
+    for (ui index = 0; index < dataptr->tables.size(); index++)
+    {
+      TBPTable *tableptr = dataptr->tables[index];
+
+      for (ui kind = 0; kind < tbpkLen; kind++)
+        if (tableptr->files[kind].image)
+          munmap((void *) tableptr->files[kind].image, tableptr->files[kind].imagelen);
+      delete tableptr;
+    };
+    delete dataptr; dataptr = 0;
+  };
+  maxmen = 0;
+}
+
+static bool ParseTableName(const std::string& name, ui counts[colorRLen][pieceRLen])
+{
+  // Read the men counts of a table name such as KRPvKR; return false if it isn't one
+
+  static const char piecechars[] = "PNBRQK";
+  bool okay = (name.size() >= 3) && (name[0] == 'K');
+  ui color = colorWhite, kings = 0;
+
+  for (ui color0 = 0; color0 < colorRLen; color0++)
+    for (ui piece = 0; piece < pieceRLen; piece++) counts[color0][piece] = 0;
+  for (ui index = 0; okay && (index < name.size()); index++)
+  {
+    const char ch = name[index];
+    const char *chptr = strchr(piecechars, ch);
+
+    if ((ch == 'v') && (color == colorWhite)) color = colorBlack;
+    else
+    {
+      if (!ch || !chptr) okay = false;
+      else
+      {
+        counts[color][chptr - piecechars]++;
+        if (ch == 'K') kings++;
+      };
+    };
+  };
+  return
+    okay && (color == colorBlack) && (kings == 2) &&
+    (counts[colorWhite][pieceKing] == 1) && (counts[colorBlack][pieceKing] == 1);
+}
+
+bool TBP::LoadFromDir(const char *dirname)
+{
+  // Register every WDL table file found in a directory; return true if any were found
+
+  DIR *dirptr;
+
+  Release(); dataptr = new TBPData; dataptr->dirname = dirname;
+  dirptr = opendir(dirname);
+  if (dirptr)
+  {
+    const std::string suffix = tbpsuffixes[tbpkWDL];
+    const struct dirent *entptr;
+
+    while ((entptr = readdir(dirptr)) != 0)
+    {
+      const std::string fn = entptr->d_name;
+      ui counts[colorRLen][pieceRLen], swapped[colorRLen][pieceRLen];
+
+      if (
+          (fn.size() > suffix.size()) &&
+          (fn.compare(fn.size() - suffix.size(), suffix.size(), suffix) == 0) &&
+          ParseTableName(fn.substr(0, fn.size() - suffix.size()), counts))
+      {
+        ui mencount = 0;
+
+        for (ui color = 0; color < colorRLen; color++)
+          for (ui piece = 0; piece < pieceRLen; piece++)
+          {
+            swapped[color][piece] = counts[OtherColor(color)][piece];
+            mencount += counts[color][piece];
+          };
+
+        if (mencount <= tbpMenLen)
+        {
+          TBPTable *tableptr = new TBPTable;
+
+          tableptr->name = fn.substr(0, fn.size() - suffix.size());
+          tableptr->whitekey = CalcKey(counts); tableptr->blackkey = CalcKey(swapped);
+          tableptr->mencount = mencount;
+          tableptr->haspawns = counts[colorWhite][piecePawn] || counts[colorBlack][piecePawn];
+          tableptr->hassingles = false;
+          for (ui color = 0; color < colorRLen; color++)
+            for (ui piece = piecePawn; piece < pieceKing; piece++)
+              if (counts[color][piece] == 1) tableptr->hassingles = true;
+
+          // The pawns of the color with fewer (but some) pawns lead; White's on a tie
+
+          const ui whitepawns = counts[colorWhite][piecePawn];
+          const ui blackpawns = counts[colorBlack][piecePawn];
+          const bool whitelead = whitepawns && (!blackpawns || (whitepawns <= blackpawns));
+
+          tableptr->leadpawncount = whitelead ? whitepawns : blackpawns;
+          tableptr->otherpawncount = whitelead ? blackpawns : whitepawns;
+          for (ui kind = 0; kind < tbpkLen; kind++)
+          {
+            tableptr->files[kind].tried = tableptr->files[kind].ready = false;
+            tableptr->files[kind].image = 0; tableptr->files[kind].imagelen = 0;
+          };
+
+          dataptr->tables.push_back(tableptr);
+          dataptr->tablemap[tableptr->whitekey] = tableptr;
+          dataptr->tablemap[tableptr->blackkey] = tableptr;
+          if (mencount > maxmen) maxmen = mencount;
+        };
+      };
+    };
+    closedir(dirptr);
+  };
+  return !dataptr->tables.empty();
+}
+
+bool TBP::ProbeWDL(Pos& pos, si& wdl)
+{
+  // Probe the WDL result for the side to move; return success
+
+  bool okay = false;
+
+  if (dataptr && !pos.GetCsab())
+  {
+    tbpsType tbps = tbpsOkay;
+
+    wdl = ResolveWDL(*dataptr, pos, false, tbps);
+    okay = tbps != tbpsFail;
+  };
+  return okay;
+}
+
+bool TBP::ProbeDTZ(Pos& pos, si& dtz)
+{
+  // Probe the distance (in plies) to a zeroing move for the side to move; return success
+
+  bool okay = false;
+
+  if (dataptr && !pos.GetCsab())
+  {
+    tbpsType tbps = tbpsOkay;
+
+    dtz = ResolveDTZ(*dataptr, pos, tbps);
+    okay = tbps != tbpsFail;
+  };
+  return okay;
+}
+
+bool TBP::ProbeRootMove(Pos& pos, const Move& move, si& dtz)
+{
+  // Probe the distance (in plies) to a zeroing move for the side to move after playing a
+  // root move; positive distances are wins for the root side.  Return success.
+
+  bool okay = false;
+
+  if (dataptr && !pos.GetCsab())
+  {
+    FEnv fenv;
+    tidType capttid;
+    PEnv penv;
+    tbpsType tbps = tbpsOkay;
+
+    pos.Execute(move, fenv, capttid, penv);
+    if (!pos.GetHmvc()) dtz = CalcZeroingDTZ(-ResolveWDL(*dataptr, pos, false, tbps));
+    else
+    {
+      dtz = -ResolveDTZ(*dataptr, pos, tbps);
+      dtz += (dtz > 0) ? 1 : ((dtz < 0) ? -1 : 0);
+    };
+
+    // A mating move has a distance of one
+
+    if ((dtz == 2) && pos.IsCheckmate()) dtz = 1;
+    okay = tbps != tbpsFail;
+    pos.Retract(move, fenv, capttid, penv);
+  };
+  return okay;
+}
+
+#endif
@@ -0,0 +1,67 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_TBP
+#define Included_TBP
+
+#if (IsDevHost)
+
+// Tablebase maximum men count supported
+
+#define tbpMenLen 7
+
+// Tablebase WDL (win/draw/loss) results from the side to move's point of view
+
+#define tbpwdlLoss        (-2) // Loss
+#define tbpwdlBlessedLoss (-1) // Loss, but a draw by the fifty move rule
+#define tbpwdlDraw          0  // Draw
+#define tbpwdlCursedWin     1  // Win, but a draw by the fifty move rule
+#define tbpwdlWin           2  // Win
+
+// Forward class declaration(s)
+
+class Move;
+class Pos;
+
+struct TBPData;
+
+// Tablebase probe class
+//
+// The TBP class reads Syzygy format WDL (.rtbw) and DTZ (.rtbz) endgame tablebase
+// files from a local directory.  Each file is memory mapped on its first probe.  The
+// decoding follows the published format: a piece placement index is formed from the
+// canonical (mirrored/flipped) position and then looked up in a block compressed
+// symbol stream.  Captures are resolved by a small search as the tables don't store
+// values for positions where a capture is best.  Castling positions are never probed.
+
+class TBP
+{
+  public:
+    TBP(void);
+    ~TBP(void);
+
+    bool LoadFromDir(const char *dirname);
+
+    ui GetMaxMen(void) const {return maxmen;}
+
+    bool ProbeWDL(Pos& pos, si& wdl);
+    bool ProbeDTZ(Pos& pos, si& dtz);
+
+    bool ProbeRootMove(Pos& pos, const Move& move, si& dtz);
+
+  private:
+    void Release(void);
+
+    TBPData *dataptr;
+    ui maxmen;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,271 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "PPos.h"
+#include "Score.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "SAN.h"
+#include "UnDo.h"
+#include "UnDoStack.h"
+#include "ML.h"
+#include "MoveStack.h"
+#include "Hash.h"
+#include "History.h"
+#include "TBV.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
+#include "Pos.h"
+#include "PVTable.h"
+#include "PIR.h"
+#include "Search.h"
+#include "State.h"
+#include "BPL.h"
+#include "WPL.h"
+#include "TSR.h"
+
+// Per position result
+
+typedef struct
+{
+  std::string id;      // Position name (the id operation, else the record number)
+  std::string bestsan; // Final move of the search
+  bool valid;          // The record has a solution with legal moves
+  bool solved;         // The final move is a solution
+  msType usedmsec;     // Search time
+  ui32 usednodes;      // Search nodes
+  msType pickmsec;     // Time to solution
+  ui32 picknodes;      // Nodes to solution
+} TSRResult;
+
+// Suite work shared by the workers
+
+typedef struct
+{
+  const BPL *bplptr;
+  std::vector<TSRResult> *resultvecptr;
+  msType limitmsec;
+  plyType limitply;
+  ui32 limitnodes;
+} TSRWork;
+
+static void StripSuffix(std::string& str)
+{
+  // Remove any check, checkmate, and annotation suffix from a SAN move string
+
+  while (!str.empty() && ((str.back() == '+') || (str.back() == '#') ||
+    (str.back() == '!') || (str.back() == '?')))
+    str.pop_back();
+}
+
+static bool MatchOperand(Pos& pos, const std::string& operand, Move& move)
+{
+  // Match a SAN move operand apart from any suffix; only disambiguation marking is used
+
+  MLStore mlstore;
+  ML ml(mlstore, pos);
+  std::string basestr = operand;
+  miType index = 0;
+
+  StripSuffix(basestr); move.MakeVoid();
+  pos.Gen(ml); ml.MarkDisambiguation(pos);
+  while (move.IsVoid() && (index < ml.GetCount()))
+  {
+    const SAN san(ml.FetchMove(index));
+
+    if (basestr == san.FetchStr()) move = ml.FetchMove(index); else index++;
+  };
+  return move.IsNotVoid();
+}
+
+static bool ParseOperations(
+  Pos& pos, const char *rest, std::string& id,
+  std::vector<Move>& bmvec, std::vector<Move>& amvec)
+{
+  // Parse the EPD operations (semicolon terminated) for the solution moves and the name;
+  // return false if there is no solution or a solution move isn't legal
+
+  std::istringstream iss(rest);
+  std::string operation;
+  bool valid = true;
+
+  while (std::getline(iss, operation, ';'))
+  {
+    std::istringstream opiss(operation);
+    std::string opcode, operand;
+
+    opiss >> opcode;
+    if ((opcode == "bm") || (opcode == "am"))
+    {
+      while (valid && (opiss >> operand))
+      {
+        Move move;
+
+        if (!MatchOperand(pos, operand, move)) valid = false;
+        else
+          ((opcode == "bm") ? bmvec : amvec).push_back(move);
+      };
+    };
+    if (opcode == "id")
+    {
+      const std::string::size_type first = operation.find('"');
+      const std::string::size_type last = operation.rfind('"');
+
+      if ((first != std::string::npos) && (last > first))
+        id = operation.substr(first + 1, last - first - 1);
+    };
+  };
+  return valid && (!bmvec.empty() || !amvec.empty());
+}
+
+static bool IsMoveInVec(const Move& move, const std::vector<Move>& movevec)
+{
+  bool found = false;
+
+  for (ui index = 0; !found && (index < movevec.size()); index++)
+    if (Move::SameMove(move, movevec[index])) found = true;
+  return found;
+}
+
+// Suite worker: each pool thread searches with its own State instance, without the opening
+// book and without traces
+
+class TSRWorker
+{
+  public:
+    TSRWorker(const TSRWork& value);
+    ~TSRWorker(void);
+
+    void Run(const ui32 index);
+
+  private:
+    const TSRWork& work;
+    State *stateptr;
+    Pos *posptr;
+};
+
+TSRWorker::TSRWorker(const TSRWork& value): work(value)
+{
+  stateptr = new State; posptr = new Pos;
+  stateptr->OneTimeSetup(); stateptr->SetOption(optnNL);
+  stateptr->PutLimitMsec(work.limitmsec); stateptr->PutLimitPly(work.limitply);
+  stateptr->PutLimitNodes(work.limitnodes);
+}
+
+TSRWorker::~TSRWorker(void) {delete posptr; delete stateptr;}
+
+void TSRWorker::Run(const ui32 index)
+{
+  // Search one position and record its result
+
+  TSRResult& result = (*work.resultvecptr)[index];
+  std::vector<Move> bmvec, amvec;
+  FPos fpos;
+
+  fpos.LoadFromPPos(work.bplptr->FetchPPos(index)); posptr->LoadPosFromFPos(fpos);
+  result.id = "#" + std::to_string(index + 1);
+  result.valid = ParseOperations(*posptr, work.bplptr->FetchRest(index), result.id, bmvec, amvec);
+  if (result.valid)
+  {
+    stateptr->LoadStateFromFPos(fpos); stateptr->RunABSearch();
+
+    const Move& bestmove = stateptr->PVMove(0);
+
+    result.bestsan = SAN(bestmove).FetchStr();
+    result.solved =
+      bestmove.IsNotVoid() && (bmvec.empty() || IsMoveInVec(bestmove, bmvec)) &&
+      !IsMoveInVec(bestmove, amvec);
+    result.usedmsec = stateptr->GetUsedMsec(); result.usednodes = stateptr->GetNodeCount();
+    result.pickmsec = stateptr->GetPickMsec(); result.picknodes = stateptr->GetPickNodes();
+  };
+}
+
+bool TSR::RunSuite(const State *stateptr, const char *fn, const ui32 limitnodes)
+{
+  // Run a test suite; a node limit replaces the time limit.  The depth limit applies.
+
+  const msType startmsec = ElapsedMsec();
+  BPL bpl;
+  bool okay = bpl.LoadFile(fn);
+
+  if (okay)
+  {
+    const ui32 count = bpl.GetCount();
+    std::vector<TSRResult> resultvec(count);
+    TSRWork work;
+
+    work.bplptr = &bpl; work.resultvecptr = &resultvec;
+    work.limitmsec = limitnodes ? msInfinite : stateptr->GetLimitMsec();
+    work.limitply = stateptr->GetLimitPly(); work.limitnodes = limitnodes;
+
+    const ui workercount = WPL::RunPool<TSRWorker>(count, 0, work);
+
+    // Report each position in the file order, then the totals
+
+    const msType wallmsec = ElapsedMsec() - startmsec;
+    ui32 validcount = 0, solvedcount = 0;
+    double totalnodes = 0.0;
+
+    std::cout << "Test suite results\n" << std::fixed << std::setprecision(3);
+    for (ui32 index = 0; index < count; index++)
+    {
+      const TSRResult& result = resultvec[index];
+
+      std::cout << "  " << result.id << ": ";
+      if (!result.valid) std::cout << "no usable bm/am\n";
+      else
+      {
+        validcount++; totalnodes += result.usednodes;
+        if (result.solved)
+        {
+          solvedcount++;
+          std::cout << "solved " << result.bestsan << "   Seconds: " <<
+            (result.pickmsec / 1000.0) << "   Nodes: " << result.picknodes << '\n';
+        }
+        else
+          std::cout << "failed " << result.bestsan << '\n';
+      };
+    };
+
+    std::cout << "Test suite summary\n";
+    std::cout << "  Positions: " << validcount << '\n';
+    std::cout << "  Solved: " << solvedcount << '\n';
+    std::cout << "  Records rejected: " << (bpl.GetBadCount() + (count - validcount)) << '\n';
+    std::cout << "  Threads: " << workercount << '\n';
+    WPL::PrintRate(totalnodes, wallmsec);
+  };
+  return okay;
+}
+
+#endif
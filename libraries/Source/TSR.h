@@ -0,0 +1,36 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_TSR
+#define Included_TSR
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class State;
+
+// Test suite runner class
+//
+// The TSR class runs an EPD test suite.  Each record's "bm" (best move) and "am" (avoid
+// move) operations give its solution and its "id" operation names it.  The positions are
+// handed out to a pool of worker threads, each with its own State instance, and every
+// position is searched with the same limits.  A position is solved if the final move is
+// a best move and not an avoid move; its time and nodes to solution are those at the
+// last change of the search's best move.
+
+class TSR
+{
+  public:
+    bool RunSuite(const State *stateptr, const char *fn, const ui32 limitnodes);
+};
+
+#endif
+
+#endif
@@ -35,22 +35,6 @@ void TinyMove::Print(void) const
   if (IsMscProm(msc)) PrintPiece(cvpromtopiece[cvmsctoprom[msc]]);
 }
 
-void TinyMove::ConvertFromMove(const Move& move)
-{
-  const sqrType frsqr = move.GetFrSqr(), tosqr = move.GetToSqr();
-  const mscType msc = move.GetMsc();
-
-  BuildB0(frsqr, tosqr); BuildB1(tosqr, msc);
-}
-
-void TinyMove::ConvertToMove(Move& move, const Board& board) const
-{
-  move.Reset();
-  move.PutFrSqr(GetFrSqr()); move.PutFrMan(board.GetMan(move.GetFrSqr()));
-  move.PutToSqr(GetToSqr()); move.PutToMan(board.GetMan(move.GetToSqr()));
-  move.PutMsc(GetMsc());
-}
-
 si TinyMove::CompareTinyMove(const TinyMove& tinymove0, const TinyMove& tinymove1)
 {
   // Compare two tiny moves, like strcmp()
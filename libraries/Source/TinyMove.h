@@ -15,6 +15,10 @@
 #define tmcbLen 2
 
 // Compressed move class
+//
+// A tiny move packs the from square, to square, and special case of a move into two bytes;
+// the moving and captured men are recovered from the board on conversion to a full move.
+// An all zero tiny move (a1-a1) is void.
 
 class TinyMove
 {
@@ -31,17 +35,51 @@ class TinyMove
 
     ui8 GetCodeByte(const ui8 index) const {return codebyte[index];}
 
+    bool IsVoid(void)    const {return (codebyte[0] == 0) && (codebyte[1] == 0);}
+    bool IsNotVoid(void) const {return (codebyte[0] != 0) || (codebyte[1] != 0);}
+
+    sqrType GetFrSqr(void) const
+    {
+      return (sqrType) (codebyte[0] & 0x3f);
+    }
+
+    sqrType GetToSqr(void) const
+    {
+      return (sqrType) (((codebyte[0] >> 6) & 0x03) | ((codebyte[1] & 0x0f) << 2));
+    }
+
+    mscType GetMsc(void) const
+    {
+      return (mscType) ((codebyte[1] >> 4) & 0x07);
+    }
+
     void Load(const ui8 cb0, const ui8 cb1) {codebyte[0] = cb0; codebyte[1] = cb1;}
 
     void Flip(void);
 
-    void ConvertFromMove(const Move& move);
-    void ConvertToMove(Move& move, const Board& board) const;
+    void ConvertFromMove(const Move& move) {Build(move.GetFrSqr(), move.GetToSqr(), move.GetMsc());}
+
+    void ConvertToMove(Move& move, const Board& board) const
+    {
+      const sqrType frsqr = GetFrSqr(), tosqr = GetToSqr();
+
+      move.Reset();
+      move.PutFrSqr(frsqr); move.PutFrMan(board.GetMan(frsqr));
+      move.PutToSqr(tosqr); move.PutToMan(board.GetMan(tosqr));
+      move.PutMsc(GetMsc());
+    }
 
     void Print(void) const;
 
     static si CompareTinyMove(const TinyMove& tinymove0, const TinyMove& tinymove1);
 
+    static bool SameTinyMove(const TinyMove& tinymove0, const TinyMove& tinymove1)
+    {
+      return
+        (tinymove0.codebyte[0] == tinymove1.codebyte[0]) &&
+        (tinymove0.codebyte[1] == tinymove1.codebyte[1]);
+    }
+
   private:
     void BuildB0(const sqrType frsqr, const sqrType tosqr)
     {
@@ -58,21 +96,6 @@ class TinyMove
       BuildB0(frsqr, tosqr); BuildB1(tosqr, msc);
     }
 
-    sqrType GetFrSqr(void) const
-    {
-      return (sqrType) (codebyte[0] & 0x3f);
-    }
-
-    sqrType GetToSqr(void) const
-    {
-      return (sqrType) (((codebyte[0] >> 6) & 0x03) | ((codebyte[1] & 0x0f) << 2));
-    }
-
-    mscType GetMsc(void) const
-    {
-      return (mscType) ((codebyte[1] >> 4) & 0x07);
-    }
-
     ui8 codebyte[tmcbLen];
 };
 
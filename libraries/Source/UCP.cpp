@@ -0,0 +1,419 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <cassert>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "Counter.h"
+#include "Board.h"
+#include "FEnv.h"
+#include "FPos.h"
+#include "Score.h"
+#include "Move.h"
+#include "TinyMove.h"
+#include "UnDo.h"
+#include "UnDoStack.h"
+#include "ML.h"
+#include "MoveStack.h"
+#include "Hash.h"
+#include "BookMove.h"
+#include "Book.h"
+#include "History.h"
+#include "TBV.h"
+#include "PRF.h"
+#include "MGS.h"
+#include "SSB.h"
+#include "PEnv.h"
+#include "NNAcc.h"
+#include "EPV.h"
+#include "Pos.h"
+#include "PVTable.h"
+#include "PIR.h"
+#include "Search.h"
+#include "State.h"
+#include "TBP.h"
+#include "UCP.h"
+
+#define UCPMovesToGo    30 // Moves to go assumed for a sudden death time control
+#define UCPOverheadMsec 50 // Default move overhead (communication and start up delays)
+
+// Processor data; the mutex guards the input queue and the search status items, which are
+// shared with the input thread
+
+struct UCPData
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::string> lines;   // Queued command lines
+  bool searching;                  // A go command has been read; no best move reported yet
+  bool started;                    // The search limits are set and the search is running
+  bool pondering;                  // A ponder search without a ponder hit (yet)
+  bool infinite;                   // The best move report waits for a stop
+  bool stopped;                    // A stop (or quit) has been read
+  msType hitlimitmsec;             // Time limit applied by a ponder hit
+  std::vector<std::string> tokens; // Tokens of the command being processed (main thread)
+  msType overheadmsec;             // Move overhead (main thread)
+};
+
+static void Tokenize(const std::string& line, std::vector<std::string>& tokens)
+{
+  // Split a command line into its white space separated tokens
+
+  std::istringstream iss(line);
+  std::string token;
+
+  tokens.clear();
+  while (iss >> token) tokens.push_back(token);
+}
+
+static bool HasToken(const std::vector<std::string>& tokens, const char *str)
+{
+  bool found = false;
+
+  for (ui index = 0; !found && (index < tokens.size()); index++)
+    if (tokens[index] == str) found = true;
+  return found;
+}
+
+static bool IsInfiniteGo(const std::vector<std::string>& tokens)
+{
+  // An infinite search is requested explicitly or by the absence of any limit
+
+  return
+    HasToken(tokens, "infinite") ||
+    (!HasToken(tokens, "wtime") && !HasToken(tokens, "btime") &&
+      !HasToken(tokens, "movetime") && !HasToken(tokens, "depth") && !HasToken(tokens, "nodes"));
+}
+
+static ui32 DecodeValue(const std::string& str)
+{
+  // Decode an integer parameter; a negative value (an overdrawn clock) becomes zero
+
+  const long long int value = strtoll(str.c_str(), 0, 10);
+
+  return (value <= 0) ? 0 : ((value >= (long long int) msInfinite) ? msInfinite : (ui32) value);
+}
+
+static msType CalcMoveTime(
+  const msType remmsec, const msType incmsec, const ui movestogo, const msType overheadmsec)
+{
+  // Allot an even share of the remaining time plus most of the increment, less the move
+  // overhead; at least a quarter of the remaining time is always kept in reserve
+
+  const msType reservemsec = remmsec / 4;
+  msType msec = (remmsec / (movestogo ? movestogo : UCPMovesToGo)) + ((incmsec * 3) / 4);
+
+  msec = (msec > overheadmsec) ? (msec - overheadmsec) : 1;
+  if (msec > (remmsec - reservemsec)) msec = remmsec - reservemsec;
+  return msec ? msec : 1;
+}
+
+static void ReadInput(UCPData *dataptr, State *stateptr)
+{
+  // Input thread: read command lines until quit or the end of the input.  A search in
+  // progress is stopped or converted from pondering here; a readiness check during a
+  // search is also answered here.  All other commands are queued for the main thread.
+
+  std::vector<std::string> tokens;
+  std::string line;
+  bool quit = false;
+
+  while (!quit)
+  {
+    if (!std::getline(std::cin, line)) line = "quit";
+    Tokenize(line, tokens);
+    if (!tokens.empty())
+    {
+      const std::string& verb = tokens[0];
+
+      dataptr->mutex.lock();
+      quit = (verb == "quit");
+
+      // A new search; any prior interrupt is dropped so that a quick stop is not lost
+
+      if (verb == "go")
+      {
+        stateptr->ResetInterrupt();
+        dataptr->searching = true; dataptr->started = false; dataptr->stopped = false;
+        dataptr->pondering = HasToken(tokens, "ponder"); dataptr->infinite = IsInfiniteGo(tokens);
+      };
+
+      // Search control
+
+      if (dataptr->searching && ((verb == "stop") || quit))
+      {
+        dataptr->stopped = true; stateptr->Interrupt();
+      };
+      if (dataptr->searching && dataptr->pondering && (verb == "ponderhit"))
+      {
+        dataptr->pondering = false;
+        if (dataptr->started) stateptr->RestartTimeLimit(dataptr->hitlimitmsec);
+      };
+
+      // A readiness check during a search is answered with a single whole line write, as is
+      // done by each output buffer flush, so it can't split any other output line
+
+      if (dataptr->searching && (verb == "isready")) std::cout << fsUcReadyOk << std::flush;
+      else
+      {
+        if ((verb != "stop") && (verb != "ponderhit")) dataptr->lines.push_back(line);
+      };
+      dataptr->cv.notify_all();
+      dataptr->mutex.unlock();
+    };
+  };
+}
+
+static void FetchLine(UCPData *dataptr)
+{
+  // Wait for the next queued command line and then tokenize it
+
+  std::unique_lock<std::mutex> lock(dataptr->mutex);
+
+  while (dataptr->lines.empty()) dataptr->cv.wait(lock);
+  Tokenize(dataptr->lines.front(), dataptr->tokens); dataptr->lines.pop_front();
+}
+
+static void WaitForRelease(UCPData *dataptr)
+{
+  // Wait until the best move of a completed search may be reported
+
+  std::unique_lock<std::mutex> lock(dataptr->mutex);
+
+  while (!dataptr->stopped && (dataptr->pondering || dataptr->infinite)) dataptr->cv.wait(lock);
+  dataptr->searching = false;
+}
+
+UCP::UCP(void)
+{
+  dataptr = new UCPData;
+  dataptr->searching = dataptr->started = dataptr->pondering = false;
+  dataptr->infinite = dataptr->stopped = false;
+  dataptr->hitlimitmsec = msInfinite; dataptr->overheadmsec = UCPOverheadMsec;
+}
+
+UCP::~UCP(void) {delete dataptr;}
+
+void UCP::Loop(void)
+{
+  // Run the protocol until a quit command or the end of the input; the "uci" command that
+  // selected this processor is answered first (on a new line, as it follows a prompt)
+
+  std::thread reader(ReadInput, dataptr, stateptr);
+  bool quit = false;
+
+  stateptr->ResetOptions(); stateptr->SetOption(optnUI); stateptr->SetDefaultLimits();
+  stateptr->PutMultiPVCount(1);
+  PrintNL(); DoUci();
+  while (!quit)
+  {
+    FetchLine(dataptr);
+    if (!dataptr->tokens.empty())
+    {
+      if (dataptr->tokens[0] == "quit") quit = true; else Dispatch();
+    };
+  };
+  reader.join();
+}
+
+void UCP::Dispatch(void)
+{
+  // Dispatch a queued command; unknown commands are ignored as the protocol requires
+
+  const std::string& verb = dataptr->tokens[0];
+
+  if (verb == "go") DoGo();
+  if (verb == "isready") DoIsReady();
+  if (verb == "position") DoPosition();
+  if (verb == "setoption") DoSetOption();
+  if (verb == "uci") DoUci();
+  if (verb == "ucinewgame") DoNewGame();
+}
+
+void UCP::DoGo(void)
+{
+  // Run a search with the given limits and then report its best move and expected reply;
+  // the report for an infinite or ponder search is held until a stop or a ponder hit
+
+  const std::vector<std::string>& tokens = dataptr->tokens;
+  const bool iswhite = IsColorWhite(stateptr->FetchSearchFEnv().GetGood());
+  msType remmsec = 0, incmsec = 0, movetimemsec = 0, limitmsec = msInfinite;
+  ui32 movestogo = 0, depth = 0, nodes = 0;
+  bool timed = false, fixed = false;
+
+  for (ui index = 1; (index + 1) < tokens.size(); index++)
+  {
+    const std::string& name = tokens[index];
+    const ui32 value = DecodeValue(tokens[index + 1]);
+
+    if (name == (iswhite ? "wtime" : "btime")) {remmsec = value; timed = true;};
+    if (name == (iswhite ? "winc" : "binc")) incmsec = value;
+    if (name == "movestogo") movestogo = value;
+    if (name == "movetime") {movetimemsec = value; fixed = true;};
+    if (name == "depth") depth = value;
+    if (name == "nodes") nodes = value;
+  };
+
+  // Set the limits; a ponder search runs without a time limit until a ponder hit
+
+  if (fixed)
+    limitmsec =
+      (movetimemsec > dataptr->overheadmsec) ? (movetimemsec - dataptr->overheadmsec) : 1;
+  else
+    if (timed) limitmsec = CalcMoveTime(remmsec, incmsec, movestogo, dataptr->overheadmsec);
+
+  stateptr->PutLimitPly(((depth > 0) && (depth < MaxPlyLen)) ? (plyType) depth : MaxPlyLen);
+  stateptr->PutLimitNodes(nodes);
+
+  dataptr->mutex.lock();
+  stateptr->PutLimitMsec(dataptr->pondering ? msInfinite : limitmsec);
+  dataptr->hitlimitmsec = limitmsec; dataptr->started = true;
+  dataptr->mutex.unlock();
+
+  // Search and report
+
+  stateptr->RunABSearch(); WaitForRelease(dataptr);
+
+  PrintFS(fsUcBestMove); stateptr->PVMove(0).PrintUCI();
+  if (stateptr->PVMove(1).IsNotVoid()) {PrintFS(fsUcPonder); stateptr->PVMove(1).PrintUCI();};
+  PrintNL();
+}
+
+void UCP::DoIsReady(void) const
+{
+  // Readiness check; all earlier commands are done
+
+  PrintFS(fsUcReadyOk);
+}
+
+void UCP::DoNewGame(void) const
+{
+  // New game
+
+  stateptr->NewGame();
+}
+
+void UCP::DoPosition(void) const
+{
+  // Set the position: position [startpos | fen <fen>] [moves <move> ...]
+
+  const std::vector<std::string>& tokens = dataptr->tokens;
+  bool valid = tokens.size() >= 2;
+  ui index = 2;
+
+  if (valid)
+  {
+    if (tokens[1] == "startpos") stateptr->NewGame();
+    else
+    {
+      if (tokens[1] != "fen") valid = false;
+      else
+      {
+        std::string fen;
+        FPos fpos;
+
+        while ((index < tokens.size()) && (tokens[index] != "moves"))
+        {
+          if (!fen.empty()) fen += ' ';
+          fen += tokens[index++];
+        };
+        if (!fpos.LoadFromStr(fen.c_str())) valid = false; else stateptr->LoadStateFromFPos(fpos);
+      };
+    };
+  };
+
+  // Play the moves, if any
+
+  if (valid && (index < tokens.size()))
+  {
+    index++;
+    while (valid && (index < tokens.size()))
+    {
+      Move move;
+
+      stateptr->MatchUCIMove(tokens[index++].c_str(), move);
+      if (move.IsVoid()) valid = false; else stateptr->Play(move);
+    };
+  };
+
+  if (!valid) PrintFS(fsUcBadPosition);
+}
+
+void UCP::DoSetOption(void)
+{
+  // Set an option: setoption name <name> [value <value>]; the name match ignores case
+
+  const std::vector<std::string>& tokens = dataptr->tokens;
+  std::string name, value;
+  bool isvalue = false;
+
+  for (ui index = 2; index < tokens.size(); index++)
+  {
+    if (!isvalue && (tokens[index] == "value")) isvalue = true;
+    else
+    {
+      std::string& str = isvalue ? value : name;
+
+      if (!str.empty()) str += ' ';
+      str += tokens[index];
+    };
+  };
+  for (ui index = 0; index < name.length(); index++) name[index] = (char) tolower(name[index]);
+
+  if (name == "ownbook")
+  {
+    if (value == "false") stateptr->SetOption(optnNL); else stateptr->ResetOption(optnNL);
+  };
+  if (name == "move overhead") dataptr->overheadmsec = DecodeValue(value);
+  if (name == "multipv")
+  {
+    const ui32 count = DecodeValue(value);
+
+    stateptr->PutMultiPVCount((count < 1) ? 1 : ((count > MultiPVLen) ? MultiPVLen : count));
+  };
+  if (name == "syzygypath")
+  {
+    if (value.empty() || (value == "<empty>")) stateptr->ResetOption(optnTB);
+    else
+    {
+      if (stateptr->LoadTablebases(value.c_str(), tbpMenLen)) stateptr->SetOption(optnTB);
+      else
+      {
+        PrintFS(fsUcInfoString); PrintFS(fsUdCantLoadTables);
+      };
+    };
+  };
+}
+
+void UCP::DoUci(void) const
+{
+  // Identification, options, and acknowledgement
+
+  PrintFS(fsUcId); PrintFS(fsUcOptions); PrintFS(fsUcUciOk);
+}
+
+#endif
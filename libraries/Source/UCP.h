@@ -0,0 +1,55 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_UCP
+#define Included_UCP
+
+#if (IsDevHost)
+
+// Forward class declaration(s)
+
+class State;
+
+struct UCPData;
+
+// UCI Command Processor class
+//
+// The UCP class is one of several command processor classes; it speaks the Universal
+// Chess Interface protocol.  A dedicated input thread reads the command lines.  The
+// commands that act on a search in progress (stop, ponderhit, and isready) are handled
+// by the input thread at once; all other commands are queued for the main thread which
+// runs the searches.
+
+class UCP
+{
+  public:
+    UCP(void);
+    ~UCP(void);
+
+    void SetStatePtr(State *ptr) {stateptr = ptr;}
+
+    void Loop(void);
+
+  private:
+    void Dispatch(void);
+
+    void DoGo(void);
+    void DoIsReady(void) const;
+    void DoNewGame(void) const;
+    void DoPosition(void) const;
+    void DoSetOption(void);
+    void DoUci(void) const;
+
+    State *stateptr;
+    UCPData *dataptr;
+};
+
+#endif
+
+#endif
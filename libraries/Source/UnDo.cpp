@@ -18,6 +18,10 @@
 #include "Board.h"
 #include "FEnv.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 
-void UnDo::Reset(void) {fenv.Reset(); move.Reset(); capttid = tidNil;}
+void UnDo::Reset(void)
+{
+  fenv.Reset(); tinymove.Reset(); frman = toman = manVacant; flags = 0; capttid = tidNil;
+}
@@ -11,6 +11,8 @@
 #define Included_UnDo
 
 // Move undo class
+//
+// The move is held as a tiny move with its men and flags; its score isn't kept.
 
 class UnDo
 {
@@ -20,15 +22,31 @@ class UnDo
     const FEnv& FetchFEnv(void) const {return fenv;}
     FEnv& RefFEnv(void) {return fenv;}
 
-    const Move& FetchMove(void) const {return move;}
-    Move& RefMove(void) {return move;}
+    Move FetchMove(void) const
+    {
+      Move move;
+
+      move.Reset();
+      move.PutFrSqr(tinymove.GetFrSqr()); move.PutFrMan(frman);
+      move.PutToSqr(tinymove.GetToSqr()); move.PutToMan(toman);
+      move.PutMsc(tinymove.GetMsc()); move.PutFlags(flags);
+      return move;
+    }
+
+    void PutMove(const Move& move)
+    {
+      tinymove.ConvertFromMove(move);
+      frman = move.GetFrMan(); toman = move.GetToMan(); flags = move.GetFlags();
+    }
 
     tidType GetCaptTid(void) const {return capttid;}
     void PutCaptTid(const tidType tid) {capttid = tid;}
 
   private:
     FEnv fenv;
-    Move move;
+    TinyMove tinymove;
+    manType frman, toman;
+    mfmType flags;
     tidType capttid;
 };
 
@@ -18,6 +18,7 @@
 #include "Board.h"
 #include "FEnv.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
 
@@ -35,7 +36,7 @@ void UnDoStack::Push(const FEnv& fenv, const Move& move, const tidType capttid)
       undostack[index - 1] = undostack[index];
     count--;
   };
-  undostack[count].RefFEnv() = fenv; undostack[count].RefMove() = move;
+  undostack[count].RefFEnv() = fenv; undostack[count].PutMove(move);
   undostack[count].PutCaptTid(capttid);
   count++;
 }
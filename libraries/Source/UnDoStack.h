@@ -30,13 +30,13 @@ class UnDoStack
     void Push(const FEnv& fenv, const Move& move, const tidType capttid);
     void PopDel(void) {count--;}
 
-    const Move& FetchTopMove(void) const {return undostack[count - 1].FetchMove();}
+    Move FetchTopMove(void) const {return undostack[count - 1].FetchMove();}
     const FEnv& FetchTopFEnv(void) const {return undostack[count - 1].FetchFEnv();}
     tidType GetTopCaptTid(void) const {return undostack[count - 1].GetCaptTid();}
 
-    const Move& FetchNextMove(void) const {return undostack[count].FetchMove();}
+    Move FetchNextMove(void) const {return undostack[count].FetchMove();}
 
-    const Move& FetchPastMove(const ui index) const
+    Move FetchPastMove(const ui index) const
     {
       return undostack[count - 1 - index].FetchMove();
     }
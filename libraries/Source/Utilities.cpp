@@ -15,7 +15,9 @@
 #include <sys/time.h>
 #include <cassert>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <thread>
 #endif
 
 #if (IsTarget)
@@ -23,10 +25,18 @@ unsigned long int TargetElapsedMsec(void);
 bool TargetSerialAvailable(void);
 char TargetSerialInput(void);
 void TargetSerialOutput(const char ch);
+void TargetSerialWrite(const char *bptr, const ui count);
 void TargetRandomSeed(const unsigned int seed);
 long int TargetRandomPick(const unsigned int limit);
 void TargetLEDOutput(const bool flag);
 void TargetAudioAlert(void);
+
+// Default batch serial output, one character at a time; a sketch may supply a faster one
+
+__attribute__((weak)) void TargetSerialWrite(const char *bptr, const ui count)
+{
+  for (ui index = 0; index < count; index++) TargetSerialOutput(bptr[index]);
+}
 #endif
 
 // ******** Audible output
@@ -66,6 +76,8 @@ void ReadLine(char *cv, const ui limit, bool& eof)
 {
   // Note: All serial input goes through this routine
 
+  FlushOutput();
+
 #if (IsDevHost)
   std::cin.getline(cv, limit); eof = std::cin.eof();
 #endif
@@ -187,18 +199,142 @@ optnType DecodeOption(const char *str)
   return optn;
 }
 
+// ******** Output buffering
+//
+// Output is collected and then written a line at a time, or sooner if the buffer fills.
+// On the host, trace lines (each started by PrintOptn) can be routed to a file or to a
+// memory ring; file trace output is written only when its buffer fills or on a flush.
+//
+// The buffers are not locked: only the main thread may print or flush.  Host worker threads
+// (the tool pools and the protocol input readers) must not call the printing routines; the
+// UCI readiness reply from the input thread is a single direct whole line write instead.
+
+static char outcv[OutBufLen];
+static ui outcount = 0;
+
+#if (IsDevHost && !defined(NDEBUG))
+static const std::thread::id outthreadid = std::this_thread::get_id();
+
+static bool IsOutThread(void) {return std::this_thread::get_id() == outthreadid;}
+#endif
+
+#if (IsDevHost)
+static tdType tracetd = tdConsole;
+static bool tracing = false;
+static std::ofstream *traceofsptr = 0;
+static char tracecv[OutBufLen];
+static ui tracecount = 0;
+static char tracering[TraceRingLen];
+static ui64 traceringcount = 0;
+#endif
+
+static void FlushOutBuf(void)
+{
+  if (outcount)
+  {
+#if (IsDevHost)
+    std::cout.write(outcv, outcount); std::cout.flush();
+#endif
+
+#if (IsTarget)
+    TargetSerialWrite(outcv, outcount);
+#endif
+
+    outcount = 0;
+  };
+}
+
+static void PutOutChar(const char ch)
+{
+  outcv[outcount++] = ch;
+  if ((ch == '\n') || (outcount == OutBufLen)) FlushOutBuf();
+}
+
+#if (IsDevHost)
+static void FlushTraceBuf(void)
+{
+  if (tracecount) {traceofsptr->write(tracecv, tracecount); tracecount = 0;};
+  if (traceofsptr) traceofsptr->flush();
+}
+
+static void PutTraceChar(const char ch)
+{
+  if (tracetd == tdRing) tracering[traceringcount++ % TraceRingLen] = ch;
+  else
+  {
+    tracecv[tracecount++] = ch;
+    if (tracecount == OutBufLen) FlushTraceBuf();
+  };
+}
+#endif
+
+void FlushOutput(void)
+{
+  // Write all pending output
+
+#if (IsDevHost)
+  assert(IsOutThread());
+#endif
+
+  FlushOutBuf();
+
+#if (IsDevHost)
+  FlushTraceBuf();
+#endif
+}
+
+#if (IsDevHost)
+bool RouteTraceOutput(const tdType td, const char *fn)
+{
+  // Set the trace output destination; the file name is used only for file routing
+
+  bool okay = true;
+
+  FlushOutput();
+  if (traceofsptr) {delete traceofsptr; traceofsptr = 0;};
+  if (td == tdFile)
+  {
+    traceofsptr = new std::ofstream(fn, std::ios::app);
+    if (traceofsptr->fail())
+    {
+      std::cerr << "Can't open trace output file\n";
+      delete traceofsptr; traceofsptr = 0; okay = false;
+    };
+  };
+  tracetd = okay ? td : tdConsole;
+  return okay;
+}
+
+void PrintTraceRing(void)
+{
+  // Print the memory ring contents, oldest first; a wrapped ring starts at a line boundary
+
+  const ui64 frcount = (traceringcount > TraceRingLen) ? (traceringcount - TraceRingLen) : 0;
+  ui64 count = frcount;
+
+  if (frcount)
+  {
+    while ((count < traceringcount) && (tracering[count % TraceRingLen] != '\n')) count++;
+    count++;
+  };
+  while (count < traceringcount) PutOutChar(tracering[count++ % TraceRingLen]);
+}
+#endif
+
 // ******** Basic printing routines
 
 void PrintChar(const char ch)
 {
-  // Note: All serial output goes through this routine (except book building)
+  // Note: All serial output goes through this routine (except the host tools)
 
 #if (IsDevHost)
-  std::cout << ch << std::flush;
+  assert(IsOutThread());
+  if (tracing && (tracetd != tdConsole)) PutTraceChar(ch); else PutOutChar(ch);
+  if (ch == '\n') tracing = false;
 #endif
 
 #if (IsTarget)
-  TargetSerialOutput(ch);
+  PutOutChar(ch);
 #endif
 }
 
@@ -214,6 +350,10 @@ void PrintOptn(const optnType optn)
 {
   char cv[optnstrLen + 1];
 
+#if (IsDevHost)
+  tracing = true;
+#endif
+
   PrintChar('['); RetrieveOptnString(optn, cv); PrintStr(cv); PrintChar(']'); PrintSpace();
 }
 
@@ -273,6 +413,8 @@ void PrintSearchTermination(const stType st)
     case stForcedMate:   PrintFS(fsStForcedMate);   break;
     case stInterrupt:    PrintFS(fsStInterrupt);    break;
     case stLimitDepth:   PrintFS(fsStLimitDepth);   break;
+    case stLimitMoves:   PrintFS(fsStLimitMoves);   break;
+    case stLimitNodes:   PrintFS(fsStLimitNodes);   break;
     case stLimitTime:    PrintFS(fsStLimitTime);    break;
     case stMateIn1:      PrintFS(fsStMateIn1);      break;
     case stNoMoves:      PrintFS(fsStNoMoves);      break;
@@ -571,6 +713,8 @@ void SwitchFault(void) {PrintFS(fsFeSwitchFault); Die();}
 
 void Die(void)
 {
+  FlushOutput();
+
 #if (IsDevHost)
   exit(1);
 #endif
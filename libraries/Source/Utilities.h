@@ -68,6 +68,13 @@ void EncodeSi32(char **bptrptr, const si32 value);
 void RetrieveOptnString(const optnType optn, char cv[]);
 optnType DecodeOption(const char *str);
 
+void FlushOutput(void);
+
+#if (IsDevHost)
+bool RouteTraceOutput(const tdType td, const char *fn);
+void PrintTraceRing(void);
+#endif
+
 void PrintChar(const char ch);
 void PrintStr(const char *bptr);
 
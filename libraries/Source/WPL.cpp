@@ -0,0 +1,49 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#include "Definitions.h"
+#include "Constants.h"
+#include "Utilities.h"
+
+#if (IsDevHost)
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#endif
+
+#if (IsDevHost)
+
+#include "WPL.h"
+
+ui WPL::CalcThreadCount(const ui32 count, const ui limit)
+{
+  // One thread per processor unless limited, but no more than one per item and at least one
+
+  const ui processorcount = std::thread::hardware_concurrency();
+  ui threadcount = limit ? limit : (processorcount ? processorcount : 1);
+
+  if (threadcount > count) threadcount = count;
+  return threadcount ? threadcount : 1;
+}
+
+void WPL::PrintRate(const double nodes, const msType msec)
+{
+  // Print the node total, the elapsed time, and the node frequency of a tool summary
+
+  std::cout << std::fixed;
+  std::cout << "  Nodes: " << std::setprecision(0) << nodes << '\n';
+  std::cout << "  Seconds: " << std::setprecision(3) << (msec / 1000.0) << '\n';
+  std::cout << "  Frequency: " << std::setprecision(0) <<
+    (msec ? ((nodes * 1000.0) / msec) : 0.0) << " Hz\n";
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Myopic: A simple chess program for small systems
+//
+// Copyright (C) 2010 by chessnotation@me.com   (Some rights reserved)
+//
+// License: Creative Commons Attribution-Share Alike 3.0
+// See: http://creativecommons.org/licenses/by-sa/3.0/
+//
+// Caution: No warranty; use at your own risk.
+
+#ifndef Included_WPL
+#define Included_WPL
+
+#if (IsDevHost)
+
+// Worker pool class
+//
+// The WPL class has only static members.  It runs the work items (numbered from zero) of
+// an offline tool on a pool of host threads.  Each thread constructs one worker from the
+// tool's work block and hands it the items it claims from a shared atomic index until
+// there are none left; a worker class has a constructor taking the work block and a Run
+// member taking an item index, and it keeps any per thread state (a search state) itself.
+// The includers supply the atomic, thread, and vector headers.
+
+class WPL
+{
+  public:
+    static ui CalcThreadCount(const ui32 count, const ui limit);
+
+    template <typename WorkerType, typename WorkType>
+    static ui RunPool(const ui32 count, const ui limit, const WorkType& work)
+    {
+      // Run all of the items and return the thread count used
+
+      const ui threadcount = CalcThreadCount(count, limit);
+      std::atomic<ui32> nextindex(0);
+      std::vector<std::thread> threads;
+
+      for (ui index = 0; index < threadcount; index++)
+      {
+        threads.push_back(
+          std::thread(RunWorker<WorkerType, WorkType>, &work, &nextindex, count));
+      };
+      for (ui index = 0; index < threads.size(); index++) threads[index].join();
+      return threadcount;
+    }
+
+    static void PrintRate(const double nodes, const msType msec);
+
+  private:
+    template <typename WorkerType, typename WorkType>
+    static void RunWorker(
+      const WorkType *workptr, std::atomic<ui32> *nextindexptr, const ui32 count)
+    {
+      WorkerType worker(*workptr);
+      ui32 index;
+
+      while ((index = (*nextindexptr)++) < count) worker.Run(index);
+    }
+};
+
+#endif
+
+#endif
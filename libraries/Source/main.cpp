@@ -12,6 +12,7 @@
 #include "Utilities.h"
 
 #if (IsDevHost)
+#include <atomic>
 #include <cassert>
 #include <csignal>
 #include <iosfwd>
@@ -28,18 +29,24 @@
 #include "Window.h"
 #include "CNPair.h"
 #include "Move.h"
+#include "TinyMove.h"
 #include "UnDo.h"
 #include "UnDoStack.h"
-#include "TinyMove.h"
 #include "SAN.h"
 #include "ML.h"
+#include "MoveStack.h"
 #include "Hash.h"
 #include "BookMove.h"
 #include "Book.h"
 #include "History.h"
 #include "TBV.h"
+#include "PRF.h"
 #include "MGS.h"
+#include "SSB.h"
 #include "PEnv.h"
+#include "NNAcc.h"
+#include "NNE.h"
+#include "EPV.h"
 #include "Pos.h"
 #include "PVTable.h"
 #include "PIR.h"
@@ -48,6 +55,7 @@
 #include "BBMoveNode.h"
 #include "BBPosNode.h"
 #include "BB.h"
+#include "EPT.h"
 #include "CIB.h"
 #include "ICP.h"
 #include "XCP.h"